@@ -0,0 +1,179 @@
+#include "inputs.h"
+
+#include <grapphs/algorithms/astar.h>
+#include <grapphs/algorithms/bfs_traversal.h>
+#include <grapphs/algorithms/dfs_traversal.h>
+#include <grapphs/algorithms/flood.h>
+#include <grapphs/algorithms/rlo_traversal.h>
+
+#include <cstdlib>
+#include <string>
+
+namespace gpp::bench {
+
+    template<typename t_graph>
+    void traverse_breadth_first(benchmark::State& state, const t_graph& graph, std::size_t start) {
+        for (auto _ : state) {
+            std::size_t visited = 0;
+            gpp::breadth_first_traverse(
+                graph, start,
+                [&](std::size_t) {
+                    visited++;
+                },
+                [](std::size_t, std::size_t) {
+                }
+            );
+            benchmark::DoNotOptimize(visited);
+        }
+    }
+
+    template<typename t_graph>
+    void traverse_depth_first(benchmark::State& state, const t_graph& graph, std::size_t start) {
+        for (auto _ : state) {
+            std::size_t visited = 0;
+            gpp::depth_first_traverse(
+                graph, start,
+                [&](std::size_t) {
+                    visited++;
+                },
+                [](std::size_t, std::size_t) {
+                }
+            );
+            benchmark::DoNotOptimize(visited);
+        }
+    }
+
+    template<typename t_graph>
+    void traverse_flood(benchmark::State& state, const t_graph& graph, std::size_t start) {
+        for (auto _ : state) {
+            std::size_t visited = 0;
+            gpp::flood(
+                graph, std::set<std::size_t>{start},
+                [&](std::size_t) {
+                    visited++;
+                },
+                [](std::size_t, std::size_t) {
+                }
+            );
+            benchmark::DoNotOptimize(visited);
+        }
+    }
+
+    template<typename t_graph>
+    void traverse_reverse_level_order(benchmark::State& state, const t_graph& graph, std::size_t start) {
+        for (auto _ : state) {
+            std::size_t visited = 0;
+            gpp::reverse_level_order_traverse(
+                graph, start,
+                [&](std::size_t) {
+                    visited++;
+                },
+                [](std::size_t, std::size_t) {
+                }
+            );
+            benchmark::DoNotOptimize(visited);
+        }
+    }
+
+    void random_breadth_first(benchmark::State& state) {
+        auto graph = random_adjacency_list(state.range(0), state.range(1));
+        traverse_breadth_first(state, graph, 0);
+    }
+
+    void random_depth_first(benchmark::State& state) {
+        auto graph = random_adjacency_list(state.range(0), state.range(1));
+        traverse_depth_first(state, graph, 0);
+    }
+
+    void random_flood(benchmark::State& state) {
+        auto graph = random_adjacency_list(state.range(0), state.range(1));
+        traverse_flood(state, graph, 0);
+    }
+
+    void random_reverse_level_order(benchmark::State& state) {
+        auto graph = random_adjacency_list(state.range(0), state.range(1));
+        traverse_reverse_level_order(state, graph, 0);
+    }
+
+    /**
+     * Random graphs have no geometry, so the search is guided by no heuristic at all, which
+     * makes it a Dijkstra search.
+     */
+    void random_astar(benchmark::State& state) {
+        auto graph = random_adjacency_list(state.range(0), state.range(1));
+        std::size_t goal = graph.size() - 1;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(
+                gpp::astar(
+                    graph, 0, goal,
+                    [](std::size_t, std::size_t) {
+                        return 0.0F;
+                    },
+                    [](std::size_t, std::size_t, const float& weight) {
+                        return weight;
+                    }
+                )
+            );
+        }
+    }
+
+    BENCHMARK(random_breadth_first)->Apply(random_graph_arguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(random_depth_first)->Apply(random_graph_arguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(random_flood)->Apply(random_graph_arguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(random_reverse_level_order)->Apply(random_graph_arguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(random_astar)->Apply(random_graph_arguments)->Unit(benchmark::kMicrosecond);
+
+    void register_maze_benchmarks() {
+        if (!std::filesystem::exists(std::filesystem::current_path() / "mazes")) {
+            return;
+        }
+        for (const std::filesystem::path& path : gpp::maze_paths()) {
+            std::string name = path.stem().string();
+            benchmark::RegisterBenchmark(
+                ("maze_breadth_first/" + name).c_str(), [path](benchmark::State& state) {
+                    const gpp::maze& maze = load_maze(path);
+                    traverse_breadth_first(state, maze.get_graph(), maze.get_start());
+                }
+            )->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(
+                ("maze_depth_first/" + name).c_str(), [path](benchmark::State& state) {
+                    const gpp::maze& maze = load_maze(path);
+                    traverse_depth_first(state, maze.get_graph(), maze.get_start());
+                }
+            )->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(
+                ("maze_flood/" + name).c_str(), [path](benchmark::State& state) {
+                    const gpp::maze& maze = load_maze(path);
+                    traverse_flood(state, maze.get_graph(), maze.get_start());
+                }
+            )->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(
+                ("maze_reverse_level_order/" + name).c_str(), [path](benchmark::State& state) {
+                    const gpp::maze& maze = load_maze(path);
+                    traverse_reverse_level_order(state, maze.get_graph(), maze.get_start());
+                }
+            )->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(
+                ("maze_astar/" + name).c_str(), [path](benchmark::State& state) {
+                    const gpp::maze& maze = load_maze(path);
+                    const auto& graph = maze.get_graph();
+                    const gpp::Cell& goal = *graph.vertex(maze.get_end());
+                    for (auto _ : state) {
+                        benchmark::DoNotOptimize(
+                            gpp::astar(
+                                graph, maze.get_start(), maze.get_end(),
+                                [&](std::size_t from, std::size_t) {
+                                    const gpp::Cell& cell = *graph.vertex(from);
+                                    return static_cast<float>(std::abs(cell.x - goal.x) + std::abs(cell.y - goal.y));
+                                },
+                                [](std::size_t, std::size_t, const int& weight) {
+                                    return static_cast<float>(weight);
+                                }
+                            )
+                        );
+                    }
+                }
+            )->Unit(benchmark::kMicrosecond);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include "inputs.h"
+
+namespace gpp::bench {
+
+    void adjacency_list_construction(benchmark::State& state) {
+        auto numVertices = static_cast<std::size_t>(state.range(0));
+        auto density = static_cast<std::size_t>(state.range(1));
+        const std::vector<random_edge>& edges = random_edges(numVertices, density);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(random_adjacency_list(numVertices, density));
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * edges.size()));
+    }
+
+    void adjacency_matrix_construction(benchmark::State& state) {
+        auto numVertices = static_cast<std::size_t>(state.range(0));
+        auto density = static_cast<std::size_t>(state.range(1));
+        const std::vector<random_edge>& edges = random_edges(numVertices, density);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(random_adjacency_matrix(numVertices, density));
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * edges.size()));
+    }
+
+    void csr_graph_construction(benchmark::State& state) {
+        auto numVertices = static_cast<std::size_t>(state.range(0));
+        auto density = static_cast<std::size_t>(state.range(1));
+        const std::vector<random_edge>& edges = random_edges(numVertices, density);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(random_csr_graph(numVertices, density));
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * edges.size()));
+    }
+
+    template<typename t_graph>
+    void iterate_edges_from(benchmark::State& state, const t_graph& graph, std::size_t numEdges) {
+        for (auto _ : state) {
+            float sum = 0;
+            for (std::size_t i = 0; i < graph.size(); ++i) {
+                for (const auto& [to, edge] : graph.edges_from(i)) {
+                    sum += edge;
+                }
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * numEdges));
+    }
+
+    void adjacency_list_edges_from(benchmark::State& state) {
+        auto numVertices = static_cast<std::size_t>(state.range(0));
+        auto density = static_cast<std::size_t>(state.range(1));
+        auto graph = random_adjacency_list(numVertices, density);
+        iterate_edges_from(state, graph, random_edges(numVertices, density).size());
+    }
+
+    void csr_graph_edges_from(benchmark::State& state) {
+        auto numVertices = static_cast<std::size_t>(state.range(0));
+        auto density = static_cast<std::size_t>(state.range(1));
+        auto graph = random_csr_graph(numVertices, density);
+        iterate_edges_from(state, graph, random_edges(numVertices, density).size());
+    }
+
+    /**
+     * Matrices have no edges_from, so every row is scanned for edges instead, which is what
+     * iterating a matrix's edges costs.
+     */
+    void adjacency_matrix_row_scan(benchmark::State& state) {
+        auto numVertices = static_cast<std::size_t>(state.range(0));
+        auto density = static_cast<std::size_t>(state.range(1));
+        auto graph = random_adjacency_matrix(numVertices, density);
+        for (auto _ : state) {
+            float sum = 0;
+            for (std::size_t from = 0; from < numVertices; ++from) {
+                for (std::size_t to = 0; to < numVertices; ++to) {
+                    float weight = *graph.edge(from, to);
+                    if (weight != 0) {
+                        sum += weight;
+                    }
+                }
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * random_edges(numVertices, density).size()));
+    }
+
+    BENCHMARK(adjacency_list_construction)->Apply(random_graph_arguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(adjacency_matrix_construction)->Apply(random_graph_arguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(csr_graph_construction)->Apply(random_graph_arguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(adjacency_list_edges_from)->Apply(random_graph_arguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(csr_graph_edges_from)->Apply(random_graph_arguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK(adjacency_matrix_row_scan)->Apply(random_graph_arguments)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,66 @@
+#include "inputs.h"
+
+#include <grapphs/dot_reader.h>
+
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace gpp::bench {
+
+    namespace {
+        /**
+         * Writes a digraph of \p numVertices labelled vertices and three times as many weighted
+         * edges between random vertices, once per vertex count.
+         * @returns The path to the file, in the temporary directory.
+         */
+        std::filesystem::path dot_file(std::size_t numVertices) {
+            auto path = std::filesystem::temp_directory_path()
+                        / ("grapphs_bench_" + std::to_string(numVertices) + ".dot");
+            if (std::filesystem::exists(path)) {
+                return path;
+            }
+            std::mt19937 random(42);
+            std::uniform_int_distribution<std::size_t> vertex(0, numVertices - 1);
+            std::uniform_real_distribution<float> weight(0, 1);
+            std::ofstream file(path);
+            // Fixed notation, as DOT numerals have no exponent
+            file << std::fixed << "digraph G {\n";
+            for (std::size_t i = 0; i < numVertices; ++i) {
+                file << "  " << i << " [label=\"v" << i << "\"];\n";
+            }
+            for (std::size_t i = 0; i < 3 * numVertices; ++i) {
+                file << "  " << vertex(random) << " -> " << vertex(random) << " [weight=" << weight(random) << "];\n";
+            }
+            file << "}\n";
+            return path;
+        }
+    }
+
+    /**
+     * Parses a DOT file, reporting bytes read per second. Building the graph is left out, see
+     * the generator benchmarks for that.
+     */
+    template<typename t_index>
+    void read_dot(benchmark::State& state) {
+        std::filesystem::path path = dot_file(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state) {
+            gpp::dot_reader<int, float, t_index> reader;
+            reader.set_edge_parser(
+                [](const std::vector<gpp::dot_attribute>& attributes, float& edge) {
+                    for (const gpp::dot_attribute& attribute : attributes) {
+                        if (attribute.key == "weight") {
+                            gpp::parse_dot_number(attribute.value, edge);
+                        }
+                    }
+                }
+            );
+            reader.parse_file(path);
+            benchmark::DoNotOptimize(reader.builder().num_edges());
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::filesystem::file_size(path)));
+    }
+
+    BENCHMARK_TEMPLATE(read_dot, std::size_t)->ArgName("vertices")->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+    BENCHMARK_TEMPLATE(read_dot, std::uint32_t)->ArgName("vertices")->Arg(1000000)->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,63 @@
+#include "inputs.h"
+
+#include <grapphs/generators.h>
+
+namespace gpp::bench {
+
+    /**
+     * Generates a graph with \p generate and builds a csr_graph out of it, which is how large
+     * synthetic inputs are produced.
+     */
+    template<typename t_generate>
+    void generate_csr_graph(benchmark::State& state, const t_generate& generate) {
+        std::size_t numEdges = 0;
+        for (auto _ : state) {
+            gpp::graph_builder<float, std::uint32_t> builder;
+            std::size_t numVertices = generate(builder);
+            numEdges = builder.num_edges();
+            benchmark::DoNotOptimize(builder.build_csr(std::vector<int>(numVertices)));
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * numEdges));
+    }
+
+    void generate_rmat(benchmark::State& state) {
+        auto scale = static_cast<unsigned>(state.range(0));
+        generate_csr_graph(
+            state, [&](auto& builder) {
+                return gpp::generate_rmat(builder, scale, std::size_t(16) << scale);
+            }
+        );
+    }
+
+    void generate_erdos_renyi(benchmark::State& state) {
+        auto numVertices = static_cast<std::size_t>(state.range(0));
+        generate_csr_graph(
+            state, [&](auto& builder) {
+                return gpp::generate_erdos_renyi(builder, numVertices, 16.0 / static_cast<double>(numVertices));
+            }
+        );
+    }
+
+    void generate_grid(benchmark::State& state) {
+        auto side = static_cast<std::size_t>(state.range(0));
+        generate_csr_graph(
+            state, [&](auto& builder) {
+                return gpp::generate_grid(builder, gpp::grid_size{side, side}, 0.2);
+            }
+        );
+    }
+
+    void generate_geometric(benchmark::State& state) {
+        auto numVertices = static_cast<std::size_t>(state.range(0));
+        generate_csr_graph(
+            state, [&](auto& builder) {
+                return gpp::generate_geometric(builder, numVertices, 4.0).size();
+            }
+        );
+    }
+
+    BENCHMARK(generate_rmat)->ArgName("scale")->DenseRange(16, 20, 2)->Unit(benchmark::kMillisecond);
+    BENCHMARK(generate_erdos_renyi)->ArgName("vertices")->RangeMultiplier(4)->Range(1 << 16, 1 << 20)->Unit(benchmark::kMillisecond);
+    BENCHMARK(generate_grid)->ArgName("side")->RangeMultiplier(4)->Range(1 << 8, 1 << 11)->Unit(benchmark::kMillisecond);
+    BENCHMARK(generate_geometric)->ArgName("vertices")->RangeMultiplier(4)->Range(1 << 16, 1 << 22)->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,89 @@
+#include "inputs.h"
+
+#include <map>
+#include <random>
+#include <utility>
+
+namespace gpp::bench {
+
+    /**
+     * Seed of every random graph, fixed so that results are comparable across runs.
+     */
+    constexpr std::uint32_t k_random_graph_seed = 0x67726170;
+
+    const std::vector<random_edge>& random_edges(std::size_t numVertices, std::size_t densityPermille) {
+        static std::map<std::pair<std::size_t, std::size_t>, std::vector<random_edge>> cache;
+        auto [found, inserted] = cache.try_emplace({numVertices, densityPermille});
+        std::vector<random_edge>& edges = found->second;
+        if (!inserted) {
+            return edges;
+        }
+        std::mt19937 random(k_random_graph_seed);
+        std::uniform_int_distribution<std::size_t> permille(0, 999);
+        std::uniform_real_distribution<float> weight(1.0F, 10.0F);
+        for (std::size_t from = 0; from < numVertices; ++from) {
+            // A ring through every vertex keeps all of them reachable from any other.
+            std::size_t next = (from + 1) % numVertices;
+            edges.push_back(random_edge{from, next, weight(random)});
+            for (std::size_t to = 0; to < numVertices; ++to) {
+                if (from != to && to != next && permille(random) < densityPermille) {
+                    edges.push_back(random_edge{from, to, weight(random)});
+                }
+            }
+        }
+        return edges;
+    }
+
+    gpp::adjacency_list<int, float> random_adjacency_list(std::size_t numVertices, std::size_t densityPermille) {
+        gpp::adjacency_list<int, float> graph;
+        graph.reserve(numVertices);
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            graph.push(static_cast<int>(i));
+        }
+        for (const random_edge& edge : random_edges(numVertices, densityPermille)) {
+            graph.connect(edge.from, edge.to, edge.weight);
+        }
+        return graph;
+    }
+
+    gpp::adjacency_matrix<int, float> random_adjacency_matrix(std::size_t numVertices, std::size_t densityPermille) {
+        gpp::adjacency_matrix<int, float> graph(numVertices);
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            graph[i] = static_cast<int>(i);
+        }
+        for (const random_edge& edge : random_edges(numVertices, densityPermille)) {
+            graph.connect(edge.from, edge.to, edge.weight);
+        }
+        return graph;
+    }
+
+    gpp::csr_graph<int, float> random_csr_graph(std::size_t numVertices, std::size_t densityPermille) {
+        gpp::graph_builder<float> builder;
+        for (const random_edge& edge : random_edges(numVertices, densityPermille)) {
+            builder.add(edge.from, edge.to, edge.weight);
+        }
+        std::vector<int> vertices(numVertices);
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            vertices[i] = static_cast<int>(i);
+        }
+        return builder.build_csr(std::move(vertices));
+    }
+
+    void random_graph_arguments(benchmark::internal::Benchmark* benchmark) {
+        benchmark->ArgNames({"vertices", "permille"});
+        for (std::int64_t numVertices : {256, 1024, 4096}) {
+            for (std::int64_t density : {k_sparse, k_dense}) {
+                benchmark->Args({numVertices, density});
+            }
+        }
+    }
+
+    const gpp::maze& load_maze(const std::filesystem::path& path) {
+        static std::map<std::filesystem::path, gpp::maze> cache;
+        auto found = cache.find(path);
+        if (found == cache.end()) {
+            found = cache.emplace(path, gpp::maze(path)).first;
+        }
+        return found->second;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef GRAPPHS_BENCH_INPUTS_H
+#define GRAPPHS_BENCH_INPUTS_H
+
+#include <grapphs/adjacency_list.h>
+#include <grapphs/adjacency_matrix.h>
+#include <grapphs/csr_graph.h>
+#include <grapphs/tests/mazes.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace gpp::bench {
+
+    struct random_edge {
+        std::size_t from;
+        std::size_t to;
+        float weight;
+    };
+
+    /**
+     * Densities of the random graphs, in edges per thousand (from, to) pairs.
+     */
+    constexpr std::size_t k_sparse = 5;
+    constexpr std::size_t k_dense = 50;
+
+    /**
+     * @returns The edges of a random directed graph with \p numVertices vertices in which each
+     * pair of vertices is connected with a probability of \p densityPermille / 1000, on top of
+     * a ring through every vertex. The same arguments always produce the same graph, which is
+     * generated once and then cached.
+     */
+    const std::vector<random_edge>& random_edges(std::size_t numVertices, std::size_t densityPermille);
+
+    gpp::adjacency_list<int, float> random_adjacency_list(std::size_t numVertices, std::size_t densityPermille);
+
+    gpp::adjacency_matrix<int, float> random_adjacency_matrix(std::size_t numVertices, std::size_t densityPermille);
+
+    gpp::csr_graph<int, float> random_csr_graph(std::size_t numVertices, std::size_t densityPermille);
+
+    /**
+     * Vertex counts and densities every random graph benchmark runs with.
+     */
+    void random_graph_arguments(benchmark::internal::Benchmark* benchmark);
+
+    /**
+     * Loads the maze at \p path once, then returns the cached maze.
+     */
+    const gpp::maze& load_maze(const std::filesystem::path& path);
+
+    /**
+     * Registers the maze benchmarks, one per generated maze.
+     */
+    void register_maze_benchmarks();
+
+#ifdef GRAPPHS_BENCH_OSM
+
+    /**
+     * Registers the OpenStreetMap benchmarks, if an extract is found. The extract is read from
+     * the GRAPPHS_BENCH_OSM environment variable, or curitiba.xml.osm in the working directory.
+     */
+    void register_osm_benchmarks();
+
+#endif
+}
+
+#endif
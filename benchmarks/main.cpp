@@ -0,0 +1,19 @@
+#include "inputs.h"
+
+/**
+ * Runs every benchmark. Pass --benchmark_out=<file> --benchmark_out_format=json for a report
+ * that can be compared across commits, or build the grapphs-run-benchmarks target.
+ */
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    gpp::bench::register_maze_benchmarks();
+#ifdef GRAPPHS_BENCH_OSM
+    gpp::bench::register_osm_benchmarks();
+#endif
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
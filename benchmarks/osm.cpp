@@ -0,0 +1,96 @@
+#include "inputs.h"
+
+#include <grapphs/algorithms/astar.h>
+#include <grapphs/algorithms/bfs_traversal.h>
+#include <grapphs/osm/parse.h>
+
+#include <cstdlib>
+#include <memory>
+
+namespace gpp::bench {
+
+    namespace {
+        std::filesystem::path osm_path() {
+            const char* path = std::getenv("GRAPPHS_BENCH_OSM");
+            if (path != nullptr) {
+                return path;
+            }
+            return std::filesystem::current_path() / "curitiba.xml.osm";
+        }
+
+        /**
+         * Parses the extract once. osm_graph can't be copied, so it is kept behind a pointer.
+         */
+        const gpp::osm::osm_graph& load_osm() {
+            static std::unique_ptr<gpp::osm::osm_graph> graph;
+            if (graph == nullptr) {
+                graph = std::make_unique<gpp::osm::osm_graph>();
+                gpp::osm::parse(osm_path(), *graph);
+            }
+            return *graph;
+        }
+
+        /**
+         * @returns The last vertex a breadth first search from \p start reaches, which makes
+         * for a long route.
+         */
+        std::size_t farthest_from(const gpp::osm::osm_graph& graph, std::size_t start) {
+            std::size_t last = start;
+            gpp::breadth_first_traverse(
+                graph, start,
+                [&](std::size_t vertex) {
+                    last = vertex;
+                },
+                [](std::size_t, std::size_t) {
+                }
+            );
+            return last;
+        }
+    }
+
+    void osm_parse(benchmark::State& state) {
+        gpp::osm::parse_options options;
+        options.useSnapshot = false;
+        for (auto _ : state) {
+            gpp::osm::osm_graph graph;
+            gpp::osm::parse(osm_path(), graph, options);
+            benchmark::DoNotOptimize(graph.size());
+        }
+    }
+
+    void osm_breadth_first(benchmark::State& state) {
+        const gpp::osm::osm_graph& graph = load_osm();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(farthest_from(graph, 0));
+        }
+    }
+
+    void osm_astar(benchmark::State& state) {
+        const gpp::osm::osm_graph& graph = load_osm();
+        std::size_t goal = farthest_from(graph, 0);
+        const gpp::osm::coordinate& goalLocation = graph.vertex(goal)->get_location();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(
+                gpp::astar(
+                    graph, 0, goal,
+                    [&](std::size_t from, std::size_t) {
+                        const gpp::osm::coordinate& location = graph.vertex(from)->get_location();
+                        return static_cast<float>(gpp::osm::haversine_distance(location, goalLocation));
+                    },
+                    [&](std::size_t, std::size_t, const gpp::osm::way& way) {
+                        return graph.length_of(way);
+                    }
+                )
+            );
+        }
+    }
+
+    void register_osm_benchmarks() {
+        if (!std::filesystem::exists(osm_path())) {
+            return;
+        }
+        benchmark::RegisterBenchmark("osm_parse", osm_parse)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("osm_breadth_first", osm_breadth_first)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("osm_astar", osm_astar)->Unit(benchmark::kMillisecond);
+    }
+}
@@ -16,7 +16,7 @@ function(grapphs_check_should_run_conan_install OUTPUT)
         return()
     endif()
 
-    if(GRAPPHS_COMPILE_TESTS OR GRAPPHS_COMPILE_SAMPLES)
+    if(GRAPPHS_COMPILE_TESTS OR GRAPPHS_COMPILE_SAMPLES OR GRAPPHS_COMPILE_BENCHMARKS)
         set(${OUTPUT} TRUE PARENT_SCOPE)
     else()
         set(${OUTPUT} FALSE PARENT_SCOPE)
@@ -54,6 +54,8 @@ function(grapphs_run_conan_install CONANFILE)
     set(CONAN_OPTIONS)
     grapphs_check_conan_argument(GRAPPHS_COMPILE_SAMPLES samples)
     grapphs_check_conan_argument(GRAPPHS_COMPILE_SVG svg_module)
+    grapphs_check_conan_argument(GRAPPHS_COMPILE_RASTER raster_module)
+    grapphs_check_conan_argument(GRAPPHS_COMPILE_FORMATS formats_module)
     grapphs_check_conan_argument(GRAPPHS_COMPILE_GRAPHVIZ graphviz_module)
 
     if(IS_MULTI_CONFIG)
@@ -28,10 +28,14 @@ class GrapphsConan(ConanFile):
 
     options = {
         "svg_module": [False, True],
+        "raster_module": [False, True],
+        "formats_module": [False, True],
         "graphviz_module": [False, True]
     }
     default_options = {
         "svg_module": True,
+        "raster_module": True,
+        "formats_module": True,
         "graphviz_module": True
     }
 
@@ -50,9 +54,11 @@ class GrapphsConan(ConanFile):
         ver = self.version.split('+')[0]
 
         build_svg = self.options.svg_module
+        build_raster = self.options.raster_module
+        build_formats = self.options.formats_module
         build_graphviz = self.options.graphviz_module
 
-        needs_build = build_svg or build_graphviz
+        needs_build = build_svg or build_raster or build_formats or build_graphviz
 
         cmake.configure(
             variables={
@@ -60,6 +66,8 @@ class GrapphsConan(ConanFile):
                 "GRAPPHS_COMPILE_SAMPLES": "Off",
                 "GRAPPHS_COMPILE_TESTS": "Off",
                 "GRAPPHS_COMPILE_SVG": as_cmake_option(build_svg),
+                "GRAPPHS_COMPILE_RASTER": as_cmake_option(build_raster),
+                "GRAPPHS_COMPILE_FORMATS": as_cmake_option(build_formats),
                 "GRAPPHS_COMPILE_GRAPHVIZ": as_cmake_option(build_graphviz),
                 "CONAN_EXPORTED": "TRUE"
             }
@@ -77,11 +85,20 @@ class GrapphsConan(ConanFile):
         if self.options.svg_module:
             libs.append("graphviz/lib/libgrapphs-svg")
 
+        if self.options.raster_module:
+            libs.append("raster/lib/libgrapphs-raster")
+
+        if self.options.formats_module:
+            libs.append("formats/lib/libgrapphs-formats")
+
         if self.options.graphviz_module:
             libs.append("graphviz/lib/libgrapphs-graphviz")
 
         self.cpp_info.libs = libs
 
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs.append("pthread")
+
         # TODO: to remove in conan v2 once cmake_find_package* & pkg_config generators removed
         self.cpp_info.build_modules["cmake_find_package"] = "Grapphs"
         self.cpp_info.build_modules["cmake_find_package_multi"] = "Grapphs"
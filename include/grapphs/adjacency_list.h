@@ -2,19 +2,43 @@
 #ifndef GRAPPHS_ADJACENCY_LIST_H
 #define GRAPPHS_ADJACENCY_LIST_H
 
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <queue>
 #include <set>
+#include <vector>
 #include <grapphs/graph.h>
 #include <grapphs/graph_view.h>
+#include <grapphs/parallel.h>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
 
 namespace gpp {
 
+    /**
+     * Graph storing, for every vertex, a hash map of its outgoing edges.
+     *
+     * Every container of the graph (vertices, edge maps, free indices and the incoming index)
+     * allocates through \p t_allocator, rebound as needed, so a whole graph may live in a
+     * single arena, see gpp::pmr::adjacency_list. The copies handed out by edges_from() and
+     * all_vertices() are short lived and use the default allocator, so they don't pile up in
+     * monotonic arenas. Arenas aren't thread safe either, so nodes are only filled in parallel
+     * with std::allocator, see allocating_threads().
+     */
     template<
         typename t_vertex,
         typename t_edge,
-        typename t_index = default_graph_index
+        typename t_index = default_graph_index,
+        typename t_allocator = std::allocator<t_vertex>
     >
     class adjacency_list : public graph<t_vertex, t_edge, t_index> {
     public:
@@ -22,24 +46,91 @@ namespace gpp {
         using vertex_type = typename graph<t_vertex, t_edge, t_index>::vertex_type;
         using edge_type = typename graph<t_vertex, t_edge, t_index>::edge_type;
         using index_type = typename graph<t_vertex, t_edge, t_index>::index_type;
-        using graph_type = gpp::adjacency_list<t_vertex, t_edge, t_index>;
+        using allocator_type = t_allocator;
+        using graph_type = gpp::adjacency_list<t_vertex, t_edge, t_index, t_allocator>;
+
+    private:
+        template<typename t_value>
+        using rebind_allocator = typename std::allocator_traits<allocator_type>::template rebind_alloc<t_value>;
+
+        using incoming_list = std::vector<index_type, rebind_allocator<index_type>>;
 
-        adjacency_list() = default;
+    public:
+        adjacency_list() : adjacency_list(allocator_type()) {}
+
+        explicit adjacency_list(const allocator_type& allocator)
+            : _allocator(allocator),
+              _nodes(node_allocator(allocator)),
+              _freeIndices(rebind_allocator<index_type>(allocator)),
+              _freeIndicesSet(rebind_allocator<index_type>(allocator)),
+              _incoming(rebind_allocator<incoming_list>(allocator)) {
+        }
+
+        /**
+         * Copies \p other into \p allocator, rather than the allocator of \p other, so that
+         * the copy lives entirely in one place.
+         */
+        adjacency_list(const adjacency_list& other, const allocator_type& allocator = allocator_type())
+            : _allocator(allocator),
+              _nodes(node_allocator(allocator)),
+              _freeIndices(other._freeIndices, rebind_allocator<index_type>(allocator)),
+              _freeIndicesSet(other._freeIndicesSet, rebind_allocator<index_type>(allocator)),
+              _indexIncoming(other._indexIncoming),
+              _incoming(rebind_allocator<incoming_list>(allocator)) {
+            _nodes.reserve(other._nodes.size());
+            for (const adjacency_node& node : other._nodes) {
+                _nodes.emplace_back(node.data(), _allocator);
+                auto& connections = _nodes.back().connections();
+                connections.reserve(node.connections().size());
+                connections.insert(node.connections().begin(), node.connections().end());
+            }
+            _incoming.reserve(other._incoming.size());
+            for (const incoming_list& sources : other._incoming) {
+                _incoming.push_back(incoming_list(sources.begin(), sources.end(), rebind_allocator<index_type>(_allocator)));
+            }
+        }
+
+        adjacency_list(adjacency_list&&) = default;
+
+        /**
+         * Replaces the contents with a copy of \p other, kept in this graph's allocator.
+         */
+        adjacency_list& operator=(const adjacency_list& other) {
+            if (this != &other) {
+                adjacency_list copy(other, _allocator);
+                _nodes.swap(copy._nodes);
+                _freeIndices.swap(copy._freeIndices);
+                _freeIndicesSet.swap(copy._freeIndicesSet);
+                _indexIncoming = copy._indexIncoming;
+                _incoming.swap(copy._incoming);
+            }
+            return *this;
+        }
+
+        adjacency_list& operator=(adjacency_list&&) = default;
 
         class adjacency_node {
         public:
-            typedef std::unordered_map<index_type, edge_type> connection_map;
+            typedef std::unordered_map<
+                index_type,
+                edge_type,
+                std::hash<index_type>,
+                std::equal_to<index_type>,
+                rebind_allocator<std::pair<const index_type, edge_type>>
+            > connection_map;
         private:
             connection_map _map;
             vertex_type _vertex;
         public:
             adjacency_node() : _map(0), _vertex() {}
 
-            explicit adjacency_node(const vertex_type& data) : _vertex(data) {
+            explicit adjacency_node(const vertex_type& data, const allocator_type& allocator = allocator_type())
+                : _map(typename connection_map::allocator_type(allocator)), _vertex(data) {
 
             }
 
-            explicit adjacency_node(vertex_type&& data) : _vertex(std::move(data)) {
+            explicit adjacency_node(vertex_type&& data, const allocator_type& allocator = allocator_type())
+                : _map(typename connection_map::allocator_type(allocator)), _vertex(std::move(data)) {
 
             }
 
@@ -83,6 +174,10 @@ namespace gpp {
                 return _map.erase(index) > 0;
             }
 
+            void reserve(std::size_t numConnections) {
+                _map.reserve(numConnections);
+            }
+
             void clear() {
                 _map.clear();
                 _vertex = vertex_type{};
@@ -98,6 +193,9 @@ namespace gpp {
             typedef typename connection_vector::iterator iterator;
             typedef typename connection_vector::const_iterator const_iterator;
 
+            explicit edge_view(connection_vector&& elements) : _elements(std::move(elements)) {
+            }
+
             explicit edge_view(const adjacency_node& owner) {
                 auto& connections = owner.connections();
                 size_t num = connections.size();
@@ -123,20 +221,174 @@ namespace gpp {
 
         void clear() {
             _nodes.clear();
+            _incoming.clear();
         }
 
     private:
-        std::vector<adjacency_node> _nodes;
-        std::queue<index_type> _freeIndices;
-        std::set<index_type> _freeIndicesSet;
+        using node_allocator = rebind_allocator<adjacency_node>;
+
+        allocator_type _allocator;
+        std::vector<adjacency_node, node_allocator> _nodes;
+        std::queue<index_type, std::deque<index_type, rebind_allocator<index_type>>> _freeIndices;
+        std::set<index_type, std::less<index_type>, rebind_allocator<index_type>> _freeIndicesSet;
+        bool _indexIncoming = false;
+        // Sources of the edges pointing to each vertex, only kept when _indexIncoming is set.
+        std::vector<incoming_list, rebind_allocator<incoming_list>> _incoming;
+
+        void erase_incoming(index_type from, index_type to) {
+            if (to >= _incoming.size()) {
+                // Dangling edge towards a vertex that never existed or was truncated by resize()
+                return;
+            }
+            incoming_list& sources = _incoming[to];
+            auto found = std::find(sources.begin(), sources.end(), from);
+            if (found != sources.end()) {
+                *found = sources.back();
+                sources.pop_back();
+            }
+        }
+
     public:
+        /**
+         * Removes the vertex at \p index along with its outgoing edges. When the incoming
+         * index is enabled, the edges pointing to it are removed as well, in O(degree).
+         * Otherwise they are left dangling.
+         */
         void remove(const index_type& index) {
+            if (_indexIncoming) {
+                for (index_type from : _incoming[index]) {
+                    _nodes[from].disconnect(index);
+                }
+                _incoming[index].clear();
+                for (const auto& [to, edge] : _nodes[index].connections()) {
+                    if (to != index) {
+                        erase_incoming(index, to);
+                    }
+                }
+            }
             // std::memset(&nodes[index], 0, sizeof(vertex_type));
             _nodes[index].clear();
             _freeIndices.push(index);
             _freeIndicesSet.emplace(index);
         }
 
+        static constexpr index_type invalid_index() {
+            return std::numeric_limits<index_type>::max();
+        }
+
+        /**
+         * Only std::allocator is known to be safe to allocate from on several threads at once,
+         * unlike e.g. std::pmr::monotonic_buffer_resource, so algorithms filling the nodes of
+         * graphs using any other allocator do so on the calling thread.
+         * @returns How many threads may fill nodes, out of the \p numThreads requested.
+         */
+        static constexpr std::size_t allocating_threads(std::size_t numThreads) {
+            return std::is_same_v<allocator_type, std::allocator<t_vertex>> ? numThreads : 1;
+        }
+
+        /**
+         * Renumbers the live vertices densely, keeping their relative order, and rewrites the
+         * targets of every connection. Edges left dangling by remove() are dropped, and the
+         * capacity held by removed vertices is released.
+         * @returns The new index of every old index, invalid_index() for removed vertices.
+         */
+        std::vector<index_type> compact() {
+            std::vector<index_type> oldToNew(_nodes.size(), invalid_index());
+            std::vector<index_type> live;
+            live.reserve(size());
+            for (index_type i = 0; i < _nodes.size(); ++i) {
+                if (_freeIndicesSet.find(i) == _freeIndicesSet.end()) {
+                    oldToNew[i] = static_cast<index_type>(live.size());
+                    live.push_back(i);
+                }
+            }
+
+            parallel_for(
+                std::size_t(0), live.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        adjacency_node& old = _nodes[live[i]];
+                        typename adjacency_node::connection_map connections(old.connections().get_allocator());
+                        connections.reserve(old.connections().size());
+                        for (auto& [to, edge] : old.connections()) {
+                            if (oldToNew[to] != invalid_index()) {
+                                connections.emplace(oldToNew[to], std::move(edge));
+                            }
+                        }
+                        old.connections() = std::move(connections);
+                    }
+                }, allocating_threads(0)
+            );
+            std::vector<adjacency_node, node_allocator> nodes(_nodes.get_allocator());
+            nodes.reserve(live.size());
+            for (index_type index : live) {
+                nodes.push_back(std::move(_nodes[index]));
+            }
+            _nodes = std::move(nodes);
+            while (!_freeIndices.empty()) {
+                _freeIndices.pop();
+            }
+            _freeIndicesSet.clear();
+            rebuild_incoming_index();
+            return oldToNew;
+        }
+
+        /**
+         * Enables or disables maintaining, for every vertex, the list of vertices with an edge
+         * to it. This makes edges_to() and remove() O(degree) at the cost of extra memory and
+         * bookkeeping in connect() and disconnect(). Enabling it builds the index in O(V+E).
+         *
+         * Edges added directly through adjacency_node::connect bypass the index, see
+         * rebuild_incoming_index().
+         */
+        void set_incoming_index(bool enabled) {
+            _indexIncoming = enabled;
+            if (enabled) {
+                rebuild_incoming_index();
+            }
+            else {
+                _incoming.clear();
+                _incoming.shrink_to_fit();
+            }
+        }
+
+        bool has_incoming_index() const {
+            return _indexIncoming;
+        }
+
+        /**
+         * Rebuilds the incoming index from scratch, if enabled.
+         */
+        void rebuild_incoming_index() {
+            if (!_indexIncoming) {
+                return;
+            }
+            _incoming.assign(_nodes.size(), incoming_list(rebind_allocator<index_type>(_allocator)));
+            for (index_type from = 0; from < _nodes.size(); ++from) {
+                for (const auto& [to, edge] : _nodes[from].connections()) {
+                    if (to < _incoming.size()) {
+                        _incoming[to].push_back(from);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @returns The (source, edge) pairs of every edge pointing to \p index. Requires the
+         * incoming index.
+         * @throws std::logic_error if the incoming index is disabled.
+         */
+        edge_view edges_to(index_type index) const {
+            if (!_indexIncoming) {
+                throw std::logic_error("edges_to requires the incoming index, see set_incoming_index");
+            }
+            typename edge_view::connection_vector elements;
+            elements.reserve(_incoming[index].size());
+            for (index_type from : _incoming[index]) {
+                elements.emplace_back(from, *_nodes[from].edge(index));
+            }
+            return edge_view(std::move(elements));
+        }
+
         index_type push(const vertex_type& vertex) {
             index_type index;
             if (!_freeIndices.empty()) {
@@ -146,7 +398,10 @@ namespace gpp {
                 _freeIndices.pop();
             } else {
                 index = static_cast<index_type>(_nodes.size());
-                _nodes.emplace_back(vertex);
+                _nodes.emplace_back(vertex, _allocator);
+                if (_indexIncoming) {
+                    _incoming.push_back(incoming_list(rebind_allocator<index_type>(_allocator)));
+                }
             }
             return index;
         }
@@ -160,7 +415,10 @@ namespace gpp {
                 _freeIndices.pop();
             } else {
                 index = static_cast<index_type>(_nodes.size());
-                _nodes.emplace_back(std::move(vertex));
+                _nodes.emplace_back(std::move(vertex), _allocator);
+                if (_indexIncoming) {
+                    _incoming.push_back(incoming_list(rebind_allocator<index_type>(_allocator)));
+                }
             }
             return index;
         }
@@ -173,6 +431,21 @@ namespace gpp {
             return size() == 0;
         }
 
+        /**
+         * @returns One past the highest index ever assigned to a vertex, including removed ones.
+         */
+        index_type index_bound() const {
+            return static_cast<index_type>(_nodes.size());
+        }
+
+        /**
+         * @returns Whether \p index, below index_bound(), was freed by remove() and not reused
+         * since. Edges pointing to it may be left dangling, see remove().
+         */
+        bool is_removed(index_type index) const {
+            return !_freeIndicesSet.empty() && _freeIndicesSet.find(index) != _freeIndicesSet.end();
+        }
+
         std::vector<index_type> all_vertices_indices() const {
             std::vector<index_type> indices;
             for (index_type i = 0; i < _nodes.size(); ++i) {
@@ -200,8 +473,19 @@ namespace gpp {
             return node(from).edge(to);
         }
 
+        /**
+         * @throws std::out_of_range if the incoming index is enabled and \p to is not a vertex.
+         * Without it, edges towards missing vertices are stored as they are.
+         */
         void connect(index_type from, index_type to, edge_type edge) final {
-            node(from).connect(to, edge);
+            adjacency_node& source = node(from);
+            if (_indexIncoming && source.edge(to) == nullptr) {
+                if (to >= _incoming.size()) {
+                    throw std::out_of_range("adjacency_list::connect towards a missing vertex");
+                }
+                _incoming[to].push_back(from);
+            }
+            source.connect(to, edge);
         }
 
         edge_view edges_from(index_type index) {
@@ -225,20 +509,55 @@ namespace gpp {
         }
 
         void resize(index_type numVertices) {
-            _nodes.resize(numVertices);
+            // Grows through push_back rather than resize, so new nodes get this graph's allocator
+            if (numVertices < _nodes.size()) {
+                _nodes.erase(_nodes.begin() + numVertices, _nodes.end());
+            }
+            _nodes.reserve(numVertices);
+            while (_nodes.size() < numVertices) {
+                _nodes.emplace_back(vertex_type{}, _allocator);
+            }
+            if (_indexIncoming) {
+                if (numVertices < _incoming.size()) {
+                    _incoming.erase(_incoming.begin() + numVertices, _incoming.end());
+                    // Edges from the truncated vertices are gone with them
+                    for (incoming_list& sources : _incoming) {
+                        sources.erase(
+                            std::remove_if(
+                                sources.begin(), sources.end(), [&](index_type from) {
+                                    return from >= numVertices;
+                                }
+                            ), sources.end()
+                        );
+                    }
+                }
+                while (_incoming.size() < numVertices) {
+                    _incoming.push_back(incoming_list(rebind_allocator<index_type>(_allocator)));
+                }
+            }
+        }
+
+        allocator_type get_allocator() const {
+            return _allocator;
         }
 
         bool disconnect(index_type from, index_type to) final {
-            return node(from).disconnect(to);
+            if (!node(from).disconnect(to)) {
+                return false;
+            }
+            if (_indexIncoming) {
+                erase_incoming(from, to);
+            }
+            return true;
         }
 
         using vertex_view = graph_view<
-            adjacency_list<t_vertex, t_edge, t_index>,
+            adjacency_list<t_vertex, t_edge, t_index, t_allocator>,
             vertex_iterator
         >;
 
         using const_vertex_view = graph_view<
-            const adjacency_list<t_vertex, t_edge, t_index>,
+            const adjacency_list<t_vertex, t_edge, t_index, t_allocator>,
             const_vertex_iterator
         >;
 
@@ -250,6 +569,18 @@ namespace gpp {
             return const_vertex_view(*this, all_vertices_indices());
         }
     };
+
+#if __has_include(<memory_resource>)
+    namespace pmr {
+
+        /**
+         * adjacency_list allocating from a std::pmr::memory_resource, e.g. a
+         * std::pmr::monotonic_buffer_resource released in one go once the graph is gone.
+         */
+        template<typename t_vertex, typename t_edge, typename t_index = default_graph_index>
+        using adjacency_list = gpp::adjacency_list<t_vertex, t_edge, t_index, std::pmr::polymorphic_allocator<std::byte>>;
+    }
+#endif
 }
 
 #endif
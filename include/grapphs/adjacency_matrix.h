@@ -6,27 +6,51 @@
 #define GRAPPHS_ADJACENCY_MATRIX_H
 
 #include <grapphs/graph.h>
+#include <memory>
 #include <stdexcept>
+#include <vector>
+
+#if __has_include(<memory_resource>)
+#include <cstddef>
+#include <memory_resource>
+#endif
 
 namespace gpp {
-    template<typename t_vertex, typename t_edge, typename t_index = default_graph_index>
+    /**
+     * Graph storing every possible edge in a dense size * size matrix. Vertices and edges are
+     * allocated through \p t_allocator, rebound as needed.
+     */
+    template<
+        typename t_vertex,
+        typename t_edge,
+        typename t_index = default_graph_index,
+        typename t_allocator = std::allocator<t_vertex>
+    >
     class adjacency_matrix : public graph<t_vertex, t_edge, t_index> {
     public:
 
         using vertex_type = typename graph<t_vertex, t_edge, t_index>::vertex_type;
         using edge_type = typename graph<t_vertex, t_edge, t_index>::edge_type;
         using index_type = typename graph<t_vertex, t_edge, t_index>::index_type;
+        using allocator_type = t_allocator;
 
     private:
-        std::vector<vertex_type> _vertices;
-        std::vector<edge_type> _edges;
+        template<typename t_value>
+        using rebind_allocator = typename std::allocator_traits<allocator_type>::template rebind_alloc<t_value>;
+
+        std::vector<vertex_type, rebind_allocator<vertex_type>> _vertices;
+        std::vector<edge_type, rebind_allocator<edge_type>> _edges;
     public:
 
-        explicit adjacency_matrix(index_type size) : _vertices(size), _edges(size * size) {
+        explicit adjacency_matrix(index_type size, const allocator_type& allocator = allocator_type())
+            : _vertices(size, rebind_allocator<vertex_type>(allocator)),
+              _edges(size * size, rebind_allocator<edge_type>(allocator)) {
         }
 
-        explicit adjacency_matrix(graph<vertex_type, edge_type, index_type>* other)
-            : _vertices(), _edges() {
+        explicit adjacency_matrix(
+            graph<vertex_type, edge_type, index_type>* other,
+            const allocator_type& allocator = allocator_type()
+        ) : _vertices(rebind_allocator<vertex_type>(allocator)), _edges(rebind_allocator<edge_type>(allocator)) {
             auto size = static_cast<index_type>(other->size());
             _vertices.resize(size);
             _edges.resize(size * size);
@@ -87,7 +111,21 @@ namespace gpp {
             _edges[index(from, to)] = edge_type();
             return true;
         }
+
+        allocator_type get_allocator() const {
+            return allocator_type(_vertices.get_allocator());
+        }
     };
 
+#if __has_include(<memory_resource>)
+    namespace pmr {
+
+        /**
+         * adjacency_matrix allocating from a std::pmr::memory_resource.
+         */
+        template<typename t_vertex, typename t_edge, typename t_index = default_graph_index>
+        using adjacency_matrix = gpp::adjacency_matrix<t_vertex, t_edge, t_index, std::pmr::polymorphic_allocator<std::byte>>;
+    }
+#endif
 }
 #endif
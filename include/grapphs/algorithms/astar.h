@@ -2,6 +2,7 @@
 #define GRAPPHS_ASTAR_H
 
 #include <grapphs/graph.h>
+#include <grapphs/algorithms/search_statistics.h>
 #include <stdexcept>
 #include <queue>
 #include <limits>
@@ -118,6 +119,27 @@ namespace gpp {
             const t_heuristics& heuristics,
             const t_distance& distanceFunction
         ) {
+            gpp::no_search_statistics statistics;
+            return invoke(graph, from, to, heuristics, distanceFunction, statistics);
+        }
+
+        /**
+         * Searches a path while reporting what it does to \p statistics, see
+         * gpp::search_statistics.
+         */
+        template<typename t_heuristics, typename t_distance, typename t_statistics>
+#ifdef __cpp_concepts
+        requires gpp::is_heuristics_function<t_heuristics, t_graph> &&
+                 gpp::is_distance_function<t_distance, t_graph>
+#endif
+        static graph_path<typename t_graph::index_type> invoke(
+            t_graph& graph,
+            index_type from,
+            index_type to,
+            const t_heuristics& heuristics,
+            const t_distance& distanceFunction,
+            t_statistics& statistics
+        ) {
 
             std::unordered_map<index_type, float> gScore;
             std::unordered_map<index_type, float> fScore;
@@ -126,35 +148,54 @@ namespace gpp {
             gpp::less_by_f_score<index_type> predicate(&fScore);
             gpp::priority_queue<index_type> open(predicate);
 
-            gScore[from] = 0;
-            fScore[from] = heuristics(from, to);
-            open.push(from);
-
-            while (!open.empty()) {
-                index_type next = open.top();
-                open.pop();
-
-                if (next == to) {
-                    return rebuild_path(from, to, history);
-                }
-
-                for (const auto [neighborIndex, edge] : graph.edges_from(next)) {
-                    float attempt = gScore[next] + distanceFunction(next, neighborIndex, edge);
-                    iterator existing = gScore.find(neighborIndex);
+            {
+                gpp::search_phase_scope<t_statistics> phase(statistics, search_phase::SETUP);
+                gScore[from] = 0;
+                fScore[from] = heuristics(from, to);
+                open.push(from);
+                statistics.on_push(open.size());
+            }
 
-                    if (existing == gScore.end() || existing->second > attempt) {
-                        history[neighborIndex] = next;
-                        gScore[neighborIndex] = attempt;
-                        fScore[neighborIndex] = attempt + distanceFunction(neighborIndex, to, edge);
+            bool found = false;
+            {
+                gpp::search_phase_scope<t_statistics> phase(statistics, search_phase::SEARCH);
+                while (!open.empty()) {
+                    index_type next = open.top();
+                    open.pop();
 
-                        if (!open.contains(neighborIndex)) {
-                            open.push(neighborIndex);
+                    if (next == to) {
+                        found = true;
+                        break;
+                    }
+                    statistics.on_vertex_expanded();
+
+                    for (const auto [neighborIndex, edge] : graph.edges_from(next)) {
+                        statistics.on_edge_relaxed();
+                        float attempt = gScore[next] + distanceFunction(next, neighborIndex, edge);
+                        iterator existing = gScore.find(neighborIndex);
+
+                        if (existing == gScore.end() || existing->second > attempt) {
+                            history[neighborIndex] = next;
+                            gScore[neighborIndex] = attempt;
+                            fScore[neighborIndex] = attempt + distanceFunction(neighborIndex, to, edge);
+
+                            if (!open.contains(neighborIndex)) {
+                                open.push(neighborIndex);
+                                statistics.on_push(open.size());
+                            }
+                            else {
+                                statistics.on_decrease_key();
+                            }
                         }
                     }
                 }
             }
 
-            throw std::runtime_error("Unable to find path");
+            if (!found) {
+                throw std::runtime_error("Unable to find path");
+            }
+            gpp::search_phase_scope<t_statistics> phase(statistics, search_phase::PATH_RECONSTRUCTION);
+            return rebuild_path(from, to, history);
         }
 
     private:
@@ -195,5 +236,31 @@ namespace gpp {
     ) {
         return gpp::astar_algorithm<t_graph>::invoke(graph, from, to, heuristics, distanceFunction);
     }
+
+    /**
+     * astar, filling \p statistics (e.g. a gpp::search_statistics) along the way.
+     */
+    template<
+        typename t_graph,
+        typename t_heuristics,
+        typename t_distances,
+        typename t_statistics
+    >
+#ifdef __cpp_concepts
+    requires gpp::is_graph<t_graph>
+             && gpp::is_heuristics_function<t_heuristics, t_graph>
+             && gpp::is_distance_function<t_distances, t_graph>
+
+#endif
+    inline graph_path<typename t_graph::index_type> astar(
+        t_graph& graph,
+        typename t_graph::index_type from,
+        typename t_graph::index_type to,
+        t_heuristics heuristics,
+        t_distances distanceFunction,
+        t_statistics& statistics
+    ) {
+        return gpp::astar_algorithm<t_graph>::invoke(graph, from, to, heuristics, distanceFunction, statistics);
+    }
 }
 #endif //GRAPPHS_ASTAR_H
@@ -0,0 +1,265 @@
+#ifndef GRAPPHS_CHAIN_CONTRACTION_H
+#define GRAPPHS_CHAIN_CONTRACTION_H
+
+#include <grapphs/csr_graph.h>
+#include <grapphs/graph_builder.h>
+
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gpp {
+
+    /**
+     * Edge of a contracted graph, standing for a whole chain of edges of the original graph.
+     */
+    template<typename t_cost>
+    struct contracted_edge {
+        /**
+         * Sum of the costs of the original edges.
+         */
+        t_cost cost;
+        /**
+         * Where the chain's original vertices, both ends included, start in
+         * contracted_graph::polylines().
+         */
+        std::size_t firstPoint;
+        std::size_t numPoints;
+    };
+
+    /**
+     * Result of gpp::contract_chains. The contracted graph keeps, as vertex data, the original
+     * index of each of its vertices.
+     */
+    template<typename t_cost, typename t_index = default_graph_index>
+    class contracted_graph {
+    public:
+        using index_type = t_index;
+        using cost_type = t_cost;
+        using edge_type = contracted_edge<t_cost>;
+        using graph_type = csr_graph<index_type, edge_type, index_type>;
+
+        static constexpr index_type invalid_index() {
+            return std::numeric_limits<index_type>::max();
+        }
+
+    private:
+        graph_type _graph;
+        std::vector<index_type> _polylines;
+        std::vector<index_type> _originalToContracted;
+
+    public:
+        contracted_graph(
+            graph_type&& graph,
+            std::vector<index_type>&& polylines,
+            std::vector<index_type>&& originalToContracted
+        ) : _graph(std::move(graph)),
+            _polylines(std::move(polylines)),
+            _originalToContracted(std::move(originalToContracted)) {
+        }
+
+        const graph_type& graph() const {
+            return _graph;
+        }
+
+        /**
+         * @returns The original vertices of every contracted edge, one run per edge.
+         */
+        const std::vector<index_type>& polylines() const {
+            return _polylines;
+        }
+
+        /**
+         * @returns The original vertices \p edge goes through, both ends included.
+         */
+        std::pair<const index_type*, std::size_t> polyline(const edge_type& edge) const {
+            return std::make_pair(_polylines.data() + edge.firstPoint, edge.numPoints);
+        }
+
+        index_type to_original(index_type contracted) const {
+            return *_graph.vertex(contracted);
+        }
+
+        /**
+         * @returns The contracted index of \p original, or invalid_index() if it was contracted
+         * into an edge.
+         */
+        index_type to_contracted(index_type original) const {
+            return _originalToContracted[original];
+        }
+
+        /**
+         * Expands a path of contracted vertices into the path of original vertices it stands
+         * for. Between vertices joined by more than one chain, the cheapest chain is taken.
+         * @throws std::invalid_argument if two consecutive vertices of \p path are not adjacent.
+         */
+        std::vector<index_type> expand(const std::vector<index_type>& path) const {
+            std::vector<index_type> expanded;
+            if (path.empty()) {
+                return expanded;
+            }
+            expanded.push_back(to_original(path.front()));
+            for (std::size_t i = 1; i < path.size(); ++i) {
+                const edge_type* best = nullptr;
+                for (const auto& [to, edge] : _graph.edges_from(path[i - 1])) {
+                    if (to == path[i] && (best == nullptr || edge.cost < best->cost)) {
+                        best = &edge;
+                    }
+                }
+                if (best == nullptr) {
+                    throw std::invalid_argument("contracted path has consecutive vertices which are not adjacent");
+                }
+                auto [points, numPoints] = polyline(*best);
+                expanded.insert(expanded.end(), points + 1, points + numPoints);
+            }
+            return expanded;
+        }
+    };
+
+    namespace detail {
+
+        /**
+         * Up to two neighbors on each side are enough to tell chains apart, so counts stop at 3.
+         */
+        template<typename t_index>
+        struct chain_neighbors {
+            t_index in[2] = {std::numeric_limits<t_index>::max(), std::numeric_limits<t_index>::max()};
+            t_index out[2] = {std::numeric_limits<t_index>::max(), std::numeric_limits<t_index>::max()};
+            std::size_t numIn = 0;
+            std::size_t numOut = 0;
+            bool selfLoop = false;
+        };
+    }
+
+    /**
+     * Contracts every chain of degree-2 vertices of \p graph into a single edge, whose cost
+     * is the sum of \p cost (invoked as cost(from, to, edge)) over the chain.
+     *
+     * A vertex is contracted when it only carries geometry: it has one incoming and one
+     * outgoing edge to two different vertices, or it is connected both ways to exactly two
+     * vertices. Cycles made of such vertices only keep one of them.
+     *
+     * The vertices of \p graph must be indexed from 0 to size() - 1.
+     */
+    template<typename t_graph, typename t_cost_function>
+    contracted_graph<
+        std::decay_t<std::invoke_result_t<
+            t_cost_function,
+            typename t_graph::index_type,
+            typename t_graph::index_type,
+            const typename t_graph::edge_type&
+        >>,
+        typename t_graph::index_type
+    > contract_chains(const t_graph& graph, const t_cost_function& cost) {
+        using index_type = typename t_graph::index_type;
+        using cost_type = std::decay_t<std::invoke_result_t<
+            t_cost_function,
+            index_type,
+            index_type,
+            const typename t_graph::edge_type&
+        >>;
+        using result_type = contracted_graph<cost_type, index_type>;
+        constexpr index_type invalid = result_type::invalid_index();
+
+        index_type numVertices = graph.size();
+
+        using neighbors = detail::chain_neighbors<index_type>;
+        std::vector<neighbors> adjacency(numVertices);
+        auto record = [](index_type* into, std::size_t& count, index_type vertex) {
+            if (count < 2) {
+                into[count] = vertex;
+            }
+            if (count < 3) {
+                count++;
+            }
+        };
+        for (index_type from = 0; from < numVertices; ++from) {
+            for (const auto& [to, edge] : graph.edges_from(from)) {
+                if (to == from) {
+                    adjacency[from].selfLoop = true;
+                    continue;
+                }
+                record(adjacency[from].out, adjacency[from].numOut, to);
+                record(adjacency[to].in, adjacency[to].numIn, from);
+            }
+        }
+
+        std::vector<bool> contracted(numVertices, false);
+        for (index_type v = 0; v < numVertices; ++v) {
+            const neighbors& n = adjacency[v];
+            if (n.selfLoop) {
+                continue;
+            }
+            if (n.numIn == 1 && n.numOut == 1) {
+                contracted[v] = n.in[0] != n.out[0];
+            }
+            else if (n.numIn == 2 && n.numOut == 2) {
+                contracted[v] = n.out[0] != n.out[1]
+                                && ((n.in[0] == n.out[0] && n.in[1] == n.out[1])
+                                    || (n.in[0] == n.out[1] && n.in[1] == n.out[0]));
+            }
+        }
+
+        std::vector<index_type> originalToContracted(numVertices, invalid);
+        std::vector<index_type> contractedToOriginal;
+        auto keep = [&](index_type v) {
+            originalToContracted[v] = static_cast<index_type>(contractedToOriginal.size());
+            contractedToOriginal.push_back(v);
+        };
+        for (index_type v = 0; v < numVertices; ++v) {
+            if (!contracted[v]) {
+                keep(v);
+            }
+        }
+
+        graph_builder<contracted_edge<cost_type>, index_type> builder;
+        builder.set_sort_targets(true);
+        std::vector<index_type> polylines;
+        std::vector<bool> walked(numVertices, false);
+
+        auto walkFrom = [&](index_type anchor) {
+            for (const auto& [first, firstEdge] : graph.edges_from(anchor)) {
+                std::size_t firstPoint = polylines.size();
+                polylines.push_back(anchor);
+                cost_type total = cost(anchor, first, firstEdge);
+                index_type previous = anchor;
+                index_type current = first;
+                while (contracted[current] && current != anchor) {
+                    walked[current] = true;
+                    polylines.push_back(current);
+                    const neighbors& n = adjacency[current];
+                    index_type next = n.out[0] != previous || n.numOut == 1 ? n.out[0] : n.out[1];
+                    total = total + cost(current, next, *graph.edge(current, next));
+                    previous = current;
+                    current = next;
+                }
+                polylines.push_back(current);
+                builder.add(
+                    originalToContracted[anchor],
+                    originalToContracted[current],
+                    contracted_edge<cost_type>{total, firstPoint, polylines.size() - firstPoint}
+                );
+            }
+        };
+
+        for (index_type anchor : contractedToOriginal) {
+            walkFrom(anchor);
+        }
+        // Cycles made of contracted vertices only are never reached from a kept vertex, so one
+        // vertex of each is kept instead.
+        for (index_type v = 0; v < numVertices; ++v) {
+            if (contracted[v] && !walked[v]) {
+                contracted[v] = false;
+                keep(v);
+                walkFrom(v);
+            }
+        }
+
+        auto contractedGraph = builder.build_csr(std::move(contractedToOriginal));
+        return result_type(std::move(contractedGraph), std::move(polylines), std::move(originalToContracted));
+    }
+}
+
+#endif
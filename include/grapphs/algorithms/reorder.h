@@ -0,0 +1,376 @@
+#ifndef GRAPPHS_REORDER_H
+#define GRAPPHS_REORDER_H
+
+#include <grapphs/adjacency_list.h>
+#include <grapphs/csr_graph.h>
+#include <grapphs/parallel.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gpp {
+
+    /**
+     * Relabeling of the vertices of a graph, see gpp::reorder.
+     */
+    template<typename t_index = default_graph_index>
+    struct vertex_permutation {
+        std::vector<t_index> oldToNew;
+        std::vector<t_index> newToOld;
+
+        /**
+         * Builds the permutation that places the vertices in the order of \p order.
+         * @throws std::invalid_argument if \p order is not a permutation of 0 to size - 1.
+         */
+        static vertex_permutation from_order(std::vector<t_index> order) {
+            vertex_permutation permutation;
+            constexpr t_index invalid = std::numeric_limits<t_index>::max();
+            permutation.oldToNew.assign(order.size(), invalid);
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                t_index old = order[i];
+                if (old >= order.size() || permutation.oldToNew[old] != invalid) {
+                    throw std::invalid_argument("vertex order is not a permutation");
+                }
+                permutation.oldToNew[old] = static_cast<t_index>(i);
+            }
+            permutation.newToOld = std::move(order);
+            return permutation;
+        }
+
+        std::size_t size() const {
+            return newToOld.size();
+        }
+    };
+
+    /**
+     * @returns A copy of \p graph whose vertex at new index i is the vertex at old index
+     * permutation.newToOld[i], with every edge relabeled accordingly. Vertices are filled in
+     * parallel, see adjacency_list::allocating_threads. The vertices of \p graph must be indexed from 0 to size() - 1.
+     */
+    template<typename t_vertex, typename t_edge, typename t_index, typename t_allocator>
+    adjacency_list<t_vertex, t_edge, t_index, t_allocator> reorder(
+        const adjacency_list<t_vertex, t_edge, t_index, t_allocator>& graph,
+        const vertex_permutation<t_index>& permutation
+    ) {
+        if (permutation.size() != graph.index_bound()) {
+            throw std::invalid_argument("permutation size does not match the graph");
+        }
+        adjacency_list<t_vertex, t_edge, t_index, t_allocator> result(graph.get_allocator());
+        t_index numVertices = static_cast<t_index>(permutation.size());
+        result.reserve(numVertices);
+        for (t_index i = 0; i < numVertices; ++i) {
+            result.push(*graph.vertex(permutation.newToOld[i]));
+        }
+        parallel_for(
+            t_index(0), numVertices, [&](t_index begin, t_index end, std::size_t) {
+                for (t_index i = begin; i < end; ++i) {
+                    const auto& connections = graph.node(permutation.newToOld[i]).connections();
+                    auto& node = result.node(i);
+                    node.reserve(connections.size());
+                    for (const auto& [to, edge] : connections) {
+                        node.connect(permutation.oldToNew[to], edge);
+                    }
+                }
+            }, result.allocating_threads(0)
+        );
+        return result;
+    }
+
+    /**
+     * @returns A copy of \p graph relabeled by \p permutation, see the adjacency_list overload.
+     * The edges of each vertex keep their relative order.
+     */
+    template<typename t_vertex, typename t_edge, typename t_index>
+    csr_graph<t_vertex, t_edge, t_index> reorder(
+        const csr_graph<t_vertex, t_edge, t_index>& graph,
+        const vertex_permutation<t_index>& permutation
+    ) {
+        if (permutation.size() != graph.size()) {
+            throw std::invalid_argument("permutation size does not match the graph");
+        }
+        t_index numVertices = graph.size();
+        std::vector<t_vertex> vertices(numVertices);
+        std::vector<t_index> offsets(numVertices + 1, 0);
+        for (t_index i = 0; i < numVertices; ++i) {
+            vertices[i] = *graph.vertex(permutation.newToOld[i]);
+            offsets[i + 1] = offsets[i] + graph.degree(permutation.newToOld[i]);
+        }
+        std::vector<t_index> targets(graph.num_edges());
+        std::vector<t_edge> edges(graph.num_edges());
+        parallel_for(
+            t_index(0), numVertices, [&](t_index begin, t_index end, std::size_t) {
+                for (t_index i = begin; i < end; ++i) {
+                    t_index slot = offsets[i];
+                    for (const auto& [to, edge] : graph.edges_from(permutation.newToOld[i])) {
+                        targets[slot] = permutation.oldToNew[to];
+                        edges[slot] = edge;
+                        slot++;
+                    }
+                }
+            }
+        );
+        return csr_graph<t_vertex, t_edge, t_index>(
+            std::move(vertices),
+            std::move(offsets),
+            std::move(targets),
+            std::move(edges)
+        );
+    }
+
+    namespace detail {
+
+        /**
+         * Symmetric adjacency of a graph, in CSR form, ignoring self loops.
+         */
+        template<typename t_index>
+        struct undirected_adjacency {
+            std::vector<t_index> offsets;
+            std::vector<t_index> neighbors;
+
+            t_index degree(t_index vertex) const {
+                return offsets[vertex + 1] - offsets[vertex];
+            }
+        };
+
+        template<typename t_graph>
+        undirected_adjacency<typename t_graph::index_type> make_undirected(const t_graph& graph) {
+            using index_type = typename t_graph::index_type;
+            index_type numVertices = graph.size();
+            std::vector<std::pair<index_type, index_type>> pairs;
+            for (index_type from = 0; from < numVertices; ++from) {
+                for (const auto& [to, edge] : graph.edges_from(from)) {
+                    if (to != from) {
+                        pairs.emplace_back(from, to);
+                        pairs.emplace_back(to, from);
+                    }
+                }
+            }
+            std::sort(pairs.begin(), pairs.end());
+            pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+            undirected_adjacency<index_type> adjacency;
+            adjacency.offsets.assign(numVertices + 1, 0);
+            adjacency.neighbors.reserve(pairs.size());
+            for (const auto& [from, to] : pairs) {
+                adjacency.offsets[from + 1]++;
+                adjacency.neighbors.push_back(to);
+            }
+            for (index_type i = 0; i < numVertices; ++i) {
+                adjacency.offsets[i + 1] += adjacency.offsets[i];
+            }
+            return adjacency;
+        }
+
+        /**
+         * Rotates and flips the quadrant of (x, y) as required by the Hilbert curve.
+         */
+        inline void hilbert_rotate(std::uint32_t size, std::uint32_t& x, std::uint32_t& y, bool rx, bool ry) {
+            if (!ry) {
+                if (rx) {
+                    x = size - 1 - x;
+                    y = size - 1 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+
+        inline std::uint64_t hilbert_index(std::uint32_t x, std::uint32_t y, unsigned bits) {
+            std::uint64_t index = 0;
+            for (std::uint32_t size = 1U << (bits - 1); size > 0; size >>= 1) {
+                bool rx = (x & size) != 0;
+                bool ry = (y & size) != 0;
+                index += static_cast<std::uint64_t>(size) * size * ((rx ? 3U : 0U) ^ (ry ? 1U : 0U));
+                hilbert_rotate(1U << bits, x, y, rx, ry);
+            }
+            return index;
+        }
+    }
+
+    /**
+     * @returns The order in which the points of \p graph's vertices are met along a Hilbert
+     * curve, so that vertices close in space get close indices. \p position is invoked as
+     * position(index, x, y), writing the location of each vertex into x and y.
+     */
+    template<typename t_graph, typename t_position>
+    vertex_permutation<typename t_graph::index_type> hilbert_order(
+        const t_graph& graph,
+        const t_position& position
+    ) {
+        using index_type = typename t_graph::index_type;
+        constexpr unsigned k_bits = 16;
+        index_type numVertices = graph.size();
+
+        std::vector<double> xs(numVertices), ys(numVertices);
+        double minX = std::numeric_limits<double>::max(), minY = minX;
+        double maxX = -std::numeric_limits<double>::max(), maxY = maxX;
+        for (index_type i = 0; i < numVertices; ++i) {
+            position(i, xs[i], ys[i]);
+            minX = std::min(minX, xs[i]);
+            minY = std::min(minY, ys[i]);
+            maxX = std::max(maxX, xs[i]);
+            maxY = std::max(maxY, ys[i]);
+        }
+        double extent = std::max(maxX - minX, maxY - minY);
+        double scale = extent > 0 ? ((1U << k_bits) - 1) / extent : 0;
+
+        std::vector<std::pair<std::uint64_t, index_type>> keys(numVertices);
+        parallel_for(
+            index_type(0), numVertices, [&](index_type begin, index_type end, std::size_t) {
+                for (index_type i = begin; i < end; ++i) {
+                    auto x = static_cast<std::uint32_t>((xs[i] - minX) * scale);
+                    auto y = static_cast<std::uint32_t>((ys[i] - minY) * scale);
+                    keys[i] = std::make_pair(detail::hilbert_index(x, y, k_bits), i);
+                }
+            }
+        );
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<index_type> order(numVertices);
+        for (index_type i = 0; i < numVertices; ++i) {
+            order[i] = keys[i].second;
+        }
+        return vertex_permutation<index_type>::from_order(std::move(order));
+    }
+
+    /**
+     * @returns The reverse Cuthill-McKee order of \p graph, treating edges as undirected.
+     * It keeps the bandwidth of the adjacency matrix small, so neighbors get close indices.
+     * Each connected component starts from its vertex with the lowest degree.
+     */
+    template<typename t_graph>
+    vertex_permutation<typename t_graph::index_type> reverse_cuthill_mckee_order(const t_graph& graph) {
+        using index_type = typename t_graph::index_type;
+        index_type numVertices = graph.size();
+        detail::undirected_adjacency<index_type> adjacency = detail::make_undirected(graph);
+
+        std::vector<index_type> byDegree(numVertices);
+        std::iota(byDegree.begin(), byDegree.end(), index_type(0));
+        std::stable_sort(
+            byDegree.begin(), byDegree.end(), [&](index_type a, index_type b) {
+                return adjacency.degree(a) < adjacency.degree(b);
+            }
+        );
+
+        std::vector<index_type> order;
+        order.reserve(numVertices);
+        std::vector<bool> visited(numVertices, false);
+        std::vector<index_type> neighbors;
+        for (index_type root : byDegree) {
+            if (visited[root]) {
+                continue;
+            }
+            visited[root] = true;
+            std::size_t head = order.size();
+            order.push_back(root);
+            while (head < order.size()) {
+                index_type vertex = order[head++];
+                neighbors.clear();
+                for (index_type i = adjacency.offsets[vertex]; i < adjacency.offsets[vertex + 1]; ++i) {
+                    index_type neighbor = adjacency.neighbors[i];
+                    if (!visited[neighbor]) {
+                        visited[neighbor] = true;
+                        neighbors.push_back(neighbor);
+                    }
+                }
+                std::stable_sort(
+                    neighbors.begin(), neighbors.end(), [&](index_type a, index_type b) {
+                        return adjacency.degree(a) < adjacency.degree(b);
+                    }
+                );
+                order.insert(order.end(), neighbors.begin(), neighbors.end());
+            }
+        }
+        std::reverse(order.begin(), order.end());
+        return vertex_permutation<index_type>::from_order(std::move(order));
+    }
+
+    /**
+     * @returns The order in which a breadth first search along outgoing edges discovers the
+     * vertices of \p graph, starting at \p start and then at the lowest unvisited index until
+     * every vertex is discovered.
+     */
+    template<typename t_graph>
+    vertex_permutation<typename t_graph::index_type> bfs_order(
+        const t_graph& graph,
+        typename t_graph::index_type start = 0
+    ) {
+        using index_type = typename t_graph::index_type;
+        index_type numVertices = graph.size();
+        std::vector<index_type> order;
+        order.reserve(numVertices);
+        std::vector<bool> visited(numVertices, false);
+        auto visitFrom = [&](index_type root) {
+            if (visited[root]) {
+                return;
+            }
+            visited[root] = true;
+            std::size_t head = order.size();
+            order.push_back(root);
+            while (head < order.size()) {
+                index_type vertex = order[head++];
+                for (const auto& [to, edge] : graph.edges_from(vertex)) {
+                    if (!visited[to]) {
+                        visited[to] = true;
+                        order.push_back(to);
+                    }
+                }
+            }
+        };
+        if (numVertices > 0) {
+            visitFrom(start);
+        }
+        for (index_type i = 0; i < numVertices; ++i) {
+            visitFrom(i);
+        }
+        return vertex_permutation<index_type>::from_order(std::move(order));
+    }
+
+    /**
+     * @returns The preorder in which a depth first search along outgoing edges visits the
+     * vertices of \p graph, starting at \p start and then at the lowest unvisited index until
+     * every vertex is visited.
+     */
+    template<typename t_graph>
+    vertex_permutation<typename t_graph::index_type> dfs_order(
+        const t_graph& graph,
+        typename t_graph::index_type start = 0
+    ) {
+        using index_type = typename t_graph::index_type;
+        index_type numVertices = graph.size();
+        std::vector<index_type> order;
+        order.reserve(numVertices);
+        std::vector<bool> visited(numVertices, false);
+        std::vector<index_type> open;
+        auto visitFrom = [&](index_type root) {
+            open.push_back(root);
+            while (!open.empty()) {
+                index_type vertex = open.back();
+                open.pop_back();
+                if (visited[vertex]) {
+                    continue;
+                }
+                visited[vertex] = true;
+                order.push_back(vertex);
+                for (const auto& [to, edge] : graph.edges_from(vertex)) {
+                    if (!visited[to]) {
+                        open.push_back(to);
+                    }
+                }
+            }
+        };
+        if (numVertices > 0) {
+            visitFrom(start);
+        }
+        for (index_type i = 0; i < numVertices; ++i) {
+            visitFrom(i);
+        }
+        return vertex_permutation<index_type>::from_order(std::move(order));
+    }
+}
+
+#endif
@@ -3,8 +3,48 @@
 
 #include <grapphs/algorithms/bfs_traversal.h>
 
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
 namespace gpp {
 
+    namespace detail {
+
+        /**
+         * Visits \p verticesOrder backwards, each vertex followed by the recorded edges that
+         * lead to it, latest first. Edges are bucketed by target up front so this is O(V+E).
+         */
+        template<typename graph_type>
+        void reverse_level_order_visit(
+            const std::vector<typename graph_type::index_type>& verticesOrder,
+            const std::vector<std::tuple<typename graph_type::index_type, typename graph_type::index_type>>& edgesOrder,
+            const vertex_explorer<graph_type>& perVertex,
+            const edge_explorer<graph_type>& perEdge
+        ) {
+            using index_type = typename graph_type::index_type;
+
+            std::unordered_map<index_type, std::vector<index_type>> sources;
+            sources.reserve(verticesOrder.size());
+            for (auto it = edgesOrder.rbegin(); it != edgesOrder.rend(); ++it) {
+                auto [from, to] = *it;
+                sources[to].push_back(from);
+            }
+
+            for (auto it = verticesOrder.rbegin(); it != verticesOrder.rend(); ++it) {
+                index_type vertex = *it;
+                perVertex(vertex);
+                auto found = sources.find(vertex);
+                if (found == sources.end()) {
+                    continue;
+                }
+                for (index_type from : found->second) {
+                    perEdge(from, vertex);
+                }
+            }
+        }
+    }
+
     template<typename graph_type>
     void reverse_level_order_traverse(
         const graph_type& graph,
@@ -28,17 +68,7 @@ namespace gpp {
             }
         );
 
-        std::reverse(verticesOrder.begin(), verticesOrder.end());
-        std::reverse(edgesOrder.begin(), edgesOrder.end());
-
-        for (index_type vertex : verticesOrder) {
-            perVertex(vertex);
-            for (auto [from, to] : edgesOrder) {
-                if (to == vertex) {
-                    perEdge(from, to);
-                }
-            }
-        }
+        detail::reverse_level_order_visit<graph_type>(verticesOrder, edgesOrder, perVertex, perEdge);
     }
 
     template<typename graph_type>
@@ -64,17 +94,7 @@ namespace gpp {
             }
         );
 
-        std::reverse(verticesOrder.begin(), verticesOrder.end());
-        std::reverse(edgesOrder.begin(), edgesOrder.end());
-
-        for (index_type vertex : verticesOrder) {
-            perVertex(vertex);
-            for (auto [from, to] : edgesOrder) {
-                if (to == vertex) {
-                    perEdge(from, to);
-                }
-            }
-        }
+        detail::reverse_level_order_visit<graph_type>(verticesOrder, edgesOrder, perVertex, perEdge);
     }
 }
-#endif
\ No newline at end of file
+#endif
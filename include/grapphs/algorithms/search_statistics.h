@@ -0,0 +1,172 @@
+#ifndef GRAPPHS_SEARCH_STATISTICS_H
+#define GRAPPHS_SEARCH_STATISTICS_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace gpp {
+
+    /**
+     * Phases searches are split into, each one timed separately.
+     */
+    enum class search_phase {
+        /**
+         * Seeding the open set with the starting points.
+         */
+        SETUP,
+        /**
+         * Expanding vertices until the goal is reached or the open set runs dry.
+         */
+        SEARCH,
+        /**
+         * Walking back from the goal to build the path found.
+         */
+        PATH_RECONSTRUCTION
+    };
+
+    constexpr std::size_t k_num_search_phases = 3;
+
+    /**
+     * Statistics policy of searches which collect nothing, the default. Every hook is empty,
+     * so instrumentation compiles away.
+     *
+     * Searches (astar, traverse) take their statistics policy as a template parameter and
+     * invoke these hooks on it; any type providing the same members may stand in for
+     * search_statistics, e.g. to forward them to a metrics system.
+     */
+    struct no_search_statistics {
+        void begin_phase(search_phase) {
+        }
+
+        void end_phase(search_phase) {
+        }
+
+        /**
+         * A vertex was taken out of the open set and its edges explored.
+         */
+        void on_vertex_expanded() {
+        }
+
+        /**
+         * An edge leaving an expanded vertex was considered.
+         */
+        void on_edge_relaxed() {
+        }
+
+        /**
+         * A vertex was pushed into the open set, which now holds \p openSize vertices.
+         */
+        void on_push(std::size_t) {
+        }
+
+        /**
+         * A vertex already in the open set got a better score.
+         */
+        void on_decrease_key() {
+        }
+    };
+
+    /**
+     * Counters filled by the searches it is given to. Counters accumulate across searches until
+     * reset(), so a single object may aggregate many queries; operator+= merges objects
+     * filled by different threads.
+     */
+    struct search_statistics {
+        std::size_t verticesExpanded = 0;
+        std::size_t edgesRelaxed = 0;
+        std::size_t heapPushes = 0;
+        std::size_t decreaseKeys = 0;
+        /**
+         * Largest number of vertices held by the open set at once.
+         */
+        std::size_t peakOpenSize = 0;
+        /**
+         * Wall time spent in each phase, indexed by search_phase.
+         */
+        std::array<std::chrono::nanoseconds, k_num_search_phases> phaseTimes{};
+
+        void begin_phase(search_phase) {
+            _phaseStart = std::chrono::steady_clock::now();
+        }
+
+        void end_phase(search_phase phase) {
+            phaseTimes[static_cast<std::size_t>(phase)] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - _phaseStart
+            );
+        }
+
+        void on_vertex_expanded() {
+            ++verticesExpanded;
+        }
+
+        void on_edge_relaxed() {
+            ++edgesRelaxed;
+        }
+
+        void on_push(std::size_t openSize) {
+            ++heapPushes;
+            peakOpenSize = std::max(peakOpenSize, openSize);
+        }
+
+        void on_decrease_key() {
+            ++decreaseKeys;
+        }
+
+        std::chrono::nanoseconds phase_time(search_phase phase) const {
+            return phaseTimes[static_cast<std::size_t>(phase)];
+        }
+
+        std::chrono::nanoseconds total_time() const {
+            std::chrono::nanoseconds total(0);
+            for (std::chrono::nanoseconds time : phaseTimes) {
+                total += time;
+            }
+            return total;
+        }
+
+        void reset() {
+            *this = search_statistics();
+        }
+
+        search_statistics& operator+=(const search_statistics& other) {
+            verticesExpanded += other.verticesExpanded;
+            edgesRelaxed += other.edgesRelaxed;
+            heapPushes += other.heapPushes;
+            decreaseKeys += other.decreaseKeys;
+            peakOpenSize = std::max(peakOpenSize, other.peakOpenSize);
+            for (std::size_t i = 0; i < k_num_search_phases; ++i) {
+                phaseTimes[i] += other.phaseTimes[i];
+            }
+            return *this;
+        }
+
+    private:
+        std::chrono::steady_clock::time_point _phaseStart;
+    };
+
+    /**
+     * Times \p phase on \p statistics for as long as it lives.
+     */
+    template<typename t_statistics>
+    class search_phase_scope {
+    private:
+        t_statistics& _statistics;
+        search_phase _phase;
+
+    public:
+        search_phase_scope(t_statistics& statistics, search_phase phase) : _statistics(statistics), _phase(phase) {
+            _statistics.begin_phase(_phase);
+        }
+
+        ~search_phase_scope() {
+            _statistics.end_phase(_phase);
+        }
+
+        search_phase_scope(const search_phase_scope&) = delete;
+
+        search_phase_scope& operator=(const search_phase_scope&) = delete;
+    };
+}
+#endif
@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <grapphs/graph.h>
+#include <grapphs/algorithms/search_statistics.h>
 #include <deque>
 #include <set>
 
@@ -32,12 +33,17 @@ namespace gpp {
         static index_type next(std::deque<index_type>& open);
     };
 
-    template<typename t_graph, traversal_order order>
+    /**
+     * Visits every vertex reachable from \p startingPoints in the given order, reporting what
+     * it does to \p statistics, see gpp::search_statistics.
+     */
+    template<typename t_graph, traversal_order order, typename t_statistics>
     void traverse(
         const t_graph& graph,
         std::set<typename t_graph::index_type> startingPoints,
         const vertex_explorer<t_graph>& perVertex,
-        const edge_explorer<t_graph>& perEdge
+        const edge_explorer<t_graph>& perEdge,
+        t_statistics& statistics
     ) {
         using vertex_type = typename t_graph::vertex_type;
         using index_type = typename t_graph::index_type;
@@ -46,10 +52,15 @@ namespace gpp {
         std::deque<index_type> open;
         std::set<index_type> visited;
 
-        for (index_type item : startingPoints) {
-            open.push_back(item);
+        {
+            gpp::search_phase_scope<t_statistics> phase(statistics, search_phase::SETUP);
+            for (index_type item : startingPoints) {
+                open.push_back(item);
+                statistics.on_push(open.size());
+            }
         }
 
+        gpp::search_phase_scope<t_statistics> phase(statistics, search_phase::SEARCH);
         while (!open.empty()) {
             index_type next = Traversal<t_graph, order>::next(open);
 
@@ -59,14 +70,17 @@ namespace gpp {
 
             perVertex(next);
             visited.emplace(next);
+            statistics.on_vertex_expanded();
 
             for (auto [neighbor, edge] : graph.edges_from(next)) {
+                statistics.on_edge_relaxed();
                 if (visited.find(neighbor) != visited.end()) {
                     continue;
                 }
 
                 perEdge(static_cast<index_type>(next), static_cast<index_type>(neighbor));
                 open.push_back(neighbor);
+                statistics.on_push(open.size());
             }
         }
     }
@@ -74,17 +88,41 @@ namespace gpp {
     template<typename t_graph, traversal_order order>
     void traverse(
         const t_graph& graph,
-        typename t_graph::index_type startingPoint,
+        std::set<typename t_graph::index_type> startingPoints,
         const vertex_explorer<t_graph>& perVertex,
         const edge_explorer<t_graph>& perEdge
+    ) {
+        gpp::no_search_statistics statistics;
+        traverse<t_graph, order>(graph, std::move(startingPoints), perVertex, perEdge, statistics);
+    }
+
+    template<typename t_graph, traversal_order order, typename t_statistics>
+    void traverse(
+        const t_graph& graph,
+        typename t_graph::index_type startingPoint,
+        const vertex_explorer<t_graph>& perVertex,
+        const edge_explorer<t_graph>& perEdge,
+        t_statistics& statistics
     ) {
         traverse<t_graph, order>(
             graph,
             std::set<typename t_graph::index_type>({startingPoint}),
             perVertex,
-            perEdge
+            perEdge,
+            statistics
         );
     }
 
+    template<typename t_graph, traversal_order order>
+    void traverse(
+        const t_graph& graph,
+        typename t_graph::index_type startingPoint,
+        const vertex_explorer<t_graph>& perVertex,
+        const edge_explorer<t_graph>& perEdge
+    ) {
+        gpp::no_search_statistics statistics;
+        traverse<t_graph, order>(graph, startingPoint, perVertex, perEdge, statistics);
+    }
+
 }
 #endif
@@ -0,0 +1,458 @@
+#ifndef GRAPPHS_BINARY_H
+#define GRAPPHS_BINARY_H
+
+#include <grapphs/graph.h>
+#include <grapphs/graph_view.h>
+#include <grapphs/csr_graph.h>
+#include <grapphs/mapped_file.h>
+#include <grapphs/parallel.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gpp {
+
+    /**
+     * Grapphs binary files start with a binary_header, followed by a table of binary_section
+     * entries describing arrays of trivially copyable elements. Every section starts at a
+     * multiple of k_binary_alignment, so the whole file can be memory mapped and its sections
+     * used in place. All values are stored in the byte order of the machine that wrote them.
+     */
+    constexpr std::uint32_t k_binary_format_version = 1;
+    constexpr std::uint32_t k_binary_byte_order_mark = 0x01020304;
+    constexpr std::size_t k_binary_alignment = 64;
+    constexpr char k_binary_magic[8] = {'G', 'R', 'A', 'P', 'P', 'H', 'S', '\0'};
+
+    enum class binary_section_id : std::uint32_t {
+        OFFSETS = 1,
+        TARGETS = 2,
+        VERTICES = 3,
+        EDGES = 4,
+        /**
+         * First identifier available for sections that are not part of the graph itself.
+         */
+        USER = 1 << 16
+    };
+
+    struct binary_header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrderMark;
+        std::uint32_t numSections;
+        std::uint32_t reserved;
+        std::uint64_t fileSize;
+    };
+
+    struct binary_section {
+        std::uint32_t id;
+        std::uint32_t elementSize;
+        std::uint64_t offset;
+        std::uint64_t count;
+    };
+
+    static_assert(sizeof(binary_header) == 32, "binary_header must not contain padding");
+    static_assert(sizeof(binary_section) == 24, "binary_section must not contain padding");
+
+    /**
+     * Collects sections and writes them out as a grapphs binary file.
+     * Section contents are only referenced, so they must outlive the call to write().
+     */
+    class binary_writer {
+    private:
+        struct pending_section {
+            binary_section section;
+            const void* data;
+        };
+
+        std::vector<pending_section> _sections;
+
+        static std::uint64_t align(std::uint64_t offset) {
+            return (offset + k_binary_alignment - 1) / k_binary_alignment * k_binary_alignment;
+        }
+
+        static void pad(std::ofstream& file, std::uint64_t from, std::uint64_t to) {
+            static const char zeros[k_binary_alignment] = {};
+            file.write(zeros, static_cast<std::streamsize>(to - from));
+        }
+
+    public:
+        template<typename t_element>
+        void add_section(std::uint32_t id, const t_element* data, std::size_t count) {
+            static_assert(
+                std::is_trivially_copyable_v<t_element>,
+                "Only trivially copyable types can be stored in binary sections"
+            );
+            binary_section section{id, sizeof(t_element), 0, count};
+            _sections.push_back(pending_section{section, data});
+        }
+
+        template<typename t_element>
+        void add_section(std::uint32_t id, const std::vector<t_element>& data) {
+            add_section(id, data.data(), data.size());
+        }
+
+        template<typename t_element>
+        void add_section(binary_section_id id, const std::vector<t_element>& data) {
+            add_section(static_cast<std::uint32_t>(id), data.data(), data.size());
+        }
+
+        /**
+         * Writes all sections into \p path. The file is first written next to the destination
+         * and then renamed over it, so readers never observe a partially written file.
+         * @returns false if the file could not be written.
+         */
+        bool write(const std::filesystem::path& path) {
+            binary_header header{};
+            std::memcpy(header.magic, k_binary_magic, sizeof(header.magic));
+            header.version = k_binary_format_version;
+            header.byteOrderMark = k_binary_byte_order_mark;
+            header.numSections = static_cast<std::uint32_t>(_sections.size());
+
+            std::uint64_t offset = align(sizeof(binary_header) + sizeof(binary_section) * _sections.size());
+            for (pending_section& pending : _sections) {
+                pending.section.offset = offset;
+                offset = align(offset + pending.section.elementSize * pending.section.count);
+            }
+            header.fileSize = offset;
+
+            std::filesystem::path temporary = path;
+            temporary += ".tmp";
+            {
+                std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+                if (!file.is_open()) {
+                    return false;
+                }
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                std::uint64_t written = sizeof(header);
+                for (const pending_section& pending : _sections) {
+                    file.write(reinterpret_cast<const char*>(&pending.section), sizeof(binary_section));
+                    written += sizeof(binary_section);
+                }
+                for (const pending_section& pending : _sections) {
+                    pad(file, written, pending.section.offset);
+                    std::uint64_t numBytes = pending.section.elementSize * pending.section.count;
+                    file.write(static_cast<const char*>(pending.data), static_cast<std::streamsize>(numBytes));
+                    written = pending.section.offset + numBytes;
+                }
+                pad(file, written, header.fileSize);
+                if (!file.good()) {
+                    return false;
+                }
+            }
+            std::error_code error;
+            std::filesystem::rename(temporary, path, error);
+            return !error;
+        }
+    };
+
+    /**
+     * Memory maps a grapphs binary file and gives direct access to its sections.
+     */
+    class binary_reader {
+    private:
+        mapped_file _file;
+        const binary_section* _sections = nullptr;
+        std::uint32_t _numSections = 0;
+
+        [[noreturn]] static void invalid(const std::filesystem::path& path, const char* reason) {
+            throw std::runtime_error("'" + path.string() + "' is not a valid grapphs binary file: " + reason);
+        }
+
+        const binary_section* find(std::uint32_t id) const {
+            for (std::uint32_t i = 0; i < _numSections; ++i) {
+                if (_sections[i].id == id) {
+                    return &_sections[i];
+                }
+            }
+            return nullptr;
+        }
+
+    public:
+        /**
+         * @throws std::runtime_error if the file can't be mapped, or its header or section
+         * table are not valid for this version and machine.
+         */
+        explicit binary_reader(const std::filesystem::path& path) : _file(path) {
+            if (_file.size() < sizeof(binary_header)) {
+                invalid(path, "truncated header");
+            }
+            const auto* header = reinterpret_cast<const binary_header*>(_file.data());
+            if (std::memcmp(header->magic, k_binary_magic, sizeof(k_binary_magic)) != 0) {
+                invalid(path, "bad magic");
+            }
+            if (header->byteOrderMark != k_binary_byte_order_mark) {
+                invalid(path, "written with a different byte order");
+            }
+            if (header->version != k_binary_format_version) {
+                invalid(path, "unsupported version");
+            }
+            if (header->fileSize != _file.size()) {
+                invalid(path, "size mismatch");
+            }
+            _numSections = header->numSections;
+            _sections = reinterpret_cast<const binary_section*>(_file.data() + sizeof(binary_header));
+            if (sizeof(binary_header) + sizeof(binary_section) * _numSections > _file.size()) {
+                invalid(path, "truncated section table");
+            }
+            for (std::uint32_t i = 0; i < _numSections; ++i) {
+                const binary_section& section = _sections[i];
+                // Divides rather than multiplies, so that a corrupt count can't overflow past the check
+                if (section.offset % k_binary_alignment != 0
+                    || section.offset > _file.size()
+                    || (section.elementSize != 0
+                        && section.count > (_file.size() - section.offset) / section.elementSize)) {
+                    invalid(path, "section out of bounds");
+                }
+            }
+        }
+
+        bool has_section(std::uint32_t id) const {
+            return find(id) != nullptr;
+        }
+
+        bool has_section(binary_section_id id) const {
+            return has_section(static_cast<std::uint32_t>(id));
+        }
+
+        /**
+         * @returns A pointer to the first element of section \p id, whose length is written
+         * into \p count.
+         * @throws std::runtime_error if the section is missing or holds elements of a
+         * different size than t_element.
+         */
+        template<typename t_element>
+        const t_element* section(std::uint32_t id, std::size_t& count) const {
+            static_assert(
+                std::is_trivially_copyable_v<t_element>,
+                "Only trivially copyable types can be stored in binary sections"
+            );
+            const binary_section* found = find(id);
+            if (found == nullptr) {
+                throw std::runtime_error("missing binary section " + std::to_string(id));
+            }
+            if (found->elementSize != sizeof(t_element)) {
+                throw std::runtime_error("element size mismatch in binary section " + std::to_string(id));
+            }
+            count = static_cast<std::size_t>(found->count);
+            return reinterpret_cast<const t_element*>(_file.data() + found->offset);
+        }
+
+        template<typename t_element>
+        const t_element* section(binary_section_id id, std::size_t& count) const {
+            return section<t_element>(static_cast<std::uint32_t>(id), count);
+        }
+
+        template<typename t_element>
+        std::vector<t_element> copy_section(std::uint32_t id) const {
+            std::size_t count;
+            const t_element* data = section<t_element>(id, count);
+            return std::vector<t_element>(data, data + count);
+        }
+
+        template<typename t_element>
+        std::vector<t_element> copy_section(binary_section_id id) const {
+            return copy_section<t_element>(static_cast<std::uint32_t>(id));
+        }
+    };
+
+    /**
+     * Read only graph whose compressed sparse row arrays live directly inside a memory mapped
+     * grapphs binary file, see gpp::map_binary. The mapping is read only: the non const
+     * vertex() and edge() exist for the gpp::graph interface, but writing through them faults.
+     */
+    template<typename t_vertex, typename t_edge, typename t_index = default_graph_index>
+    class mapped_graph : public graph<t_vertex, t_edge, t_index> {
+    public:
+
+        using vertex_type = typename graph<t_vertex, t_edge, t_index>::vertex_type;
+        using edge_type = typename graph<t_vertex, t_edge, t_index>::edge_type;
+        using index_type = typename graph<t_vertex, t_edge, t_index>::index_type;
+        using graph_type = gpp::mapped_graph<t_vertex, t_edge, t_index>;
+        using edge_range = csr_edge_range<index_type, edge_type>;
+
+    private:
+        binary_reader _reader;
+        const vertex_type* _vertices;
+        const index_type* _offsets;
+        const index_type* _targets;
+        const edge_type* _edges;
+        std::size_t _numVertices;
+        std::size_t _numEdges;
+
+    public:
+        explicit mapped_graph(binary_reader&& reader) : _reader(std::move(reader)) {
+            std::size_t numOffsets;
+            _vertices = _reader.section<vertex_type>(binary_section_id::VERTICES, _numVertices);
+            _offsets = _reader.section<index_type>(binary_section_id::OFFSETS, numOffsets);
+            _targets = _reader.section<index_type>(binary_section_id::TARGETS, _numEdges);
+            std::size_t numEdgeValues;
+            _edges = _reader.section<edge_type>(binary_section_id::EDGES, numEdgeValues);
+            if (numOffsets != _numVertices + 1 || numEdgeValues != _numEdges
+                || _offsets[0] != 0 || _offsets[_numVertices] != _numEdges) {
+                throw std::runtime_error("inconsistent compressed sparse row sections");
+            }
+            // Checked once here, so that corrupt contents can't send lookups out of bounds later.
+            std::atomic<bool> valid(true);
+            parallel_for(
+                std::size_t(0), _numVertices, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        if (_offsets[i] > _offsets[i + 1]) {
+                            valid.store(false, std::memory_order_relaxed);
+                            return;
+                        }
+                    }
+                }
+            );
+            parallel_for(
+                std::size_t(0), _numEdges, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        if (_targets[i] >= _numVertices) {
+                            valid.store(false, std::memory_order_relaxed);
+                            return;
+                        }
+                    }
+                }
+            );
+            if (!valid.load()) {
+                throw std::runtime_error("compressed sparse row sections out of range");
+            }
+        }
+
+        index_type size() const final {
+            return static_cast<index_type>(_numVertices);
+        }
+
+        bool empty() const final {
+            return _numVertices == 0;
+        }
+
+        std::size_t num_edges() const {
+            return _numEdges;
+        }
+
+        index_type degree(index_type index) const {
+            return _offsets[index + 1] - _offsets[index];
+        }
+
+        vertex_type* vertex(index_type index) final {
+            return const_cast<vertex_type*>(&_vertices[index]);
+        }
+
+        const vertex_type* vertex(index_type index) const final {
+            return &_vertices[index];
+        }
+
+        edge_type* edge(index_type from, index_type to) final {
+            return const_cast<edge_type*>(std::as_const(*this).edge(from, to));
+        }
+
+        const edge_type* edge(index_type from, index_type to) const {
+            for (index_type i = _offsets[from]; i < _offsets[from + 1]; ++i) {
+                if (_targets[i] == to) {
+                    return &_edges[i];
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * Not supported, mapped graphs are read only.
+         */
+        void connect(index_type, index_type, edge_type) final {
+            throw std::logic_error("mapped_graph is read only");
+        }
+
+        /**
+         * Not supported, mapped graphs are read only.
+         */
+        bool disconnect(index_type, index_type) final {
+            throw std::logic_error("mapped_graph is read only");
+        }
+
+        edge_range edges_from(index_type index) const {
+            index_type begin = _offsets[index];
+            return edge_range(_targets + begin, _edges + begin, _offsets[index + 1] - begin);
+        }
+
+        std::vector<index_type> all_vertices_indices() const {
+            std::vector<index_type> indices(_numVertices);
+            for (index_type i = 0; i < indices.size(); ++i) {
+                indices[i] = i;
+            }
+            return indices;
+        }
+
+        const binary_reader& reader() const {
+            return _reader;
+        }
+
+        using vertex_view = graph_view<graph_type, vertex_iterator>;
+
+        using const_vertex_view = graph_view<const graph_type, const_vertex_iterator>;
+
+        vertex_view all_vertices() {
+            return vertex_view(*this, all_vertices_indices());
+        }
+
+        const_vertex_view all_vertices() const {
+            return const_vertex_view(*this, all_vertices_indices());
+        }
+    };
+
+    /**
+     * Adds the sections describing \p graph to \p writer, so that extra sections may be
+     * stored alongside it.
+     */
+    template<typename t_vertex, typename t_edge, typename t_index>
+    void add_graph_sections(binary_writer& writer, const csr_graph<t_vertex, t_edge, t_index>& graph) {
+        writer.add_section(binary_section_id::VERTICES, graph.vertices());
+        writer.add_section(binary_section_id::OFFSETS, graph.offsets());
+        writer.add_section(binary_section_id::TARGETS, graph.targets());
+        writer.add_section(binary_section_id::EDGES, graph.edges());
+    }
+
+    /**
+     * Saves \p graph into \p path using the grapphs binary format.
+     * @returns false if the file could not be written.
+     */
+    template<typename t_vertex, typename t_edge, typename t_index>
+    bool save_binary(const csr_graph<t_vertex, t_edge, t_index>& graph, const std::filesystem::path& path) {
+        binary_writer writer;
+        add_graph_sections(writer, graph);
+        return writer.write(path);
+    }
+
+    /**
+     * Loads a graph saved by gpp::save_binary into memory.
+     * @throws std::runtime_error if the file is missing, invalid or holds different types.
+     */
+    template<typename t_vertex, typename t_edge, typename t_index = default_graph_index>
+    csr_graph<t_vertex, t_edge, t_index> load_binary(const std::filesystem::path& path) {
+        binary_reader reader(path);
+        return csr_graph<t_vertex, t_edge, t_index>(
+            reader.copy_section<t_vertex>(binary_section_id::VERTICES),
+            reader.copy_section<t_index>(binary_section_id::OFFSETS),
+            reader.copy_section<t_index>(binary_section_id::TARGETS),
+            reader.copy_section<t_edge>(binary_section_id::EDGES)
+        );
+    }
+
+    /**
+     * Memory maps a graph saved by gpp::save_binary without copying or deserializing it.
+     * Pages are only loaded from disk as the graph is accessed.
+     * @throws std::runtime_error if the file is missing, invalid or holds different types.
+     */
+    template<typename t_vertex, typename t_edge, typename t_index = default_graph_index>
+    mapped_graph<t_vertex, t_edge, t_index> map_binary(const std::filesystem::path& path) {
+        return mapped_graph<t_vertex, t_edge, t_index>(binary_reader(path));
+    }
+}
+#endif
@@ -0,0 +1,285 @@
+#ifndef GRAPPHS_CSR_GRAPH_H
+#define GRAPPHS_CSR_GRAPH_H
+
+#include <grapphs/graph.h>
+#include <grapphs/graph_view.h>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gpp {
+
+    /**
+     * Iterable range over the outgoing edges of a single vertex stored in compressed sparse
+     * row form. Dereferencing yields (destination, edge) pairs.
+     */
+    template<typename t_index, typename t_edge>
+    class csr_edge_range {
+    public:
+        using index_type = t_index;
+        using edge_type = t_edge;
+
+        class iterator {
+        private:
+            const index_type* _target;
+            const edge_type* _edge;
+        public:
+            iterator(const index_type* target, const edge_type* edge) : _target(target), _edge(edge) {}
+
+            iterator& operator++() {
+                ++_target;
+                ++_edge;
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const {
+                return _target == other._target;
+            }
+
+            bool operator!=(const iterator& other) const {
+                return !this->operator==(other);
+            }
+
+            std::pair<index_type, const edge_type&> operator*() const {
+                return std::pair<index_type, const edge_type&>(*_target, *_edge);
+            }
+        };
+
+        using const_iterator = iterator;
+
+    private:
+        const index_type* _targets;
+        const edge_type* _edges;
+        std::size_t _count;
+
+    public:
+        csr_edge_range(
+            const index_type* targets,
+            const edge_type* edges,
+            std::size_t count
+        ) : _targets(targets), _edges(edges), _count(count) {}
+
+        iterator begin() const {
+            return iterator(_targets, _edges);
+        }
+
+        iterator end() const {
+            return iterator(_targets + _count, _edges + _count);
+        }
+
+        std::size_t size() const {
+            return _count;
+        }
+
+        bool empty() const {
+            return _count == 0;
+        }
+    };
+
+    /**
+     * Immutable graph stored in compressed sparse row form: the outgoing edges of vertex i
+     * occupy [offsets[i], offsets[i + 1]) in the targets and edges arrays.
+     * Usually created through gpp::graph_builder.
+     */
+    template<typename t_vertex, typename t_edge, typename t_index = default_graph_index>
+    class csr_graph : public graph<t_vertex, t_edge, t_index> {
+    public:
+
+        using vertex_type = typename graph<t_vertex, t_edge, t_index>::vertex_type;
+        using edge_type = typename graph<t_vertex, t_edge, t_index>::edge_type;
+        using index_type = typename graph<t_vertex, t_edge, t_index>::index_type;
+        using graph_type = gpp::csr_graph<t_vertex, t_edge, t_index>;
+        using edge_range = csr_edge_range<index_type, edge_type>;
+
+    private:
+        std::vector<vertex_type> _vertices;
+        std::vector<index_type> _offsets;
+        std::vector<index_type> _targets;
+        std::vector<edge_type> _edges;
+
+    public:
+        csr_graph() : _vertices(), _offsets(1, 0), _targets(), _edges() {}
+
+        csr_graph(
+            std::vector<vertex_type>&& vertices,
+            std::vector<index_type>&& offsets,
+            std::vector<index_type>&& targets,
+            std::vector<edge_type>&& edges
+        ) : _vertices(std::move(vertices)),
+            _offsets(std::move(offsets)),
+            _targets(std::move(targets)),
+            _edges(std::move(edges)) {
+            if (_offsets.size() != _vertices.size() + 1) {
+                throw std::invalid_argument("csr_graph offsets must have one entry per vertex plus one");
+            }
+            if (_targets.size() != _edges.size() || _offsets.back() != _targets.size()) {
+                throw std::invalid_argument("csr_graph targets and edges must match the last offset");
+            }
+        }
+
+        index_type size() const final {
+            return static_cast<index_type>(_vertices.size());
+        }
+
+        bool empty() const final {
+            return _vertices.empty();
+        }
+
+        std::size_t num_edges() const {
+            return _targets.size();
+        }
+
+        index_type degree(index_type index) const {
+            return _offsets[index + 1] - _offsets[index];
+        }
+
+        vertex_type* vertex(index_type index) final {
+            return &_vertices[index];
+        }
+
+        const vertex_type* vertex(index_type index) const final {
+            return &_vertices[index];
+        }
+
+        edge_type* edge(index_type from, index_type to) final {
+            for (index_type i = _offsets[from]; i < _offsets[from + 1]; ++i) {
+                if (_targets[i] == to) {
+                    return &_edges[i];
+                }
+            }
+            return nullptr;
+        }
+
+        const edge_type* edge(index_type from, index_type to) const {
+            return const_cast<csr_graph*>(this)->edge(from, to);
+        }
+
+        /**
+         * Not supported, csr_graph is immutable once built.
+         */
+        void connect(index_type, index_type, edge_type) final {
+            throw std::logic_error("csr_graph is immutable, use gpp::graph_builder instead");
+        }
+
+        /**
+         * Not supported, csr_graph is immutable once built.
+         */
+        bool disconnect(index_type, index_type) final {
+            throw std::logic_error("csr_graph is immutable, use gpp::graph_builder instead");
+        }
+
+        edge_range edges_from(index_type index) const {
+            index_type begin = _offsets[index];
+            return edge_range(
+                _targets.data() + begin,
+                _edges.data() + begin,
+                _offsets[index + 1] - begin
+            );
+        }
+
+        std::vector<index_type> all_vertices_indices() const {
+            std::vector<index_type> indices(_vertices.size());
+            for (index_type i = 0; i < indices.size(); ++i) {
+                indices[i] = i;
+            }
+            return indices;
+        }
+
+        const std::vector<vertex_type>& vertices() const {
+            return _vertices;
+        }
+
+        const std::vector<index_type>& offsets() const {
+            return _offsets;
+        }
+
+        const std::vector<index_type>& targets() const {
+            return _targets;
+        }
+
+        const std::vector<edge_type>& edges() const {
+            return _edges;
+        }
+
+        /**
+         * @returns A copy of this graph with every edge reversed, built with a counting sort in
+         * O(V+E). Its edges_from(v) are the edges pointing to v in this graph, which is what
+         * backward and bidirectional searches need. Sources keep ascending order within each
+         * vertex.
+         */
+        csr_graph transpose() const {
+            index_type numVertices = size();
+            std::vector<index_type> offsets(numVertices + 1, 0);
+            for (index_type to : _targets) {
+                offsets[to + 1]++;
+            }
+            for (index_type i = 0; i < numVertices; ++i) {
+                offsets[i + 1] += offsets[i];
+            }
+            std::vector<index_type> cursor(offsets.begin(), offsets.end() - 1);
+            std::vector<index_type> targets(_targets.size());
+            std::vector<edge_type> edges(_edges.size());
+            for (index_type from = 0; from < numVertices; ++from) {
+                for (index_type i = _offsets[from]; i < _offsets[from + 1]; ++i) {
+                    index_type slot = cursor[_targets[i]]++;
+                    targets[slot] = from;
+                    edges[slot] = _edges[i];
+                }
+            }
+            return csr_graph(
+                std::vector<vertex_type>(_vertices),
+                std::move(offsets),
+                std::move(targets),
+                std::move(edges)
+            );
+        }
+
+        using vertex_view = graph_view<graph_type, vertex_iterator>;
+
+        using const_vertex_view = graph_view<const graph_type, const_vertex_iterator>;
+
+        vertex_view all_vertices() {
+            return vertex_view(*this, all_vertices_indices());
+        }
+
+        const_vertex_view all_vertices() const {
+            return const_vertex_view(*this, all_vertices_indices());
+        }
+    };
+
+    /**
+     * Copies \p graph, whose vertices must be indexed from 0 to size() - 1, into a csr_graph.
+     */
+    template<typename t_graph>
+    csr_graph<
+        typename t_graph::vertex_type,
+        typename t_graph::edge_type,
+        typename t_graph::index_type
+    > to_csr(const t_graph& graph) {
+        using index_type = typename t_graph::index_type;
+        index_type numVertices = graph.size();
+
+        std::vector<typename t_graph::vertex_type> vertices;
+        std::vector<index_type> offsets;
+        std::vector<index_type> targets;
+        std::vector<typename t_graph::edge_type> edges;
+        vertices.reserve(numVertices);
+        offsets.reserve(numVertices + 1);
+        offsets.push_back(0);
+        for (index_type i = 0; i < numVertices; ++i) {
+            vertices.push_back(*graph.vertex(i));
+            for (const auto& [to, edge] : graph.edges_from(i)) {
+                targets.push_back(to);
+                edges.push_back(edge);
+            }
+            offsets.push_back(static_cast<index_type>(targets.size()));
+        }
+        return csr_graph<
+            typename t_graph::vertex_type,
+            typename t_graph::edge_type,
+            index_type
+        >(std::move(vertices), std::move(offsets), std::move(targets), std::move(edges));
+    }
+}
+#endif
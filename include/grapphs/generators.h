@@ -0,0 +1,434 @@
+#ifndef GRAPPHS_GENERATORS_H
+#define GRAPPHS_GENERATORS_H
+
+#include <grapphs/graph_builder.h>
+#include <grapphs/parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace gpp {
+
+    /**
+     * Options of the synthetic graph generators below, which fill a gpp::graph_builder with the
+     * edges of a random graph, from which either a csr_graph or an adjacency_list is then built.
+     *
+     * Every random number is keyed by the seed and by the vertex, edge or cell it is drawn for,
+     * so the same seed yields the same edges whichever thread count generates them. Chunks are
+     * submitted in order, so the graph built is the same every time too.
+     *
+     * Edges are created by an edge factory, invoked concurrently as
+     * \p edgeFactory(from, to, weight). The weight is uniform in [0, 1) for erdos_renyi and
+     * rmat, 1 for grids and the euclidean distance between both ends for geometric graphs.
+     */
+    struct generator_options {
+        std::uint64_t seed = 0;
+        /**
+         * Number of threads generating edges, 0 meaning gpp::default_concurrency().
+         */
+        std::size_t numThreads = 0;
+    };
+
+    /**
+     * Turns the weight into the edge when possible, and default constructs it otherwise.
+     */
+    template<typename t_edge>
+    struct weight_edge_factory {
+        template<typename t_index>
+        t_edge operator()(t_index, t_index, double weight) const {
+            if constexpr (std::is_constructible_v<t_edge, double>) {
+                return static_cast<t_edge>(weight);
+            }
+            else {
+                return t_edge{};
+            }
+        }
+    };
+
+    /**
+     * splitmix64 stream of pseudo random numbers, keyed by a seed and by the index of the item
+     * it is drawn for.
+     */
+    class generator_random {
+    private:
+        static constexpr std::uint64_t k_golden_gamma = 0x9E3779B97F4A7C15ULL;
+
+        std::uint64_t _state;
+
+        static std::uint64_t mix(std::uint64_t x) {
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+
+    public:
+        generator_random(std::uint64_t seed, std::uint64_t stream)
+            : _state(mix(seed + k_golden_gamma) ^ mix(stream * k_golden_gamma + 1)) {
+        }
+
+        std::uint64_t next() {
+            _state += k_golden_gamma;
+            return mix(_state);
+        }
+
+        /**
+         * @returns A number uniformly distributed in [0, 1).
+         */
+        double next_unit() {
+            return static_cast<double>(next() >> 11) * 0x1.0p-53;
+        }
+    };
+
+    /**
+     * Parameters of the recursive matrix (R-MAT) model: the probabilities of an edge falling
+     * in the top left, top right and bottom left quadrants of the adjacency matrix at each level
+     * of recursion, the bottom right one taking the rest. The defaults are those of Graph500.
+     */
+    struct rmat_parameters {
+        double a = 0.57;
+        double b = 0.19;
+        double c = 0.19;
+        /**
+         * Whether vertex indices are shuffled, so that the highest degrees don't all land on
+         * the lowest indices.
+         */
+        bool scramble = true;
+    };
+
+    /**
+     * Dimensions of a grid graph, in cells. Cells are indexed row by row, then layer by layer.
+     */
+    struct grid_size {
+        std::size_t width = 1;
+        std::size_t height = 1;
+        std::size_t depth = 1;
+
+        std::size_t size() const {
+            return width * height * depth;
+        }
+
+        std::size_t index_of(std::size_t x, std::size_t y, std::size_t z = 0) const {
+            return x + width * (y + height * z);
+        }
+    };
+
+    /**
+     * Position of a vertex of a random geometric graph, within the unit square.
+     */
+    struct generated_point {
+        float x;
+        float y;
+    };
+
+    namespace detail {
+
+        /**
+         * Minimum edges generated per chunk, see gpp::k_default_parallel_grain.
+         */
+        constexpr std::size_t k_generator_grain = 1 << 14;
+
+        /**
+         * Invokes \p generate(begin, end, edges) over chunks of [0, count), in parallel,
+         * submitting each chunk's edges to \p builder.
+         */
+        template<typename t_edge, typename t_index, typename t_generate>
+        void generate_chunks(
+            graph_builder<t_edge, t_index>& builder,
+            std::size_t count,
+            std::size_t grain,
+            const generator_options& options,
+            const t_generate& generate
+        ) {
+            parallel_for(
+                std::size_t(0), count, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    typename graph_builder<t_edge, t_index>::batch edges;
+                    generate(begin, end, edges);
+                    // Chunks are contiguous, so ordering batches by their start keeps the
+                    // graph the same whatever the number of threads
+                    builder.submit(std::move(edges), begin);
+                }, options.numThreads, std::max<std::size_t>(grain, 1)
+            );
+        }
+
+        template<typename t_index>
+        void check_index_range(std::size_t numVertices) {
+            if (numVertices > static_cast<std::size_t>(std::numeric_limits<t_index>::max())) {
+                throw std::invalid_argument("generated graph has more vertices than its index type can address");
+            }
+        }
+
+        /**
+         * Bijection of [0, 2^scale) mixing the bits of \p value.
+         */
+        inline std::uint64_t scramble(std::uint64_t value, unsigned scale, std::uint64_t key) {
+            std::uint64_t mask = scale >= 64 ? ~0ULL : (1ULL << scale) - 1;
+            unsigned shift = std::max(1U, (scale + 1) / 2);
+            for (std::uint64_t round = 0; round < 2; ++round) {
+                value = (value * 0xD6E8FEB86659FD93ULL + (key >> (round * 32))) & mask;
+                value ^= value >> shift;
+            }
+            return value;
+        }
+    }
+
+    /**
+     * Generates a directed G(n, p) Erdős–Rényi graph, where each of the
+     * \p numVertices * (\p numVertices - 1) possible edges exists with \p probability. Absent
+     * edges are skipped over geometrically, so this takes time proportional to the number of
+     * edges rather than to the number of pairs.
+     * @returns The number of vertices.
+     * @throws std::invalid_argument if \p probability is not within [0, 1].
+     */
+    template<typename t_edge, typename t_index, typename t_edge_factory = weight_edge_factory<t_edge>>
+    std::size_t generate_erdos_renyi(
+        graph_builder<t_edge, t_index>& builder,
+        std::size_t numVertices,
+        double probability,
+        const generator_options& options = {},
+        const t_edge_factory& edgeFactory = t_edge_factory()
+    ) {
+        if (!(probability >= 0 && probability <= 1)) {
+            throw std::invalid_argument("edge probability must be within [0, 1]");
+        }
+        detail::check_index_range<t_index>(numVertices);
+        if (numVertices < 2 || probability == 0) {
+            return numVertices;
+        }
+        double expectedDegree = probability * static_cast<double>(numVertices - 1);
+        double logMiss = std::log1p(-probability);
+        std::size_t grain = static_cast<std::size_t>(detail::k_generator_grain / std::max(expectedDegree, 1.0));
+        detail::generate_chunks(
+            builder, numVertices, grain, options, [&](std::size_t begin, std::size_t end, auto& edges) {
+                edges.reserve(static_cast<std::size_t>(expectedDegree * static_cast<double>(end - begin) * 1.1));
+                for (std::size_t from = begin; from < end; ++from) {
+                    generator_random random(options.seed, from);
+                    // Walks the numVertices - 1 other vertices, skipping from itself
+                    double candidate = -1;
+                    while (true) {
+                        double skip = probability == 1 ? 0 : std::floor(std::log1p(-random.next_unit()) / logMiss);
+                        candidate += 1 + skip;
+                        if (candidate >= static_cast<double>(numVertices - 1)) {
+                            break;
+                        }
+                        auto to = static_cast<std::size_t>(candidate);
+                        to += to >= from ? 1 : 0;
+                        edges.add(
+                            static_cast<t_index>(from),
+                            static_cast<t_index>(to),
+                            edgeFactory(static_cast<t_index>(from), static_cast<t_index>(to), random.next_unit())
+                        );
+                    }
+                }
+            }
+        );
+        return numVertices;
+    }
+
+    /**
+     * Generates a directed R-MAT (Kronecker) graph of 2^\p scale vertices and \p numEdges
+     * edges, each placed by recursively picking a quadrant of the adjacency matrix, which
+     * yields the skewed degrees of social and web graphs. Self loops and duplicate edges are
+     * kept, see graph_builder::set_remove_self_loops and graph_builder::set_deduplicate.
+     * @returns The number of vertices.
+     * @throws std::invalid_argument if the probabilities are negative or add up to more than 1,
+     * or if t_index can't address every vertex.
+     */
+    template<typename t_edge, typename t_index, typename t_edge_factory = weight_edge_factory<t_edge>>
+    std::size_t generate_rmat(
+        graph_builder<t_edge, t_index>& builder,
+        unsigned scale,
+        std::size_t numEdges,
+        const rmat_parameters& parameters = {},
+        const generator_options& options = {},
+        const t_edge_factory& edgeFactory = t_edge_factory()
+    ) {
+        double ab = parameters.a + parameters.b;
+        double abc = ab + parameters.c;
+        if (parameters.a < 0 || parameters.b < 0 || parameters.c < 0 || abc > 1) {
+            throw std::invalid_argument("R-MAT probabilities must be positive and add up to at most 1");
+        }
+        if (scale >= std::numeric_limits<std::size_t>::digits) {
+            throw std::invalid_argument("R-MAT scale is too large");
+        }
+        std::size_t numVertices = std::size_t(1) << scale;
+        detail::check_index_range<t_index>(numVertices - 1);
+        std::uint64_t key = generator_random(options.seed, ~0ULL).next();
+        // Quadrants are picked by comparing 32 bit random numbers against these thresholds,
+        // without branching, two levels per random draw
+        auto threshold = [](double probability) {
+            return static_cast<std::uint64_t>(std::min(probability, 1.0) * 0x1.0p32);
+        };
+        std::uint64_t aThreshold = threshold(parameters.a);
+        std::uint64_t abThreshold = threshold(ab);
+        std::uint64_t abcThreshold = threshold(abc);
+        detail::generate_chunks(
+            builder, numEdges, detail::k_generator_grain, options, [&](std::size_t begin, std::size_t end, auto& edges) {
+                edges.reserve(end - begin);
+                for (std::size_t i = begin; i < end; ++i) {
+                    generator_random random(options.seed, i);
+                    std::uint64_t from = 0;
+                    std::uint64_t to = 0;
+                    std::uint64_t bits = 0;
+                    for (unsigned level = 0; level < scale; ++level) {
+                        if (level % 2 == 0) {
+                            bits = random.next();
+                        }
+                        std::uint64_t r = (bits >> (level % 2 * 32)) & 0xFFFFFFFFULL;
+                        std::uint64_t isBottom = r >= abThreshold;
+                        from = from << 1 | isBottom;
+                        to = to << 1 | ((r >= aThreshold) ^ isBottom ^ (r >= abcThreshold));
+                    }
+                    if (parameters.scramble) {
+                        from = detail::scramble(from, scale, key);
+                        to = detail::scramble(to, scale, key);
+                    }
+                    edges.add(
+                        static_cast<t_index>(from),
+                        static_cast<t_index>(to),
+                        edgeFactory(static_cast<t_index>(from), static_cast<t_index>(to), random.next_unit())
+                    );
+                }
+            }
+        );
+        return numVertices;
+    }
+
+    /**
+     * Generates a 2D (depth of 1) or 3D grid, where each cell is connected both ways to its
+     * neighbours along every axis, unless a wall stands in between, which happens with
+     * \p wallProbability. Walls may leave some cells unreachable.
+     * @returns The number of vertices, grid_size::size().
+     */
+    template<typename t_edge, typename t_index, typename t_edge_factory = weight_edge_factory<t_edge>>
+    std::size_t generate_grid(
+        graph_builder<t_edge, t_index>& builder,
+        const grid_size& size,
+        double wallProbability = 0,
+        const generator_options& options = {},
+        const t_edge_factory& edgeFactory = t_edge_factory()
+    ) {
+        std::size_t numVertices = size.size();
+        detail::check_index_range<t_index>(numVertices);
+        const std::size_t dimensions[3] = {size.width, size.height, size.depth};
+        const std::size_t strides[3] = {1, size.width, size.width * size.height};
+        auto isOpen = [&](std::size_t lower, std::size_t axis) {
+            return wallProbability <= 0 || generator_random(options.seed, lower * 3 + axis).next_unit() >= wallProbability;
+        };
+        detail::generate_chunks(
+            builder, numVertices, detail::k_generator_grain / 6, options, [&](std::size_t begin, std::size_t end, auto& edges) {
+                edges.reserve((end - begin) * 6);
+                for (std::size_t from = begin; from < end; ++from) {
+                    for (std::size_t axis = 0; axis < 3; ++axis) {
+                        std::size_t coordinate = from / strides[axis] % dimensions[axis];
+                        if (coordinate > 0 && isOpen(from - strides[axis], axis)) {
+                            auto to = static_cast<t_index>(from - strides[axis]);
+                            edges.add(static_cast<t_index>(from), to, edgeFactory(static_cast<t_index>(from), to, 1.0));
+                        }
+                        if (coordinate + 1 < dimensions[axis] && isOpen(from, axis)) {
+                            auto to = static_cast<t_index>(from + strides[axis]);
+                            edges.add(static_cast<t_index>(from), to, edgeFactory(static_cast<t_index>(from), to, 1.0));
+                        }
+                    }
+                }
+            }
+        );
+        return numVertices;
+    }
+
+    /**
+     * Generates a random geometric graph: \p numVertices points scattered uniformly over the
+     * unit square, each connected both ways to every point closer than the radius giving
+     * roughly \p averageDegree neighbours per vertex. An average degree of 3 to 6 resembles
+     * the sparse, planar-ish and large diameter road networks.
+     * @returns The position of every vertex, e.g. for A* heuristics.
+     */
+    template<typename t_edge, typename t_index, typename t_edge_factory = weight_edge_factory<t_edge>>
+    std::vector<generated_point> generate_geometric(
+        graph_builder<t_edge, t_index>& builder,
+        std::size_t numVertices,
+        double averageDegree,
+        const generator_options& options = {},
+        const t_edge_factory& edgeFactory = t_edge_factory()
+    ) {
+        detail::check_index_range<t_index>(numVertices);
+        std::vector<generated_point> points(numVertices);
+        if (numVertices == 0) {
+            return points;
+        }
+        parallel_for(
+            std::size_t(0), numVertices, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    generator_random random(options.seed, i);
+                    points[i].x = static_cast<float>(random.next_unit());
+                    points[i].y = static_cast<float>(random.next_unit());
+                }
+            }, options.numThreads
+        );
+
+        // Buckets points into square cells at least as wide as the radius, so that every
+        // neighbour lies within the 3x3 cells around a point
+        const double pi = std::acos(-1.0);
+        double radius = std::sqrt(std::max(averageDegree, 0.0) / (pi * static_cast<double>(numVertices)));
+        double maxCells = std::max(1.0, std::floor(std::sqrt(static_cast<double>(numVertices))));
+        auto cellsPerSide = static_cast<std::size_t>(radius > 0 ? std::clamp(std::floor(1 / radius), 1.0, maxCells) : 1.0);
+        auto cellOf = [&](float coordinate) {
+            return std::min(static_cast<std::size_t>(coordinate * static_cast<float>(cellsPerSide)), cellsPerSide - 1);
+        };
+        std::vector<std::size_t> cellStarts(cellsPerSide * cellsPerSide + 1, 0);
+        for (const generated_point& point : points) {
+            ++cellStarts[cellOf(point.y) * cellsPerSide + cellOf(point.x) + 1];
+        }
+        for (std::size_t cell = 1; cell < cellStarts.size(); ++cell) {
+            cellStarts[cell] += cellStarts[cell - 1];
+        }
+        // Points sorted by cell, along with their indices, so that neighbours are read from
+        // a few contiguous ranges
+        std::vector<t_index> cellIndices(numVertices);
+        std::vector<generated_point> cellPoints(numVertices);
+        {
+            std::vector<std::size_t> positions(cellStarts.begin(), cellStarts.end() - 1);
+            for (std::size_t i = 0; i < numVertices; ++i) {
+                const generated_point& point = points[i];
+                std::size_t position = positions[cellOf(point.y) * cellsPerSide + cellOf(point.x)]++;
+                cellIndices[position] = static_cast<t_index>(i);
+                cellPoints[position] = point;
+            }
+        }
+
+        auto radiusSquared = static_cast<float>(radius * radius);
+        std::size_t grain = static_cast<std::size_t>(detail::k_generator_grain / std::max(averageDegree, 1.0));
+        detail::generate_chunks(
+            builder, numVertices, grain, options, [&](std::size_t begin, std::size_t end, auto& edges) {
+                edges.reserve(static_cast<std::size_t>(averageDegree * static_cast<double>(end - begin) * 1.1));
+                for (std::size_t position = begin; position < end; ++position) {
+                    t_index from = cellIndices[position];
+                    const generated_point& point = cellPoints[position];
+                    std::size_t cellX = cellOf(point.x);
+                    std::size_t cellY = cellOf(point.y);
+                    for (std::size_t y = cellY == 0 ? 0 : cellY - 1; y <= std::min(cellY + 1, cellsPerSide - 1); ++y) {
+                        for (std::size_t x = cellX == 0 ? 0 : cellX - 1; x <= std::min(cellX + 1, cellsPerSide - 1); ++x) {
+                            std::size_t cell = y * cellsPerSide + x;
+                            for (std::size_t i = cellStarts[cell]; i < cellStarts[cell + 1]; ++i) {
+                                t_index to = cellIndices[i];
+                                float dx = cellPoints[i].x - point.x;
+                                float dy = cellPoints[i].y - point.y;
+                                float distanceSquared = dx * dx + dy * dy;
+                                if (to == from || distanceSquared > radiusSquared) {
+                                    continue;
+                                }
+                                edges.add(from, to, edgeFactory(from, to, std::sqrt(static_cast<double>(distanceSquared))));
+                            }
+                        }
+                    }
+                }
+            }
+        );
+        return points;
+    }
+}
+#endif
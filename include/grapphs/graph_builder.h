@@ -0,0 +1,435 @@
+#ifndef GRAPPHS_GRAPH_BUILDER_H
+#define GRAPPHS_GRAPH_BUILDER_H
+
+#include <grapphs/graph.h>
+#include <grapphs/adjacency_list.h>
+#include <grapphs/csr_graph.h>
+#include <grapphs/parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gpp {
+
+    /**
+     * Accumulates (from, to, edge) tuples and turns them into a graph in a single pass, using a
+     * parallel counting sort by source vertex instead of one connect() call per edge.
+     *
+     * Edges may be added directly through add() by a single thread, or collected by any number
+     * of threads into their own gpp::graph_builder::batch and handed over through submit().
+     *
+     * Edges leaving the same vertex keep the order they were added in, whatever the number of
+     * threads building: batches come in order of their sequence (see submit), then of
+     * submission, followed by the edges passed to add(). Concurrent producers that need the
+     * same graph on every run should thus submit their batches with a sequence.
+     */
+    template<typename t_edge, typename t_index = default_graph_index>
+    class graph_builder {
+    public:
+        using edge_type = t_edge;
+        using index_type = t_index;
+
+        struct entry {
+            index_type from;
+            index_type to;
+            edge_type edge;
+        };
+
+        /**
+         * Thread local list of edges, meant to be filled without synchronization and then
+         * moved into the builder through submit().
+         */
+        class batch {
+        private:
+            std::vector<entry> _entries;
+
+        public:
+            batch() = default;
+
+            void reserve(std::size_t count) {
+                _entries.reserve(count);
+            }
+
+            void add(index_type from, index_type to, const edge_type& edge) {
+                _entries.push_back(entry{from, to, edge});
+            }
+
+            void add(index_type from, index_type to, edge_type&& edge) {
+                _entries.push_back(entry{from, to, std::move(edge)});
+            }
+
+            std::size_t size() const {
+                return _entries.size();
+            }
+
+            bool empty() const {
+                return _entries.empty();
+            }
+
+            void clear() {
+                _entries.clear();
+            }
+
+            friend class graph_builder;
+        };
+
+    private:
+        struct sorted_edges {
+            std::vector<index_type> offsets;
+            std::vector<index_type> targets;
+            std::vector<edge_type> edges;
+        };
+
+        /**
+         * Sequence of the edges passed to add(), which come after every batch.
+         */
+        static constexpr std::size_t k_local_sequence = std::numeric_limits<std::size_t>::max();
+
+        std::mutex _mutex;
+        std::vector<std::vector<entry>> _batches;
+        std::vector<std::size_t> _batchSequences;
+        std::vector<std::size_t> _batchStarts;
+        batch _local;
+        std::size_t _numThreads = 0;
+        bool _removeSelfLoops = false;
+        bool _deduplicate = false;
+        bool _sortTargets = false;
+
+        template<typename t_block>
+        void for_each_entry(std::size_t begin, std::size_t end, const t_block& block) {
+            auto found = std::upper_bound(_batchStarts.begin(), _batchStarts.end(), begin);
+            std::size_t batchIndex = static_cast<std::size_t>(found - _batchStarts.begin()) - 1;
+            std::size_t i = begin - _batchStarts[batchIndex];
+            for (std::size_t position = begin; position < end; ++position) {
+                while (i >= _batches[batchIndex].size()) {
+                    ++batchIndex;
+                    i = 0;
+                }
+                block(_batches[batchIndex][i++], position);
+            }
+        }
+
+        bool is_skipped(const entry& e) const {
+            return _removeSelfLoops && e.from == e.to;
+        }
+
+        /**
+         * Moves the edges passed to add() into a batch of their own, and orders batches by
+         * sequence, keeping submission order among equal sequences.
+         */
+        void order_batches() {
+            if (!_local.empty()) {
+                _batches.push_back(std::move(_local._entries));
+                _batchSequences.push_back(k_local_sequence);
+                _local.clear();
+            }
+            std::vector<std::size_t> order(_batches.size());
+            std::iota(order.begin(), order.end(), std::size_t(0));
+            std::stable_sort(
+                order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+                    return _batchSequences[a] < _batchSequences[b];
+                }
+            );
+            std::vector<std::vector<entry>> batches;
+            batches.reserve(_batches.size());
+            for (std::size_t i : order) {
+                batches.push_back(std::move(_batches[i]));
+            }
+            _batches = std::move(batches);
+            _batchSequences.clear();
+        }
+
+        sorted_edges sort_by_source(index_type numVertices) {
+            order_batches();
+            _batchStarts.assign(1, 0);
+            for (const std::vector<entry>& entries : _batches) {
+                _batchStarts.push_back(_batchStarts.back() + entries.size());
+            }
+            std::size_t total = _batchStarts.back();
+
+            std::unique_ptr<std::atomic<index_type>[]> counts(new std::atomic<index_type>[numVertices]());
+            std::atomic<bool> outOfRange(false);
+
+            parallel_for(
+                std::size_t(0), total, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for_each_entry(
+                        begin, end, [&](const entry& e, std::size_t) {
+                            if (e.from >= numVertices || e.to >= numVertices) {
+                                outOfRange.store(true, std::memory_order_relaxed);
+                                return;
+                            }
+                            if (!is_skipped(e)) {
+                                counts[e.from].fetch_add(1, std::memory_order_relaxed);
+                            }
+                        }
+                    );
+                }, _numThreads
+            );
+
+            if (outOfRange.load()) {
+                clear();
+                throw std::out_of_range("graph_builder received an edge referencing a missing vertex");
+            }
+
+            sorted_edges sorted;
+            sorted.offsets.resize(static_cast<std::size_t>(numVertices) + 1);
+            sorted.offsets[0] = 0;
+            for (index_type i = 0; i < numVertices; ++i) {
+                index_type count = counts[i].load(std::memory_order_relaxed);
+                sorted.offsets[i + 1] = sorted.offsets[i] + count;
+                counts[i].store(sorted.offsets[i], std::memory_order_relaxed);
+            }
+
+            std::size_t numEdges = sorted.offsets.back();
+            sorted.targets.resize(numEdges);
+            sorted.edges.resize(numEdges);
+
+            // Chunks scatter concurrently, so edges of the same vertex land in any order. Their
+            // input position is recorded to restore it afterwards.
+            std::vector<index_type> sequence;
+            if (num_chunks(total, _numThreads) > 1) {
+                sequence.resize(numEdges);
+            }
+            parallel_for(
+                std::size_t(0), total, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for_each_entry(
+                        begin, end, [&](entry& e, std::size_t input) {
+                            if (is_skipped(e)) {
+                                return;
+                            }
+                            index_type position = counts[e.from].fetch_add(1, std::memory_order_relaxed);
+                            sorted.targets[position] = e.to;
+                            sorted.edges[position] = std::move(e.edge);
+                            if (!sequence.empty()) {
+                                sequence[position] = static_cast<index_type>(input);
+                            }
+                        }
+                    );
+                }, _numThreads
+            );
+            counts.reset();
+            clear();
+
+            order_targets(sorted, numVertices, sequence);
+            return sorted;
+        }
+
+        /**
+         * Puts the edges of every vertex back in input order, given the input position of each
+         * one in \p sequence, or sorts them by target, then input order, when required. Drops
+         * duplicates, all but the first one added, when deduplicating.
+         * @param sequence Empty if edges are already in input order.
+         */
+        void order_targets(sorted_edges& sorted, index_type numVertices, const std::vector<index_type>& sequence) {
+            bool byTarget = _sortTargets || _deduplicate;
+            if (!byTarget && sequence.empty()) {
+                return;
+            }
+            struct ordered_edge {
+                index_type target;
+                index_type sequence;
+                edge_type edge;
+            };
+            std::vector<index_type> degrees(numVertices);
+            parallel_for(
+                index_type(0), numVertices, [&](index_type begin, index_type end, std::size_t) {
+                    std::vector<ordered_edge> scratch;
+                    for (index_type vertex = begin; vertex < end; ++vertex) {
+                        index_type first = sorted.offsets[vertex];
+                        index_type last = sorted.offsets[vertex + 1];
+                        scratch.clear();
+                        for (index_type i = first; i < last; ++i) {
+                            scratch.push_back(
+                                ordered_edge{sorted.targets[i], sequence.empty() ? i : sequence[i], std::move(sorted.edges[i])}
+                            );
+                        }
+                        // Sequences are unique, so any sort yields the same order
+                        std::sort(
+                            scratch.begin(), scratch.end(), [byTarget](const ordered_edge& a, const ordered_edge& b) {
+                                if (byTarget && a.target != b.target) {
+                                    return a.target < b.target;
+                                }
+                                return a.sequence < b.sequence;
+                            }
+                        );
+                        if (_deduplicate) {
+                            auto sameTarget = [](const ordered_edge& a, const ordered_edge& b) { return a.target == b.target; };
+                            scratch.erase(std::unique(scratch.begin(), scratch.end(), sameTarget), scratch.end());
+                        }
+                        for (std::size_t i = 0; i < scratch.size(); ++i) {
+                            sorted.targets[first + i] = scratch[i].target;
+                            sorted.edges[first + i] = std::move(scratch[i].edge);
+                        }
+                        degrees[vertex] = static_cast<index_type>(scratch.size());
+                    }
+                }, _numThreads
+            );
+
+            if (!_deduplicate) {
+                return;
+            }
+
+            std::vector<index_type> offsets(sorted.offsets.size());
+            offsets[0] = 0;
+            for (index_type i = 0; i < numVertices; ++i) {
+                offsets[i + 1] = offsets[i] + degrees[i];
+            }
+            if (offsets.back() == sorted.offsets.back()) {
+                return;
+            }
+
+            std::vector<index_type> targets(offsets.back());
+            std::vector<edge_type> edges(offsets.back());
+            parallel_for(
+                index_type(0), numVertices, [&](index_type begin, index_type end, std::size_t) {
+                    for (index_type vertex = begin; vertex < end; ++vertex) {
+                        index_type from = sorted.offsets[vertex];
+                        index_type to = offsets[vertex];
+                        for (index_type i = 0; i < degrees[vertex]; ++i) {
+                            targets[to + i] = sorted.targets[from + i];
+                            edges[to + i] = std::move(sorted.edges[from + i]);
+                        }
+                    }
+                }, _numThreads
+            );
+            sorted.offsets = std::move(offsets);
+            sorted.targets = std::move(targets);
+            sorted.edges = std::move(edges);
+        }
+
+    public:
+        graph_builder() = default;
+
+        /**
+         * Number of threads used while building, 0 meaning gpp::default_concurrency().
+         */
+        void set_num_threads(std::size_t numThreads) {
+            _numThreads = numThreads;
+        }
+
+        /**
+         * Drops edges whose origin and destination are the same vertex.
+         */
+        void set_remove_self_loops(bool removeSelfLoops) {
+            _removeSelfLoops = removeSelfLoops;
+        }
+
+        /**
+         * Keeps a single edge for every (from, to) pair, the first one added, see graph_builder
+         * for the order of edges. Implies sorted targets.
+         */
+        void set_deduplicate(bool deduplicate) {
+            _deduplicate = deduplicate;
+        }
+
+        /**
+         * Sorts the edges leaving each vertex by destination index.
+         */
+        void set_sort_targets(bool sortTargets) {
+            _sortTargets = sortTargets;
+        }
+
+        void reserve(std::size_t numEdges) {
+            _local.reserve(numEdges);
+        }
+
+        /**
+         * Adds a single edge. Not thread safe, concurrent producers should use submit() instead.
+         */
+        void add(index_type from, index_type to, const edge_type& edge) {
+            _local.add(from, to, edge);
+        }
+
+        void add(index_type from, index_type to, edge_type&& edge) {
+            _local.add(from, to, std::move(edge));
+        }
+
+        /**
+         * Hands over all the edges in \p edges to this builder. Thread safe.
+         * @param sequence Where the batch goes among the others when building, e.g. the index
+         * of the chunk of input it was read from. Batches of equal sequence are kept in
+         * submission order.
+         */
+        void submit(batch&& edges, std::size_t sequence = 0) {
+            if (edges.empty()) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            _batches.push_back(std::move(edges._entries));
+            _batchSequences.push_back(sequence);
+            edges.clear();
+        }
+
+        /**
+         * @returns The number of edges currently held, before self loop removal and deduplication.
+         */
+        std::size_t num_edges() const {
+            std::size_t count = _local.size();
+            for (const std::vector<entry>& entries : _batches) {
+                count += entries.size();
+            }
+            return count;
+        }
+
+        void clear() {
+            _batches.clear();
+            _batchSequences.clear();
+            _batchStarts.clear();
+            _local.clear();
+        }
+
+        /**
+         * Builds a gpp::csr_graph holding \p vertices and every edge added so far, which are
+         * consumed in the process.
+         * @throws std::out_of_range if an edge references an index outside of \p vertices.
+         */
+        template<typename t_vertex>
+        csr_graph<t_vertex, edge_type, index_type> build_csr(std::vector<t_vertex> vertices) {
+            sorted_edges sorted = sort_by_source(static_cast<index_type>(vertices.size()));
+            return csr_graph<t_vertex, edge_type, index_type>(
+                std::move(vertices),
+                std::move(sorted.offsets),
+                std::move(sorted.targets),
+                std::move(sorted.edges)
+            );
+        }
+
+        /**
+         * Connects every edge added so far into \p graph, whose vertices must already have
+         * been pushed. Each vertex has its connections reserved up front and vertices are
+         * filled in parallel, see adjacency_list::allocating_threads. Edges are consumed in the process, and the incoming index of
+         * \p graph, if enabled, is rebuilt afterwards.
+         * @throws std::out_of_range if an edge references an index that was never pushed.
+         */
+        template<typename t_vertex, typename t_allocator>
+        void build_into(adjacency_list<t_vertex, edge_type, index_type, t_allocator>& graph) {
+            index_type numVertices = graph.index_bound();
+            sorted_edges sorted = sort_by_source(numVertices);
+            parallel_for(
+                index_type(0), numVertices, [&](index_type begin, index_type end, std::size_t) {
+                    for (index_type vertex = begin; vertex < end; ++vertex) {
+                        index_type first = sorted.offsets[vertex];
+                        index_type last = sorted.offsets[vertex + 1];
+                        if (first == last) {
+                            continue;
+                        }
+                        auto& node = graph.node(vertex);
+                        node.reserve(node.connections().size() + (last - first));
+                        for (index_type i = first; i < last; ++i) {
+                            node.connect(sorted.targets[i], sorted.edges[i]);
+                        }
+                    }
+                }, graph.allocating_threads(_numThreads)
+            );
+            graph.rebuild_incoming_index();
+        }
+    };
+}
+#endif
@@ -2,24 +2,41 @@
 #define GRAPPHS_GRAPH_VIEW_H
 #include <vector>
 #include <cstdint>
+#include <memory>
+#include <utility>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
 namespace gpp {
 
 
-    template<typename t_graph, template<typename> typename t_iterator>
+    /**
+     * Iterable selection of the vertices of a graph, whose indices are allocated through
+     * \p t_allocator.
+     */
+    template<
+        typename t_graph,
+        template<typename> typename t_iterator,
+        typename t_allocator = std::allocator<typename t_graph::index_type>
+    >
     class graph_view {
     public:
         using graph_type = t_graph;
         using index_type = typename graph_type::index_type;
-        using iterator_type = t_iterator<graph_view<t_graph, t_iterator>>;
+        using allocator_type = t_allocator;
+        using index_vector = std::vector<index_type, typename std::allocator_traits<allocator_type>::template rebind_alloc<index_type>>;
+        using iterator_type = t_iterator<graph_view<t_graph, t_iterator, t_allocator>>;
     private:
         graph_type& _graph;
-        std::vector<index_type> _indices;
+        index_vector _indices;
 
     public:
         graph_view(
             graph_type& graph,
-            const std::vector<index_type>& indices
-        ) : _graph(graph), _indices(indices) {}
+            index_vector indices
+        ) : _graph(graph), _indices(std::move(indices)) {}
 
         iterator_type begin() {
             return iterator_type(*this, 0);
@@ -103,5 +120,20 @@ namespace gpp {
             return std::pair<index_type, const vertex_type*>(vertexIndex, vertex);
         }
     };
+
+#if __has_include(<memory_resource>)
+    namespace pmr {
+
+        /**
+         * graph_view allocating its indices from a std::pmr::memory_resource.
+         */
+        template<typename t_graph, template<typename> typename t_iterator>
+        using graph_view = gpp::graph_view<
+            t_graph,
+            t_iterator,
+            std::pmr::polymorphic_allocator<typename t_graph::index_type>
+        >;
+    }
+#endif
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,139 @@
+#ifndef GRAPPHS_MAPPED_FILE_H
+#define GRAPPHS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif
+
+namespace gpp {
+
+    /**
+     * Read only view of a whole file, memory mapped where the platform allows it and read
+     * into memory otherwise. Pages are mapped read only, so the file costs no commit charge
+     * and is shared with the page cache.
+     */
+    class mapped_file {
+    private:
+        const char* _data = nullptr;
+        std::size_t _size = 0;
+#ifdef _WIN32
+        std::vector<char> _fallback;
+#endif
+
+        void release() {
+#ifndef _WIN32
+            if (_data != nullptr && _size > 0) {
+                munmap(const_cast<char*>(_data), _size);
+            }
+#endif
+            _data = nullptr;
+            _size = 0;
+        }
+
+        static std::runtime_error open_error(const std::filesystem::path& path, const char* what) {
+            return std::runtime_error("unable to " + std::string(what) + " '" + path.string() + "'");
+        }
+
+    public:
+        mapped_file() = default;
+
+        /**
+         * @throws std::runtime_error if the file can't be opened or mapped.
+         */
+        explicit mapped_file(const std::filesystem::path& path) {
+#ifndef _WIN32
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw open_error(path, "open");
+            }
+            struct stat info{};
+            if (fstat(fd, &info) != 0) {
+                ::close(fd);
+                throw open_error(path, "stat");
+            }
+            _size = static_cast<std::size_t>(info.st_size);
+            if (_size > 0) {
+                void* mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping == MAP_FAILED) {
+                    ::close(fd);
+                    _size = 0;
+                    throw open_error(path, "map");
+                }
+                _data = static_cast<const char*>(mapping);
+            }
+            ::close(fd);
+#else
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file.is_open()) {
+                throw open_error(path, "open");
+            }
+            _fallback.resize(static_cast<std::size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(_fallback.data(), static_cast<std::streamsize>(_fallback.size()));
+            _data = _fallback.data();
+            _size = _fallback.size();
+#endif
+        }
+
+        mapped_file(const mapped_file&) = delete;
+
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& other) noexcept {
+            *this = std::move(other);
+        }
+
+        mapped_file& operator=(mapped_file&& other) noexcept {
+            if (this != &other) {
+                release();
+#ifdef _WIN32
+                _fallback = std::move(other._fallback);
+#endif
+                _data = std::exchange(other._data, nullptr);
+                _size = std::exchange(other._size, 0);
+            }
+            return *this;
+        }
+
+        ~mapped_file() {
+            release();
+        }
+
+        /**
+         * Hints the kernel that the file will be read front to back.
+         */
+        void advise_sequential() const {
+#ifndef _WIN32
+            if (_data != nullptr) {
+                madvise(const_cast<char*>(_data), _size, MADV_SEQUENTIAL);
+            }
+#endif
+        }
+
+        const char* data() const {
+            return _data;
+        }
+
+        std::size_t size() const {
+            return _size;
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+    };
+}
+#endif
@@ -0,0 +1,352 @@
+#ifndef GRAPPHS_OUTPUT_BUFFER_H
+#define GRAPPHS_OUTPUT_BUFFER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#endif
+
+namespace gpp {
+
+    /**
+     * Formats text into a large reusable buffer and hands it to its sink in big chunks, as
+     * opposed to one small formatted write per value through std::ostream. Numbers are
+     * formatted with std::to_chars, so the output does not depend on the stream's locale.
+     *
+     * The sink is either a std::ostream, a file which is memory mapped and written in place
+     * where the platform allows it, or nothing at all, in which case the output accumulates
+     * in memory, see view(). Whatever is pending is written on flush(), close() and
+     * destruction.
+     */
+    class output_buffer {
+    public:
+        static constexpr std::size_t k_default_capacity = 1 << 20;
+
+    private:
+        /**
+         * Enough for any integer or any float with the precisions used in practice.
+         */
+        static constexpr std::size_t k_max_number_length = 64;
+
+        std::ostream* _stream = nullptr;
+        std::unique_ptr<std::ofstream> _ownedStream;
+        std::vector<char> _storage;
+        char* _begin = nullptr;
+        char* _cursor = nullptr;
+        char* _end = nullptr;
+        std::size_t _flushed = 0;
+#ifndef _WIN32
+        int _fd = -1;
+#endif
+
+        static std::runtime_error file_error(const std::filesystem::path& path, const char* what) {
+            return std::runtime_error("unable to " + std::string(what) + " '" + path.string() + "'");
+        }
+
+        bool is_mapped() const {
+#ifndef _WIN32
+            return _fd >= 0;
+#else
+            return false;
+#endif
+        }
+
+        void use_storage(std::size_t capacity) {
+            _storage.resize(std::max<std::size_t>(capacity, k_max_number_length));
+            _begin = _cursor = _storage.data();
+            _end = _begin + _storage.size();
+        }
+
+#ifndef _WIN32
+
+        /**
+         * Grows the mapped file so that at least \p required more bytes fit after the cursor.
+         */
+        void grow_mapping(std::size_t required) {
+            std::size_t used = _cursor - _begin;
+            std::size_t capacity = _end - _begin;
+            std::size_t newCapacity = std::max(capacity * 2, used + std::max(required, k_default_capacity));
+            if (ftruncate(_fd, static_cast<off_t>(newCapacity)) != 0) {
+                throw std::runtime_error("unable to grow mapped output file");
+            }
+            if (_begin != nullptr) {
+                munmap(_begin, capacity);
+            }
+            void* mapping = mmap(nullptr, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+            if (mapping == MAP_FAILED) {
+                _begin = _cursor = _end = nullptr;
+                throw std::runtime_error("unable to map output file");
+            }
+            _begin = static_cast<char*>(mapping);
+            _cursor = _begin + used;
+            _end = _begin + newCapacity;
+        }
+
+#endif
+
+        /**
+         * Makes room for at least \p required bytes after the cursor.
+         */
+        void make_room(std::size_t required) {
+#ifndef _WIN32
+            if (is_mapped()) {
+                grow_mapping(required);
+                return;
+            }
+#endif
+            if (_stream == nullptr) {
+                std::size_t used = _cursor - _begin;
+                _storage.resize(std::max(_storage.size() * 2, used + required));
+                _begin = _storage.data();
+                _cursor = _begin + used;
+                _end = _begin + _storage.size();
+                return;
+            }
+            flush();
+            if (static_cast<std::size_t>(_end - _cursor) < required) {
+                use_storage(required);
+            }
+        }
+
+        char* reserve(std::size_t required) {
+            if (static_cast<std::size_t>(_end - _cursor) < required) {
+                make_room(required);
+            }
+            return _cursor;
+        }
+
+        template<typename t_float>
+        output_buffer& write_float(t_float value, int precision) {
+            char* first = reserve(k_max_number_length);
+            // Bounded by what was reserved rather than by _end, so that the notation chosen does
+            // not depend on how full the buffer is.
+            char* limit = first + k_max_number_length;
+            std::to_chars_result result = std::to_chars(first, limit, value, std::chars_format::fixed, precision);
+            bool fixed = result.ec == std::errc();
+            if (!fixed) {
+                // Only huge magnitudes don't fit, which have no business in a fixed notation.
+                result = std::to_chars(first, limit, value);
+            }
+            char* last = result.ptr;
+            if (fixed && precision > 0 && std::memchr(first, '.', last - first) != nullptr) {
+                while (last[-1] == '0') {
+                    --last;
+                }
+                if (last[-1] == '.') {
+                    --last;
+                }
+            }
+            if (last - first == 2 && first[0] == '-' && first[1] == '0') {
+                first[0] = '0';
+                --last;
+            }
+            _cursor = last;
+            return *this;
+        }
+
+    public:
+        /**
+         * Accumulates the output in memory, starting with room for \p capacity bytes.
+         */
+        explicit output_buffer(std::size_t capacity = k_default_capacity) {
+            use_storage(capacity);
+        }
+
+        /**
+         * Buffers writes to \p stream, \p capacity bytes at a time.
+         */
+        explicit output_buffer(std::ostream& stream, std::size_t capacity = k_default_capacity) : _stream(&stream) {
+            use_storage(capacity);
+        }
+
+        /**
+         * Writes into the file at \p path, replacing it. The file is memory mapped and grown
+         * as needed, then truncated to what was written on close().
+         * @throws std::runtime_error if the file can't be created or mapped.
+         */
+        explicit output_buffer(const std::filesystem::path& path) {
+#ifndef _WIN32
+            _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (_fd < 0) {
+                throw file_error(path, "create");
+            }
+            try {
+                grow_mapping(0);
+            } catch (...) {
+                ::close(_fd);
+                throw;
+            }
+#else
+            _ownedStream = std::make_unique<std::ofstream>(path, std::ios::binary | std::ios::trunc);
+            if (!_ownedStream->is_open()) {
+                throw file_error(path, "create");
+            }
+            _stream = _ownedStream.get();
+            use_storage(k_default_capacity);
+#endif
+        }
+
+        output_buffer(const output_buffer&) = delete;
+
+        output_buffer& operator=(const output_buffer&) = delete;
+
+        ~output_buffer() {
+            try {
+                close();
+            } catch (...) {
+                // Destructors must not throw, call close() to observe errors.
+            }
+        }
+
+        /**
+         * @returns The number of bytes written so far, pending ones included.
+         */
+        std::size_t size() const {
+            return is_mapped() ? static_cast<std::size_t>(_cursor - _begin) : _flushed + (_cursor - _begin);
+        }
+
+        /**
+         * @returns Everything written to an in-memory buffer, or what is pending otherwise.
+         */
+        std::string_view view() const {
+            return std::string_view(_begin, _cursor - _begin);
+        }
+
+        /**
+         * Hands pending bytes to the stream. Mapped files are written in place, so this is a
+         * no-op for them until close().
+         */
+        void flush() {
+            if (_stream == nullptr || _cursor == _begin) {
+                return;
+            }
+            _stream->write(_begin, _cursor - _begin);
+            _flushed += _cursor - _begin;
+            _cursor = _begin;
+            if (!*_stream) {
+                throw std::runtime_error("unable to write to output stream");
+            }
+        }
+
+        /**
+         * Writes everything pending and, for mapped files, truncates and unmaps the file.
+         * Nothing may be written afterwards.
+         */
+        void close() {
+#ifndef _WIN32
+            if (is_mapped()) {
+                std::size_t used = _cursor - _begin;
+                munmap(_begin, _end - _begin);
+                _begin = _cursor = _end = nullptr;
+                _flushed = used;
+                int result = ftruncate(_fd, static_cast<off_t>(used));
+                ::close(_fd);
+                _fd = -1;
+                if (result != 0) {
+                    throw std::runtime_error("unable to truncate mapped output file");
+                }
+                return;
+            }
+#endif
+            flush();
+            if (_stream != nullptr) {
+                _stream->flush();
+                _stream = nullptr;
+                _ownedStream.reset();
+            }
+        }
+
+        output_buffer& put(char c) {
+            *reserve(1) = c;
+            ++_cursor;
+            return *this;
+        }
+
+        output_buffer& write(std::string_view text) {
+            if (text.size() > static_cast<std::size_t>(_end - _cursor)) {
+                make_room(text.size());
+            }
+            std::memcpy(_cursor, text.data(), text.size());
+            _cursor += text.size();
+            return *this;
+        }
+
+        template<typename t_integer, std::enable_if_t<std::is_integral_v<t_integer>, int> = 0>
+        output_buffer& write(t_integer value) {
+            char* first = reserve(k_max_number_length);
+            _cursor = std::to_chars(first, _end, value).ptr;
+            return *this;
+        }
+
+        /**
+         * Writes \p value in fixed notation with at most \p precision decimals, trailing
+         * zeros removed.
+         */
+        output_buffer& write(float value, int precision) {
+            return write_float(value, precision);
+        }
+
+        output_buffer& write(double value, int precision) {
+            return write_float(value, precision);
+        }
+
+        /**
+         * Writes \p value as two lowercase hexadecimal digits.
+         */
+        output_buffer& write_hex(std::uint8_t value) {
+            constexpr char k_digits[] = "0123456789abcdef";
+            char* first = reserve(2);
+            first[0] = k_digits[value >> 4];
+            first[1] = k_digits[value & 0xF];
+            _cursor = first + 2;
+            return *this;
+        }
+    };
+
+    /**
+     * Stream buffer appending to an output_buffer, so that anything with an operator<< can be
+     * written into one through a std::ostream.
+     */
+    class output_streambuf : public std::streambuf {
+    private:
+        output_buffer& _out;
+
+    protected:
+        int_type overflow(int_type c) override {
+            if (!traits_type::eq_int_type(c, traits_type::eof())) {
+                _out.put(traits_type::to_char_type(c));
+            }
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char* data, std::streamsize count) override {
+            _out.write(std::string_view(data, static_cast<std::size_t>(count)));
+            return count;
+        }
+
+    public:
+        explicit output_streambuf(output_buffer& out) : _out(out) {
+        }
+    };
+}
+
+#endif
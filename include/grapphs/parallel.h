@@ -0,0 +1,126 @@
+#ifndef GRAPPHS_PARALLEL_H
+#define GRAPPHS_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gpp {
+
+    /**
+     * Minimum amount of work items handed to a single thread by default.
+     * Ranges smaller than this are processed on the calling thread.
+     *
+     * Components splitting their work with num_chunks or parallel_for pick a grain of their
+     * own, large enough for a chunk to outweigh starting a thread, so that small inputs never
+     * leave the calling thread. Those taking a thread count (set_num_threads) invoke the
+     * callbacks they are given from every chunk, so callbacks must be safe to call from
+     * several threads at once unless the count is 1. Lambdas which only read shared state
+     * are; ones writing to it need to synchronize.
+     */
+    constexpr std::size_t k_default_parallel_grain = 1 << 14;
+
+    /**
+     * @returns The number of threads to use when zero threads are requested.
+     */
+    inline std::size_t default_concurrency() {
+        std::size_t hardware = std::thread::hardware_concurrency();
+        return hardware == 0 ? 1 : hardware;
+    }
+
+    /**
+     * @returns How many chunks \p count items should be split into, given that no chunk
+     * should be smaller than \p grain and that at most \p numThreads (0 meaning
+     * default_concurrency()) chunks are created.
+     */
+    inline std::size_t num_chunks(
+        std::size_t count,
+        std::size_t numThreads = 0,
+        std::size_t grain = k_default_parallel_grain
+    ) {
+        if (numThreads == 0) {
+            numThreads = default_concurrency();
+        }
+        std::size_t byGrain = grain == 0 ? count : count / grain;
+        return std::max<std::size_t>(1, std::min(numThreads, byGrain));
+    }
+
+    /**
+     * @returns The [begin, end) bounds of the \p chunk th out of \p numChunks even slices of
+     * [begin, end).
+     */
+    template<typename t_index>
+    std::pair<t_index, t_index> chunk_bounds(
+        t_index begin,
+        t_index end,
+        std::size_t numChunks,
+        std::size_t chunk
+    ) {
+        auto count = static_cast<std::size_t>(end - begin);
+        auto chunkBegin = static_cast<t_index>(begin + count * chunk / numChunks);
+        auto chunkEnd = static_cast<t_index>(begin + count * (chunk + 1) / numChunks);
+        return {chunkBegin, chunkEnd};
+    }
+
+    /**
+     * Invokes \p block(taskIndex) for every task in [0, numTasks), each one on its own thread.
+     * The last task runs on the calling thread. The first exception thrown by any task is
+     * rethrown once all tasks have finished.
+     */
+    template<typename t_block>
+    void parallel_invoke(std::size_t numTasks, const t_block& block) {
+        if (numTasks == 0) {
+            return;
+        }
+        std::vector<std::exception_ptr> errors(numTasks);
+        auto run = [&](std::size_t task) {
+            try {
+                block(task);
+            } catch (...) {
+                errors[task] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(numTasks - 1);
+        for (std::size_t task = 0; task < numTasks - 1; ++task) {
+            workers.emplace_back(run, task);
+        }
+        run(numTasks - 1);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        for (const std::exception_ptr& error : errors) {
+            if (error != nullptr) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    /**
+     * Splits [begin, end) into contiguous chunks (see num_chunks) and invokes
+     * \p block(chunkBegin, chunkEnd, chunkIndex) for each of them in parallel.
+     */
+    template<typename t_index, typename t_block>
+    void parallel_for(
+        t_index begin,
+        t_index end,
+        const t_block& block,
+        std::size_t numThreads = 0,
+        std::size_t grain = k_default_parallel_grain
+    ) {
+        if (end <= begin) {
+            return;
+        }
+        std::size_t chunks = num_chunks(static_cast<std::size_t>(end - begin), numThreads, grain);
+        parallel_invoke(
+            chunks, [&](std::size_t chunk) {
+                auto [chunkBegin, chunkEnd] = chunk_bounds(begin, end, chunks, chunk);
+                block(chunkBegin, chunkEnd, chunk);
+            }
+        );
+    }
+}
+#endif
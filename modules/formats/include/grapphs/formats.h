@@ -0,0 +1,316 @@
+#ifndef GRAPPHS_FORMATS_H
+#define GRAPPHS_FORMATS_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <grapphs/adjacency_list.h>
+#include <grapphs/csr_graph.h>
+#include <grapphs/graph_builder.h>
+#include <grapphs/mapped_file.h>
+#include <grapphs/parallel.h>
+
+namespace gpp {
+
+    enum class text_graph_format {
+        /**
+         * SNAP style edge lists: one "from to [weight]" line per edge, with 0 based indices.
+         * Lines starting with # or % are comments.
+         */
+        EDGE_LIST,
+        /**
+         * DIMACS shortest path files (.gr): a "p sp vertices arcs" problem line followed by one
+         * "a from to weight" line per arc, with 1 based indices. Lines starting with c are
+         * comments.
+         */
+        DIMACS,
+        /**
+         * Matrix Market coordinate files (.mtx): a %%MatrixMarket banner, a "rows columns
+         * entries" size line, then one "row column [value]" line per entry, with 1 based
+         * indices. Symmetric matrices store a single triangle. Lines starting with % are
+         * comments.
+         */
+        MATRIX_MARKET
+    };
+
+    /**
+     * What a text graph file declares ahead of its edges.
+     */
+    struct text_graph_header {
+        /**
+         * Offset of the first byte after the header.
+         */
+        std::size_t dataOffset = 0;
+        /**
+         * Number of vertices declared, 0 if the format doesn't declare it.
+         */
+        std::uint64_t numVertices = 0;
+        std::uint64_t numEdges = 0;
+        /**
+         * Index of the first vertex in the file.
+         */
+        std::uint64_t indexBase = 0;
+        /**
+         * Whether every edge stands for both directions.
+         */
+        bool symmetric = false;
+    };
+
+    /**
+     * @throws std::runtime_error if the header of \p text is malformed or describes something
+     * other than a graph, such as a dense or complex Matrix Market matrix.
+     */
+    text_graph_header read_text_graph_header(std::string_view text, text_graph_format format);
+
+    /**
+     * Splits \p text into at most \p numChunks contiguous chunks of similar size, all but the
+     * last one ending right after a line break, so that no line spans two chunks.
+     */
+    std::vector<std::string_view> split_lines(std::string_view text, std::size_t numChunks);
+
+    namespace detail {
+
+        inline const char* skip_blanks(const char* position, const char* end) {
+            while (position < end && (*position == ' ' || *position == '\t' || *position == '\r')) {
+                ++position;
+            }
+            return position;
+        }
+
+        /**
+         * Parses the blank separated number at \p position into \p value.
+         * @returns Past the number, or nullptr if there is none.
+         */
+        template<typename t_number>
+        const char* parse_field(const char* position, const char* end, t_number& value) {
+            position = skip_blanks(position, end);
+            if (position < end && *position == '+') {
+                ++position;
+            }
+            auto [last, error] = std::from_chars(position, end, value);
+            return error == std::errc() ? last : nullptr;
+        }
+
+        [[noreturn]] inline void malformed_edge(std::string_view text, const char* position) {
+            throw std::runtime_error(
+                "malformed edge at byte " + std::to_string(position - text.data())
+            );
+        }
+    }
+
+    /**
+     * Loads graphs stored in the common plain text formats (see text_graph_format) into a
+     * gpp::graph_builder, from which either a csr_graph or an adjacency_list is built.
+     *
+     * Files are memory mapped and split at line boundaries into chunks which are parsed
+     * concurrently, each filling a graph_builder::batch of its own. Numbers are parsed with
+     * std::from_chars, so parsing doesn't depend on the locale. Edge weights, 1 when missing,
+     * are turned into edges by the edge factory. Vertices carry no data in these formats and
+     * are default constructed, as many as declared or as needed by the largest index read.
+     */
+    template<typename t_vertex, typename t_edge, typename t_index = default_graph_index>
+    class text_graph_reader {
+    public:
+        using index_type = t_index;
+        using edge_factory = std::function<t_edge(double weight)>;
+
+    private:
+        /**
+         * Minimum bytes parsed per chunk, see gpp::k_default_parallel_grain.
+         */
+        static constexpr std::size_t k_chunk_grain = 1 << 20;
+        /**
+         * Rough number of bytes per line, used to reserve batches up front.
+         */
+        static constexpr std::size_t k_expected_line_length = 16;
+
+        edge_factory _edgeFactory;
+        graph_builder<t_edge, index_type> _builder;
+        std::size_t _numThreads = 0;
+        std::uint64_t _numVertices = 0;
+        /**
+         * Chunks parsed so far, which orders batches as their chunks come in the input.
+         */
+        std::size_t _numChunks = 0;
+        bool _symmetric = false;
+
+        /**
+         * Parses every edge line of \p chunk into \p edges.
+         * @returns One past the largest vertex index read, 0 if none.
+         */
+        std::uint64_t parse_chunk(
+            std::string_view text,
+            std::string_view chunk,
+            text_graph_format format,
+            const text_graph_header& header,
+            typename graph_builder<t_edge, index_type>::batch& edges
+        ) const {
+            bool symmetric = header.symmetric || _symmetric;
+            std::uint64_t numVertices = 0;
+            const char* position = chunk.data();
+            const char* end = chunk.data() + chunk.size();
+            while (position < end) {
+                const void* newline = std::memchr(position, '\n', end - position);
+                const char* lineEnd = newline == nullptr ? end : static_cast<const char*>(newline);
+                const char* first = detail::skip_blanks(position, lineEnd);
+                position = lineEnd + 1;
+                if (first == lineEnd) {
+                    continue;
+                }
+                const char* line = first;
+                char c = *first;
+                if (format == text_graph_format::DIMACS) {
+                    if (c == 'c') {
+                        continue;
+                    }
+                    if (c != 'a') {
+                        detail::malformed_edge(text, line);
+                    }
+                    ++first;
+                }
+                else if (c == '%' || (c == '#' && format == text_graph_format::EDGE_LIST)) {
+                    continue;
+                }
+                std::uint64_t from;
+                std::uint64_t to;
+                first = detail::parse_field(first, lineEnd, from);
+                if (first != nullptr) {
+                    first = detail::parse_field(first, lineEnd, to);
+                }
+                if (first == nullptr || from < header.indexBase || to < header.indexBase) {
+                    detail::malformed_edge(text, line);
+                }
+                from -= header.indexBase;
+                to -= header.indexBase;
+                double weight = 1;
+                first = detail::skip_blanks(first, lineEnd);
+                if (first < lineEnd && detail::parse_field(first, lineEnd, weight) == nullptr) {
+                    detail::malformed_edge(text, line);
+                }
+                numVertices = std::max(numVertices, std::max(from, to) + 1);
+                t_edge edge = _edgeFactory(weight);
+                auto fromIndex = static_cast<index_type>(from);
+                auto toIndex = static_cast<index_type>(to);
+                if (symmetric && from != to) {
+                    edges.add(toIndex, fromIndex, edge);
+                }
+                edges.add(fromIndex, toIndex, std::move(edge));
+            }
+            return numVertices;
+        }
+
+    public:
+        text_graph_reader() {
+            _edgeFactory = [](double weight) {
+                if constexpr (std::is_constructible_v<t_edge, double>) {
+                    return static_cast<t_edge>(weight);
+                }
+                else {
+                    return t_edge{};
+                }
+            };
+        }
+
+        void set_edge_factory(const edge_factory& edgeFactory) {
+            _edgeFactory = edgeFactory;
+        }
+
+        /**
+         * Sets how many threads parse, 0 (the default) meaning one per hardware thread.
+         * The edge factory must be thread safe when this is not 1.
+         */
+        void set_num_threads(std::size_t numThreads) {
+            _numThreads = numThreads;
+        }
+
+        /**
+         * Adds every edge in both directions, regardless of what the file declares.
+         */
+        void set_symmetric(bool symmetric) {
+            _symmetric = symmetric;
+        }
+
+        /**
+         * Parses every edge of \p text, which is only used during the call.
+         * @throws std::runtime_error if \p text is malformed.
+         */
+        void parse(std::string_view text, text_graph_format format) {
+            text_graph_header header = read_text_graph_header(text, format);
+            _numVertices = std::max(_numVertices, header.numVertices);
+            std::string_view data = text.substr(header.dataOffset);
+            std::vector<std::string_view> chunks = split_lines(
+                data, num_chunks(data.size(), _numThreads, k_chunk_grain)
+            );
+            std::vector<std::uint64_t> numVertices(chunks.size());
+            parallel_invoke(
+                chunks.size(), [&](std::size_t chunk) {
+                    typename graph_builder<t_edge, index_type>::batch edges;
+                    edges.reserve(chunks[chunk].size() / k_expected_line_length);
+                    numVertices[chunk] = parse_chunk(text, chunks[chunk], format, header, edges);
+                    _builder.submit(std::move(edges), _numChunks + chunk);
+                }
+            );
+            _numChunks += chunks.size();
+            for (std::uint64_t count : numVertices) {
+                _numVertices = std::max(_numVertices, count);
+            }
+        }
+
+        /**
+         * Maps and parses the file at \p path.
+         * @throws std::runtime_error if the file can't be read or is malformed.
+         */
+        void parse_file(const std::filesystem::path& path, text_graph_format format) {
+            mapped_file file(path);
+            file.advise_sequential();
+            parse(std::string_view(file.data(), file.size()), format);
+        }
+
+        /**
+         * @returns How many vertices the graph built will have.
+         */
+        std::size_t num_vertices() const {
+            return static_cast<std::size_t>(_numVertices);
+        }
+
+        /**
+         * @returns The builder holding the edges read so far, to tune how graphs are built.
+         */
+        graph_builder<t_edge, index_type>& builder() {
+            return _builder;
+        }
+
+        /**
+         * Builds a csr_graph out of everything read so far, which is consumed.
+         */
+        csr_graph<t_vertex, t_edge, index_type> build_csr() {
+            std::vector<t_vertex> vertices(num_vertices());
+            _numVertices = 0;
+            _numChunks = 0;
+            return _builder.build_csr(std::move(vertices));
+        }
+
+        /**
+         * Pushes as many vertices as read so far into \p graph, which must be empty, and connects
+         * every edge. Both are consumed.
+         */
+        void build_into(adjacency_list<t_vertex, t_edge, index_type>& graph) {
+            graph.reserve(static_cast<index_type>(num_vertices()));
+            for (std::size_t i = 0; i < num_vertices(); ++i) {
+                graph.push(t_vertex{});
+            }
+            _numVertices = 0;
+            _numChunks = 0;
+            _builder.build_into(graph);
+        }
+    };
+}
+#endif
@@ -0,0 +1,166 @@
+#include <grapphs/formats.h>
+
+#include <cctype>
+
+namespace gpp {
+
+    namespace {
+
+        /**
+         * Cursor over the lines of a header.
+         */
+        class line_reader {
+        private:
+            std::string_view _text;
+            std::size_t _position = 0;
+
+        public:
+            explicit line_reader(std::string_view text) : _text(text) {
+            }
+
+            bool next(std::string_view& line) {
+                if (_position >= _text.size()) {
+                    return false;
+                }
+                std::size_t end = _text.find('\n', _position);
+                if (end == std::string_view::npos) {
+                    end = _text.size();
+                }
+                line = _text.substr(_position, end - _position);
+                _position = std::min(end + 1, _text.size());
+                return true;
+            }
+
+            std::size_t position() const {
+                return _position;
+            }
+        };
+
+        std::string_view trim(std::string_view text) {
+            std::size_t first = text.find_first_not_of(" \t\r");
+            if (first == std::string_view::npos) {
+                return {};
+            }
+            return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+        }
+
+        /**
+         * @returns The next blank separated word of \p text, which is advanced past it.
+         */
+        std::string_view next_word(std::string_view& text) {
+            text = trim(text);
+            std::size_t end = std::min(text.find_first_of(" \t"), text.size());
+            std::string_view word = text.substr(0, end);
+            text.remove_prefix(end);
+            return word;
+        }
+
+        bool equals_ignore_case(std::string_view a, std::string_view b) {
+            return a.size() == b.size() && std::equal(
+                a.begin(), a.end(), b.begin(), [](char x, char y) {
+                    return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+                }
+            );
+        }
+
+        bool parse_count(std::string_view& text, std::uint64_t& value) {
+            std::string_view word = next_word(text);
+            auto [last, error] = std::from_chars(word.data(), word.data() + word.size(), value);
+            return error == std::errc() && last == word.data() + word.size();
+        }
+
+        std::runtime_error header_error(const char* what) {
+            return std::runtime_error(std::string("malformed header: ") + what);
+        }
+
+        text_graph_header read_dimacs_header(std::string_view text) {
+            text_graph_header header;
+            header.indexBase = 1;
+            line_reader lines(text);
+            std::string_view line;
+            while (lines.next(line)) {
+                line = trim(line);
+                if (line.empty() || line.front() == 'c') {
+                    continue;
+                }
+                if (line.front() != 'p') {
+                    throw header_error("expected a DIMACS problem line");
+                }
+                line.remove_prefix(1);
+                next_word(line);
+                if (!parse_count(line, header.numVertices) || !parse_count(line, header.numEdges)) {
+                    throw header_error("expected vertex and arc counts in the DIMACS problem line");
+                }
+                header.dataOffset = lines.position();
+                return header;
+            }
+            throw header_error("missing DIMACS problem line");
+        }
+
+        text_graph_header read_matrix_market_header(std::string_view text) {
+            text_graph_header header;
+            header.indexBase = 1;
+            line_reader lines(text);
+            std::string_view line;
+            if (!lines.next(line) || line.substr(0, 14) != "%%MatrixMarket") {
+                throw header_error("missing %%MatrixMarket banner");
+            }
+            line.remove_prefix(14);
+            std::string_view object = next_word(line);
+            std::string_view format = next_word(line);
+            std::string_view field = next_word(line);
+            std::string_view symmetry = next_word(line);
+            if (!equals_ignore_case(object, "matrix") || !equals_ignore_case(format, "coordinate")) {
+                throw header_error("only coordinate matrices describe graphs");
+            }
+            if (equals_ignore_case(field, "complex")) {
+                throw header_error("complex matrices are not supported");
+            }
+            header.symmetric = !equals_ignore_case(symmetry, "general");
+            while (lines.next(line)) {
+                line = trim(line);
+                if (line.empty() || line.front() == '%') {
+                    continue;
+                }
+                std::uint64_t rows;
+                std::uint64_t columns;
+                if (!parse_count(line, rows) || !parse_count(line, columns) || !parse_count(line, header.numEdges)) {
+                    throw header_error("expected rows, columns and entries in the Matrix Market size line");
+                }
+                header.numVertices = std::max(rows, columns);
+                header.dataOffset = lines.position();
+                return header;
+            }
+            throw header_error("missing Matrix Market size line");
+        }
+    }
+
+    text_graph_header read_text_graph_header(std::string_view text, text_graph_format format) {
+        switch (format) {
+            case text_graph_format::DIMACS:
+                return read_dimacs_header(text);
+            case text_graph_format::MATRIX_MARKET:
+                return read_matrix_market_header(text);
+            case text_graph_format::EDGE_LIST:
+            default:
+                return text_graph_header{};
+        }
+    }
+
+    std::vector<std::string_view> split_lines(std::string_view text, std::size_t numChunks) {
+        std::vector<std::string_view> chunks;
+        numChunks = std::max<std::size_t>(numChunks, 1);
+        std::size_t begin = 0;
+        for (std::size_t chunk = 1; chunk <= numChunks && begin < text.size(); ++chunk) {
+            std::size_t end = text.size();
+            if (chunk < numChunks) {
+                end = std::max(begin, text.size() * chunk / numChunks);
+                end = text.find('\n', end);
+                end = end == std::string_view::npos ? text.size() : end + 1;
+            }
+            chunks.push_back(text.substr(begin, end - begin));
+            begin = end;
+        }
+        return chunks;
+    }
+}
@@ -0,0 +1,103 @@
+#include <grapphs/formats.h>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+typedef gpp::csr_graph<int, float> test_graph;
+
+TEST(grapphs_formats, edge_list) {
+    gpp::text_graph_reader<int, float> reader;
+    reader.parse(
+        "# Directed graph\n"
+        "# FromNodeId\tToNodeId\n"
+        "0\t1\n"
+        "1 2 0.5\r\n"
+        "\n"
+        "4 0",
+        gpp::text_graph_format::EDGE_LIST
+    );
+    ASSERT_EQ(reader.num_vertices(), 5);
+    test_graph graph = reader.build_csr();
+    ASSERT_EQ(graph.size(), 5);
+    EXPECT_EQ(*graph.edge(0, 1), 1.0F);
+    EXPECT_EQ(*graph.edge(1, 2), 0.5F);
+    EXPECT_EQ(*graph.edge(4, 0), 1.0F);
+    EXPECT_EQ(graph.edge(1, 0), nullptr);
+
+    gpp::text_graph_reader<int, float> invalid;
+    EXPECT_THROW(invalid.parse("0 1\nx 2\n", gpp::text_graph_format::EDGE_LIST), std::runtime_error);
+}
+
+TEST(grapphs_formats, dimacs) {
+    gpp::text_graph_reader<int, float> reader;
+    reader.parse(
+        "c 9th DIMACS Implementation Challenge\n"
+        "p sp 4 3\n"
+        "c graph contains 4 nodes and 3 arcs\n"
+        "a 1 2 803\n"
+        "a 2 3 158\n"
+        "a 3 1 774\n",
+        gpp::text_graph_format::DIMACS
+    );
+    gpp::adjacency_list<int, float> graph;
+    reader.build_into(graph);
+    ASSERT_EQ(graph.size(), 4);
+    EXPECT_EQ(*graph.edge(0, 1), 803.0F);
+    EXPECT_EQ(*graph.edge(1, 2), 158.0F);
+    EXPECT_EQ(*graph.edge(2, 0), 774.0F);
+
+    gpp::text_graph_reader<int, float> invalid;
+    EXPECT_THROW(invalid.parse("a 1 2 3\n", gpp::text_graph_format::DIMACS), std::runtime_error);
+    EXPECT_THROW(invalid.parse("p sp 2 1\na 0 1 3\n", gpp::text_graph_format::DIMACS), std::runtime_error);
+}
+
+TEST(grapphs_formats, matrix_market) {
+    gpp::text_graph_reader<int, float> reader;
+    reader.parse(
+        "%%MatrixMarket matrix coordinate pattern symmetric\n"
+        "% comment\n"
+        "3 3 3\n"
+        "2 1\n"
+        "3 2\n"
+        "3 3\n",
+        gpp::text_graph_format::MATRIX_MARKET
+    );
+    test_graph graph = reader.build_csr();
+    ASSERT_EQ(graph.size(), 3);
+    EXPECT_NE(graph.edge(0, 1), nullptr);
+    EXPECT_NE(graph.edge(1, 0), nullptr);
+    EXPECT_NE(graph.edge(1, 2), nullptr);
+    EXPECT_NE(graph.edge(2, 1), nullptr);
+    EXPECT_NE(graph.edge(2, 2), nullptr);
+    EXPECT_EQ(graph.edges_from(2).size(), 2);
+
+    gpp::text_graph_reader<int, float> invalid;
+    EXPECT_THROW(
+        invalid.parse("%%MatrixMarket matrix array real general\n2 2\n", gpp::text_graph_format::MATRIX_MARKET),
+        std::runtime_error
+    );
+}
+
+TEST(grapphs_formats, parallel_chunks) {
+    constexpr std::size_t numVertices = 400000;
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "grapphs_formats.gr";
+    {
+        std::ofstream file(path);
+        file << "p sp " << numVertices << ' ' << numVertices << '\n';
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            file << "a " << i + 1 << ' ' << (i + 1) % numVertices + 1 << ' ' << i << '\n';
+        }
+    }
+    gpp::text_graph_reader<int, float> reader;
+    reader.set_num_threads(8);
+    reader.builder().set_sort_targets(true);
+    reader.parse_file(path, gpp::text_graph_format::DIMACS);
+    std::filesystem::remove(path);
+    test_graph graph = reader.build_csr();
+    ASSERT_EQ(graph.size(), numVertices);
+    for (std::size_t i = 0; i < numVertices; ++i) {
+        ASSERT_EQ(graph.edges_from(i).size(), 1);
+        EXPECT_EQ(*graph.edge(i, (i + 1) % numVertices), static_cast<float>(i));
+    }
+}
@@ -8,6 +8,7 @@
 #include <fstream>
 #include <filesystem>
 #include <grapphs/graph_writer.h>
+#include <grapphs/dot_reader.h>
 
 namespace gpp {
     template<typename t_graph>
@@ -16,6 +17,12 @@ namespace gpp {
         return writer.to_dot(graph);
     }
 
+    template<typename t_graph>
+    void write_dot(const t_graph& graph, std::ostream& stream) {
+        gpp::graph_writer<decltype(graph)> writer;
+        writer.write(stream, graph);
+    }
+
     template<typename t_graph>
     bool save_to_dot(
         const t_graph& graph,
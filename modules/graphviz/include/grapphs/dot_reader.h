@@ -0,0 +1,750 @@
+#ifndef GRAPPHS_DOT_READER_H
+#define GRAPPHS_DOT_READER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <grapphs/adjacency_list.h>
+#include <grapphs/csr_graph.h>
+#include <grapphs/graph_builder.h>
+#include <grapphs/mapped_file.h>
+
+namespace gpp {
+
+    /**
+     * key=value pair of a DOT attribute list. Both are views into the parsed text, with the
+     * quotes of quoted strings and the angle brackets of HTML strings removed, but escapes
+     * kept, see dot_unescape().
+     */
+    struct dot_attribute {
+        std::string_view key;
+        std::string_view value;
+    };
+
+    /**
+     * @returns \p text with escaped quotes unescaped and escaped newlines removed.
+     */
+    inline std::string dot_unescape(std::string_view text) {
+        std::string unescaped;
+        unescaped.reserve(text.size());
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == '\\' && i + 1 < text.size()) {
+                if (text[i + 1] == '"') {
+                    unescaped.push_back('"');
+                    ++i;
+                    continue;
+                }
+                if (text[i + 1] == '\n') {
+                    ++i;
+                    continue;
+                }
+            }
+            unescaped.push_back(text[i]);
+        }
+        return unescaped;
+    }
+
+    /**
+     * Parses \p text, an attribute value, as a number, meant for vertex and edge parsers.
+     * @returns false, leaving \p value untouched, if \p text is not entirely a number.
+     */
+    template<typename t_number>
+    bool parse_dot_number(std::string_view text, t_number& value) {
+        if (!text.empty() && text.front() == '+') {
+            text.remove_prefix(1);
+        }
+        t_number parsed{};
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), parsed);
+        if (error != std::errc() || end != text.data() + text.size()) {
+            return false;
+        }
+        value = parsed;
+        return true;
+    }
+
+    namespace detail {
+
+        enum class dot_token_type {
+            ID,
+            LEFT_BRACE,
+            RIGHT_BRACE,
+            LEFT_BRACKET,
+            RIGHT_BRACKET,
+            EQUALS,
+            SEMICOLON,
+            COMMA,
+            COLON,
+            EDGE_OPERATOR,
+            END
+        };
+
+        struct dot_token {
+            dot_token_type type = dot_token_type::END;
+            std::string_view text;
+            bool quoted = false;
+        };
+
+        /**
+         * Zero copy DOT tokenizer. Tokens are views into the text, which is scanned once.
+         */
+        class dot_tokenizer {
+        private:
+            const char* _begin;
+            const char* _position;
+            const char* _end;
+
+            static bool is_identifier_start(char c) {
+                return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'
+                       || static_cast<unsigned char>(c) >= 0x80;
+            }
+
+            static bool is_digit(char c) {
+                return c >= '0' && c <= '9';
+            }
+
+            void skip_blanks() {
+                while (_position < _end) {
+                    char c = *_position;
+                    if (c == ' ' || c == '\n' || c == '\t' || c == '\r') {
+                        ++_position;
+                    }
+                    else if (c == '/' && _position + 1 < _end && _position[1] == '/') {
+                        skip_line();
+                    }
+                    else if (c == '#' && (_position == _begin || _position[-1] == '\n')) {
+                        // Lines starting with # are C preprocessor output.
+                        skip_line();
+                    }
+                    else if (c == '/' && _position + 1 < _end && _position[1] == '*') {
+                        const char* close = find(_position + 2, "*/");
+                        if (close == nullptr) {
+                            fail("unterminated comment");
+                        }
+                        _position = close + 2;
+                    }
+                    else {
+                        return;
+                    }
+                }
+            }
+
+            void skip_line() {
+                const void* newline = std::memchr(_position, '\n', _end - _position);
+                _position = newline == nullptr ? _end : static_cast<const char*>(newline) + 1;
+            }
+
+            const char* find(const char* from, std::string_view needle) const {
+                std::string_view rest(from, _end - from);
+                std::size_t found = rest.find(needle);
+                return found == std::string_view::npos ? nullptr : from + found;
+            }
+
+            dot_token single(dot_token_type type) {
+                dot_token token{type, std::string_view(_position, 1)};
+                ++_position;
+                return token;
+            }
+
+        public:
+            explicit dot_tokenizer(std::string_view text)
+                : _begin(text.data()), _position(text.data()), _end(text.data() + text.size()) {
+            }
+
+            /**
+             * @throws std::runtime_error with the current line number.
+             */
+            [[noreturn]] void fail(const std::string& what) const {
+                std::size_t line = 1 + std::count(_begin, _position, '\n');
+                throw std::runtime_error("dot: line " + std::to_string(line) + ": " + what);
+            }
+
+            dot_token next() {
+                skip_blanks();
+                if (_position == _end) {
+                    return dot_token{};
+                }
+                char c = *_position;
+                switch (c) {
+                    case '{':
+                        return single(dot_token_type::LEFT_BRACE);
+                    case '}':
+                        return single(dot_token_type::RIGHT_BRACE);
+                    case '[':
+                        return single(dot_token_type::LEFT_BRACKET);
+                    case ']':
+                        return single(dot_token_type::RIGHT_BRACKET);
+                    case '=':
+                        return single(dot_token_type::EQUALS);
+                    case ';':
+                        return single(dot_token_type::SEMICOLON);
+                    case ',':
+                        return single(dot_token_type::COMMA);
+                    case ':':
+                        return single(dot_token_type::COLON);
+                    case '"': {
+                        const char* first = ++_position;
+                        while (_position < _end && *_position != '"') {
+                            _position += *_position == '\\' && _position + 1 < _end ? 2 : 1;
+                        }
+                        if (_position >= _end) {
+                            fail("unterminated string");
+                        }
+                        dot_token token{dot_token_type::ID, std::string_view(first, _position - first), true};
+                        ++_position;
+                        return token;
+                    }
+                    case '<': {
+                        const char* first = ++_position;
+                        std::size_t depth = 1;
+                        for (; _position < _end; ++_position) {
+                            if (*_position == '<') {
+                                ++depth;
+                            }
+                            else if (*_position == '>' && --depth == 0) {
+                                break;
+                            }
+                        }
+                        if (_position >= _end) {
+                            fail("unterminated HTML string");
+                        }
+                        dot_token token{dot_token_type::ID, std::string_view(first, _position - first), true};
+                        ++_position;
+                        return token;
+                    }
+                    default:
+                        break;
+                }
+                if (c == '-' && _position + 1 < _end && (_position[1] == '>' || _position[1] == '-')) {
+                    dot_token token{dot_token_type::EDGE_OPERATOR, std::string_view(_position, 2)};
+                    _position += 2;
+                    return token;
+                }
+                const char* first = _position;
+                if (is_identifier_start(c)) {
+                    while (_position < _end && (is_identifier_start(*_position) || is_digit(*_position))) {
+                        ++_position;
+                    }
+                }
+                else if (c == '-' || c == '.' || is_digit(c)) {
+                    ++_position;
+                    while (_position < _end && (is_digit(*_position) || *_position == '.')) {
+                        ++_position;
+                    }
+                }
+                else {
+                    fail(std::string("unexpected character '") + c + "'");
+                }
+                return dot_token{dot_token_type::ID, std::string_view(first, _position - first)};
+            }
+        };
+
+        inline bool is_dot_keyword(const dot_token& token, std::string_view keyword) {
+            if (token.type != dot_token_type::ID || token.quoted || token.text.size() != keyword.size()) {
+                return false;
+            }
+            for (std::size_t i = 0; i < keyword.size(); ++i) {
+                char c = token.text[i];
+                if (c >= 'A' && c <= 'Z') {
+                    c = static_cast<char>(c - 'A' + 'a');
+                }
+                if (c != keyword[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Maps vertex identifiers to indices in order of first appearance. Identifiers are kept
+         * as views, with their hashes stored next to the indices in a flat, linearly probed
+         * table so that misses rarely touch the text. Small decimal identifiers, the most common
+         * ones by far, skip hashing and are looked up in a dense array instead.
+         */
+        template<typename t_index>
+        class dot_id_table {
+        private:
+            static constexpr t_index k_empty = std::numeric_limits<t_index>::max();
+            /**
+             * Dense identifiers may exceed twice the vertex count by this much.
+             */
+            static constexpr std::size_t k_dense_slack = 1 << 16;
+
+            struct slot {
+                std::uint64_t hash;
+                t_index index;
+            };
+
+            std::vector<slot> _slots;
+            std::vector<t_index> _dense;
+            std::vector<std::string_view> _ids;
+
+            static std::uint64_t hash(std::string_view id) {
+                // FNV-1a
+                std::uint64_t hash = 14695981039346656037ULL;
+                for (char c : id) {
+                    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+                }
+                return hash;
+            }
+
+            /**
+             * @returns Whether \p id is a decimal numeral which could be dense, without leading zeros.
+             */
+            static bool parse_numeral(std::string_view id, std::size_t& value) {
+                if (id.empty() || id.size() > 9 || (id[0] == '0' && id.size() > 1)) {
+                    return false;
+                }
+                value = 0;
+                for (char c : id) {
+                    if (c < '0' || c > '9') {
+                        return false;
+                    }
+                    value = value * 10 + (c - '0');
+                }
+                return true;
+            }
+
+            std::size_t probe(std::string_view id, std::uint64_t idHash) const {
+                std::size_t mask = _slots.size() - 1;
+                std::size_t position = idHash & mask;
+                while (_slots[position].index != k_empty) {
+                    const slot& candidate = _slots[position];
+                    if (candidate.hash == idHash && _ids[candidate.index] == id) {
+                        break;
+                    }
+                    position = (position + 1) & mask;
+                }
+                return position;
+            }
+
+            void grow() {
+                std::vector<slot> old(std::max<std::size_t>(_slots.size() * 2, 64), slot{0, k_empty});
+                old.swap(_slots);
+                std::size_t mask = _slots.size() - 1;
+                for (const slot& entry : old) {
+                    if (entry.index != k_empty) {
+                        std::size_t position = entry.hash & mask;
+                        while (_slots[position].index != k_empty) {
+                            position = (position + 1) & mask;
+                        }
+                        _slots[position] = entry;
+                    }
+                }
+            }
+
+            t_index find_hashed(std::string_view id) const {
+                return _slots.empty() ? k_empty : _slots[probe(id, hash(id))].index;
+            }
+
+        public:
+            /**
+             * @returns The index of \p id and whether it was just assigned.
+             */
+            std::pair<t_index, bool> insert(std::string_view id) {
+                auto next = static_cast<t_index>(_ids.size());
+                std::size_t value;
+                if (parse_numeral(id, value)) {
+                    if (value >= _dense.size() && value < 2 * _ids.size() + k_dense_slack) {
+                        _dense.resize(std::max(value + 1, _dense.size() * 2), k_empty);
+                    }
+                    if (value < _dense.size()) {
+                        t_index& index = _dense[value];
+                        if (index != k_empty) {
+                            return {index, false};
+                        }
+                        // It may have been hashed before the dense range grew to cover it.
+                        index = find_hashed(id);
+                        if (index != k_empty) {
+                            return {index, false};
+                        }
+                        index = next;
+                        _ids.push_back(id);
+                        return {next, true};
+                    }
+                }
+                if ((_ids.size() + 1) * 2 > _slots.size()) {
+                    grow();
+                }
+                std::uint64_t idHash = hash(id);
+                slot& entry = _slots[probe(id, idHash)];
+                if (entry.index != k_empty) {
+                    return {entry.index, false};
+                }
+                entry = slot{idHash, next};
+                _ids.push_back(id);
+                return {next, true};
+            }
+
+            bool find(std::string_view id, t_index& index) const {
+                std::size_t value;
+                if (parse_numeral(id, value) && value < _dense.size() && _dense[value] != k_empty) {
+                    index = _dense[value];
+                    return true;
+                }
+                index = find_hashed(id);
+                return index != k_empty;
+            }
+
+            const std::vector<std::string_view>& ids() const {
+                return _ids;
+            }
+        };
+    }
+
+    /**
+     * Reads graphs in the graphviz DOT format into a gpp::graph_builder, from which either a
+     * csr_graph or an adjacency_list is built.
+     *
+     * Files are memory mapped and tokenized without copies: vertex identifiers and attributes
+     * are views into the file, which stays mapped for as long as the reader lives. Attributes
+     * are turned into vertex and edge payloads by the parsers given to the reader. Vertices are
+     * indexed in order of first appearance, and undirected edges are added in both directions.
+     *
+     * Node and edge defaults (node [...], edge [...]) are handed to the parsers before the
+     * attributes of each statement, so later attributes override them. Subgraphs are flattened,
+     * and may be used as edge endpoints. Ports and graph attributes are ignored.
+     *
+     * Parsing is single threaded, as statements can't be told apart without tokenizing from
+     * the start. It runs at about 110 MB/s while the identifier table fits in cache, dropping
+     * to 65 MB/s at a million vertices, where random vertex lookups take half the time; the
+     * read_dot benchmark measures it.
+     */
+    template<typename t_vertex, typename t_edge, typename t_index = default_graph_index>
+    class dot_reader {
+    public:
+        using index_type = t_index;
+        using attribute_list = std::vector<dot_attribute>;
+        using vertex_parser = std::function<
+            void(
+                std::string_view id, const attribute_list& attributes, t_vertex& vertex
+            )
+        >;
+        using edge_parser = std::function<
+            void(
+                const attribute_list& attributes, t_edge& edge
+            )
+        >;
+
+    private:
+        using token = detail::dot_token;
+        using token_type = detail::dot_token_type;
+
+        struct scope_defaults {
+            attribute_list node;
+            attribute_list edge;
+        };
+
+        vertex_parser _vertexParser;
+        edge_parser _edgeParser;
+        /**
+         * Every file parsed, which ids() point into.
+         */
+        std::vector<mapped_file> _files;
+        bool _directed = true;
+        std::vector<t_vertex> _vertices;
+        detail::dot_id_table<index_type> _ids;
+        graph_builder<t_edge, index_type> _builder;
+
+        detail::dot_tokenizer* _tokenizer = nullptr;
+        token _current;
+        attribute_list _attributes;
+
+        void advance() {
+            _current = _tokenizer->next();
+        }
+
+        void expect(token_type type, const char* what) {
+            if (_current.type != type) {
+                _tokenizer->fail(std::string("expected ") + what);
+            }
+            advance();
+        }
+
+        index_type vertex_index(std::string_view id, const scope_defaults& defaults) {
+            auto [index, inserted] = _ids.insert(id);
+            if (inserted) {
+                _vertices.emplace_back();
+                if (_vertexParser != nullptr) {
+                    _vertexParser(id, defaults.node, _vertices.back());
+                }
+            }
+            return index;
+        }
+
+        /**
+         * Parses any number of bracketed attribute lists, appending to _attributes.
+         */
+        void parse_attributes() {
+            while (_current.type == token_type::LEFT_BRACKET) {
+                advance();
+                while (_current.type == token_type::ID) {
+                    std::string_view key = _current.text;
+                    advance();
+                    expect(token_type::EQUALS, "'=' in attribute list");
+                    if (_current.type != token_type::ID) {
+                        _tokenizer->fail("expected attribute value");
+                    }
+                    _attributes.push_back(dot_attribute{key, _current.text});
+                    advance();
+                    if (_current.type == token_type::SEMICOLON || _current.type == token_type::COMMA) {
+                        advance();
+                    }
+                }
+                expect(token_type::RIGHT_BRACKET, "']'");
+            }
+        }
+
+        void skip_port() {
+            while (_current.type == token_type::COLON) {
+                advance();
+                expect(token_type::ID, "port");
+            }
+        }
+
+        /**
+         * Parses an edge endpoint, a vertex or a subgraph, into the vertices it stands for.
+         */
+        void parse_endpoint(const scope_defaults& defaults, std::vector<index_type>& into) {
+            if (_current.type == token_type::LEFT_BRACE || detail::is_dot_keyword(_current, "subgraph")) {
+                parse_subgraph(defaults, &into);
+                return;
+            }
+            if (_current.type != token_type::ID) {
+                _tokenizer->fail("expected vertex");
+            }
+            into.push_back(vertex_index(_current.text, defaults));
+            advance();
+            skip_port();
+        }
+
+        void parse_subgraph(const scope_defaults& defaults, std::vector<index_type>* mentioned) {
+            if (detail::is_dot_keyword(_current, "subgraph")) {
+                advance();
+                if (_current.type == token_type::ID) {
+                    advance();
+                }
+            }
+            expect(token_type::LEFT_BRACE, "'{'");
+            scope_defaults inner = defaults;
+            parse_statements(inner, mentioned);
+            expect(token_type::RIGHT_BRACE, "'}'");
+        }
+
+        /**
+         * Parses the rest of an edge statement whose first endpoint is already in \p endpoints.
+         * Each endpoint of the chain is a run of vertices in \p endpoints, delimited by \p runs.
+         * Both are scratch owned by the caller, so that their storage is reused.
+         */
+        void parse_edges(
+            const scope_defaults& defaults,
+            std::vector<index_type>& endpoints,
+            std::vector<std::size_t>& runs,
+            std::vector<index_type>* mentioned
+        ) {
+            runs.assign({0, endpoints.size()});
+            while (_current.type == token_type::EDGE_OPERATOR) {
+                if ((_current.text[1] == '>') != _directed) {
+                    _tokenizer->fail(_directed ? "'--' in a digraph" : "'->' in an undirected graph");
+                }
+                advance();
+                parse_endpoint(defaults, endpoints);
+                runs.push_back(endpoints.size());
+            }
+            _attributes.assign(defaults.edge.begin(), defaults.edge.end());
+            parse_attributes();
+            t_edge edge{};
+            if (_edgeParser != nullptr) {
+                _edgeParser(_attributes, edge);
+            }
+            for (std::size_t run = 0; run + 2 < runs.size(); ++run) {
+                for (std::size_t i = runs[run]; i < runs[run + 1]; ++i) {
+                    for (std::size_t j = runs[run + 1]; j < runs[run + 2]; ++j) {
+                        _builder.add(endpoints[i], endpoints[j], edge);
+                        if (!_directed) {
+                            _builder.add(endpoints[j], endpoints[i], edge);
+                        }
+                    }
+                }
+            }
+            if (mentioned != nullptr) {
+                mentioned->insert(mentioned->end(), endpoints.begin(), endpoints.end());
+            }
+        }
+
+        void parse_statements(scope_defaults& defaults, std::vector<index_type>* mentioned) {
+            std::vector<index_type> tails;
+            std::vector<std::size_t> runs;
+            while (_current.type != token_type::RIGHT_BRACE && _current.type != token_type::END) {
+                bool isNode = detail::is_dot_keyword(_current, "node");
+                bool isEdge = detail::is_dot_keyword(_current, "edge");
+                if (isNode || isEdge || detail::is_dot_keyword(_current, "graph")) {
+                    advance();
+                    if (_current.type == token_type::EQUALS) {
+                        // A graph attribute whose key happens to be a keyword.
+                        advance();
+                        expect(token_type::ID, "attribute value");
+                    }
+                    else {
+                        _attributes.clear();
+                        parse_attributes();
+                        attribute_list& target = isNode ? defaults.node : defaults.edge;
+                        if (isNode || isEdge) {
+                            target.insert(target.end(), _attributes.begin(), _attributes.end());
+                        }
+                    }
+                }
+                else if (_current.type == token_type::LEFT_BRACE || detail::is_dot_keyword(_current, "subgraph")) {
+                    tails.clear();
+                    parse_subgraph(defaults, &tails);
+                    if (_current.type == token_type::EDGE_OPERATOR) {
+                        parse_edges(defaults, tails, runs, mentioned);
+                    }
+                    else if (mentioned != nullptr) {
+                        mentioned->insert(mentioned->end(), tails.begin(), tails.end());
+                    }
+                }
+                else if (_current.type == token_type::ID) {
+                    std::string_view id = _current.text;
+                    advance();
+                    if (_current.type == token_type::EQUALS) {
+                        advance();
+                        expect(token_type::ID, "attribute value");
+                    }
+                    else {
+                        skip_port();
+                        tails.assign(1, vertex_index(id, defaults));
+                        if (_current.type == token_type::EDGE_OPERATOR) {
+                            parse_edges(defaults, tails, runs, mentioned);
+                        }
+                        else {
+                            _attributes.clear();
+                            parse_attributes();
+                            if (_vertexParser != nullptr && !_attributes.empty()) {
+                                _attributes.insert(_attributes.begin(), defaults.node.begin(), defaults.node.end());
+                                _vertexParser(id, _attributes, _vertices[tails.front()]);
+                            }
+                            if (mentioned != nullptr) {
+                                mentioned->push_back(tails.front());
+                            }
+                        }
+                    }
+                }
+                else {
+                    _tokenizer->fail("expected statement");
+                }
+                if (_current.type == token_type::SEMICOLON || _current.type == token_type::COMMA) {
+                    advance();
+                }
+            }
+        }
+
+    public:
+        dot_reader() = default;
+
+        void set_vertex_parser(const vertex_parser& vertexParser) {
+            _vertexParser = vertexParser;
+        }
+
+        void set_edge_parser(const edge_parser& edgeParser) {
+            _edgeParser = edgeParser;
+        }
+
+        /**
+         * Parses one graph from \p text, which must outlive ids().
+         * @throws std::runtime_error on malformed input, with the offending line.
+         */
+        void parse(std::string_view text) {
+            detail::dot_tokenizer tokenizer(text);
+            _tokenizer = &tokenizer;
+            advance();
+            if (detail::is_dot_keyword(_current, "strict")) {
+                advance();
+            }
+            if (detail::is_dot_keyword(_current, "digraph")) {
+                _directed = true;
+            }
+            else if (detail::is_dot_keyword(_current, "graph")) {
+                _directed = false;
+            }
+            else {
+                tokenizer.fail("expected 'graph' or 'digraph'");
+            }
+            advance();
+            if (_current.type == token_type::ID) {
+                advance();
+            }
+            expect(token_type::LEFT_BRACE, "'{'");
+            scope_defaults defaults;
+            parse_statements(defaults, nullptr);
+            expect(token_type::RIGHT_BRACE, "'}'");
+            _tokenizer = nullptr;
+        }
+
+        /**
+         * Maps and parses the file at \p path. Every file parsed stays mapped until the reader
+         * is destroyed, so that ids() remain valid across calls.
+         * @throws std::runtime_error if the file can't be read or is malformed.
+         */
+        void parse_file(const std::filesystem::path& path) {
+            _files.emplace_back(path);
+            const mapped_file& file = _files.back();
+            file.advise_sequential();
+            parse(std::string_view(file.data(), file.size()));
+        }
+
+        bool is_directed() const {
+            return _directed;
+        }
+
+        /**
+         * @returns The identifier of every vertex, by index.
+         */
+        const std::vector<std::string_view>& ids() const {
+            return _ids.ids();
+        }
+
+        /**
+         * @returns The index of the vertex identified by \p id, if any.
+         */
+        bool find(std::string_view id, index_type& index) const {
+            return _ids.find(id, index);
+        }
+
+        /**
+         * @returns The builder holding the edges read so far, to tune how graphs are built.
+         */
+        graph_builder<t_edge, index_type>& builder() {
+            return _builder;
+        }
+
+        /**
+         * Builds a csr_graph out of everything read so far, which is consumed.
+         */
+        csr_graph<t_vertex, t_edge, index_type> build_csr() {
+            return _builder.build_csr(std::move(_vertices));
+        }
+
+        /**
+         * Pushes every vertex read so far into \p graph, which must be empty, and connects
+         * every edge. Both are consumed.
+         */
+        void build_into(adjacency_list<t_vertex, t_edge, index_type>& graph) {
+            graph.reserve(static_cast<index_type>(_vertices.size()));
+            for (t_vertex& vertex : _vertices) {
+                graph.push(std::move(vertex));
+            }
+            _vertices.clear();
+            _builder.build_into(graph);
+        }
+    };
+}
+#endif
@@ -1,19 +1,35 @@
 #ifndef GRAPPHS_GRAPH_WRITER_H
 #define GRAPPHS_GRAPH_WRITER_H
 
+#include <filesystem>
 #include <string>
-#include <sstream>
+#include <string_view>
+#include <ostream>
 #include <functional>
+#include <stdexcept>
+#include <vector>
+#include <grapphs/output_buffer.h>
+#include <grapphs/parallel.h>
 
 namespace gpp {
 
+    /**
+     * Writes graphs in the graphviz DOT format. Output streams through an output_buffer,
+     * straight into a std::ostream or a file, rather than being built in memory first.
+     *
+     * With more than one thread (see set_num_threads), vertices are split into ranges encoded
+     * concurrently into their own buffers, then concatenated in order, so the output does not
+     * depend on the thread count. The writers and predicates are then invoked concurrently, see
+     * gpp::k_default_parallel_grain.
+     */
     template<typename t_graph>
     class graph_writer {
     public:
         using graph_type = std::remove_reference_t<t_graph>;
+        using index_type = typename graph_type::index_type;
         using vertex_writer = std::function<
             void(
-                std::stringstream& stream,
+                std::ostream& stream,
                 typename graph_type::index_type index,
                 const typename graph_type::vertex_type& vertex
             )
@@ -26,7 +42,7 @@ namespace gpp {
         >;
         using edge_writer = std::function<
             void(
-                std::stringstream& stream,
+                std::ostream& stream,
                 typename graph_type::index_type from,
                 typename graph_type::index_type to,
                 const typename graph_type::edge_type& edge
@@ -40,22 +56,83 @@ namespace gpp {
             )
         >;
     private:
+        static constexpr std::string_view k_indentation = "    ";
+        /**
+         * Minimum vertices encoded per range, see gpp::k_default_parallel_grain.
+         */
+        static constexpr std::size_t k_range_grain = 1 << 12;
+
         vertex_writer _vertexWriter;
         edge_writer _edgeWriter;
         vertex_predicate _vertexPredicate;
         edge_predicate _edgePredicate;
         std::vector<std::string> _notes;
+        std::size_t _numThreads = 1;
+
+        void write_vertices(output_buffer& out, const graph_type& graph, const index_type* indices, std::size_t count) const {
+            output_streambuf buffer(out);
+            std::ostream stream(&buffer);
+            for (std::size_t i = 0; i < count; ++i) {
+                index_type index = indices[i];
+                const auto& vertex = *graph.vertex(index);
+                if (_vertexPredicate != nullptr && !_vertexPredicate(index, vertex)) {
+                    continue;
+                }
+                out.write(k_indentation).write(index);
+                _vertexWriter(stream, index, vertex);
+                out.put('\n');
+            }
+        }
+
+        void write_edges(output_buffer& out, const graph_type& graph, const index_type* indices, std::size_t count) const {
+            output_streambuf buffer(out);
+            std::ostream stream(&buffer);
+            for (std::size_t i = 0; i < count; ++i) {
+                index_type fromIndex = indices[i];
+                for (auto [toIndex, edge] : graph.edges_from(fromIndex)) {
+                    if (_edgePredicate != nullptr && !_edgePredicate(fromIndex, toIndex, edge)) {
+                        continue;
+                    }
+                    out.write(k_indentation).write(fromIndex).write(" -> ").write(toIndex);
+                    _edgeWriter(stream, fromIndex, toIndex, edge);
+                    out.put('\n');
+                }
+            }
+        }
+
+        /**
+         * Invokes \p encode(buffer, indices, count) over ranges of \p indices, in parallel when
+         * allowed, and appends the buffers to \p out in order.
+         */
+        template<typename t_encode>
+        void encode_ranges(output_buffer& out, const std::vector<index_type>& indices, const t_encode& encode) const {
+            std::size_t ranges = num_chunks(indices.size(), _numThreads, k_range_grain);
+            if (ranges <= 1) {
+                encode(out, indices.data(), indices.size());
+                return;
+            }
+            std::vector<output_buffer> buffers(ranges);
+            parallel_for(
+                std::size_t(0), indices.size(), [&](std::size_t begin, std::size_t end, std::size_t range) {
+                    encode(buffers[range], indices.data() + begin, end - begin);
+                }, _numThreads, k_range_grain
+            );
+            for (const output_buffer& buffer : buffers) {
+                out.write(buffer.view());
+            }
+        }
+
     public:
         graph_writer() {
             _vertexWriter = [](
-                std::stringstream& stream,
+                std::ostream& stream,
                 typename graph_type::index_type index,
                 const typename graph_type::vertex_type& vertex
             ) {
                 stream << " [shape=box label=\"#" << index << ": " << vertex << '"' << "];";
             };
             _edgeWriter = [](
-                std::stringstream& stream,
+                std::ostream& stream,
                 typename graph_type::index_type from,
                 typename graph_type::index_type to,
                 const typename graph_type::edge_type& edge
@@ -80,55 +157,74 @@ namespace gpp {
             graph_writer::_edgePredicate = edgePredicate;
         }
 
+        /**
+         * Sets how many threads encode, 1 by default and 0 meaning one per hardware thread.
+         * Writers and predicates must be thread safe when this is not 1, see graph_writer.
+         */
+        void set_num_threads(std::size_t numThreads) {
+            _numThreads = numThreads;
+        }
+
         void add_note(const std::string& note) {
             _notes.emplace_back(note);
         }
 
-        std::string to_dot(const graph_type& graph) {
-            std::stringstream stream;
-            stream << "digraph {" << std::endl;
+        void write(output_buffer& out, const graph_type& graph) const {
+            std::vector<index_type> indices;
             for (const auto [index, vertexPtr] : graph.all_vertices()) {
-                if (_vertexPredicate != nullptr && !_vertexPredicate(index, *vertexPtr)) {
-                    continue;
-                }
-                stream << std::string(4, ' ') << index;
-                _vertexWriter(stream, index, *vertexPtr);
-                stream << std::endl;
+                indices.push_back(index);
             }
-            for (auto [fromIndex, vertex] : graph.all_vertices()) {
-                for (auto [toIndex, edge] : graph.edges_from(fromIndex)) {
-                    if (_edgePredicate != nullptr && !_edgePredicate(fromIndex, toIndex, edge)) {
-                        continue;
-                    }
-                    stream << std::string(4, ' ') << fromIndex << " -> " << toIndex;
-                    _edgeWriter(stream, fromIndex, toIndex, edge);
-                    stream << std::endl;
+            out.write("digraph {\n");
+            encode_ranges(
+                out, indices, [&](output_buffer& range, const index_type* first, std::size_t count) {
+                    write_vertices(range, graph, first, count);
                 }
-            }
+            );
+            encode_ranges(
+                out, indices, [&](output_buffer& range, const index_type* first, std::size_t count) {
+                    write_edges(range, graph, first, count);
+                }
+            );
             if (!_notes.empty()) {
-                stream << "subgraph cluster_notes {" << std::endl;
-                stream << "label = \"Notes\";" << std::endl;
-                stream << "shape = rectangle;" << std::endl;
-                stream << "color = black;" << std::endl;
+                out.write("subgraph cluster_notes {\n");
+                out.write("label = \"Notes\";\n");
+                out.write("shape = rectangle;\n");
+                out.write("color = black;\n");
                 for (const auto& note : _notes) {
-                    stream << note << std::endl;
+                    out.write(note).put('\n');
                 }
-                stream << "}" << std::endl;
+                out.write("}\n");
             }
-            stream << "}";
-            return stream.str();
+            out.put('}');
+        }
+
+        void write(std::ostream& stream, const graph_type& graph) const {
+            output_buffer out(stream);
+            write(out, graph);
+            out.close();
+        }
+
+        std::string to_dot(const graph_type& graph) const {
+            output_buffer out;
+            write(out, graph);
+            return std::string(out.view());
         }
 
+        /**
+         * Writes straight into the file at \p outputPath, which is memory mapped where possible.
+         * @returns false if the file can't be written.
+         */
         bool save_to_dot(
             const graph_type& graph,
             const std::filesystem::path& outputPath
-        ) {
-            std::ofstream file(outputPath);
-            if (!file.is_open()) {
+        ) const {
+            try {
+                output_buffer out(outputPath);
+                write(out, graph);
+                out.close();
+            } catch (const std::runtime_error&) {
                 return false;
             }
-            file << to_dot(graph);
-            file.close();
             return true;
         }
     };
@@ -5,6 +5,7 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <random>
 #include <ostream>
 
@@ -74,6 +75,31 @@ void populate(test_graph& graph) {
     }
 }
 
+/**
+ * Reads vertex flags and edge weights from their flags and weight attributes.
+ */
+void set_parsers(gpp::dot_reader<my_vertex, my_edge>& reader) {
+    reader.set_vertex_parser(
+        [](std::string_view, const std::vector<gpp::dot_attribute>& attributes, my_vertex& vertex) {
+            for (const gpp::dot_attribute& attribute : attributes) {
+                int flags;
+                if (attribute.key == "flags" && gpp::parse_dot_number(attribute.value, flags)) {
+                    vertex.flags = static_cast<my_flags>(flags);
+                }
+            }
+        }
+    );
+    reader.set_edge_parser(
+        [](const std::vector<gpp::dot_attribute>& attributes, my_edge& edge) {
+            for (const gpp::dot_attribute& attribute : attributes) {
+                if (attribute.key == "weight") {
+                    gpp::parse_dot_number(attribute.value, edge.weight);
+                }
+            }
+        }
+    );
+}
+
 TEST(grapphs_visualization, to_dot) {
     test_graph graph;
     populate(graph);
@@ -94,4 +120,122 @@ TEST(grapphs_visualization, maze_to_dot) {
         gpp::save_to_dot(maze, std::filesystem::current_path() / name.str());
     });
 
-}
\ No newline at end of file
+}
+
+TEST(grapphs_visualization, parallel_to_dot) {
+    test_graph graph;
+    for (int i = 0; i < 10000; ++i) {
+        graph.push(my_vertex{static_cast<my_flags>(i % 3)});
+        if (i > 0) {
+            graph.connect(i - 1, i, my_edge{static_cast<float>(i)});
+        }
+    }
+    gpp::graph_writer<test_graph> writer;
+    writer.set_edge_writer(
+        [](std::ostream& stream, std::size_t from, std::size_t to, const my_edge& edge) {
+            stream << " [label=\"" << edge << "\"];";
+        }
+    );
+    writer.add_note("note");
+    std::string serial = writer.to_dot(graph);
+    writer.set_num_threads(4);
+    std::stringstream stream;
+    writer.write(stream, graph);
+    EXPECT_EQ(stream.str(), serial);
+    EXPECT_EQ(serial.rfind("digraph {\n    0 [shape=box label=\"#0: flags: 0\"];\n", 0), 0);
+    EXPECT_NE(serial.find("    9998 -> 9999 [label=\"weight: 9999\"];\n"), std::string::npos);
+}
+
+TEST(grapphs_visualization, read_dot) {
+    gpp::dot_reader<my_vertex, my_edge> reader;
+    set_parsers(reader);
+    reader.parse(
+        "/* header */ strict graph \"maze\" {\n"
+        "    rankdir = LR; // comment\n"
+        "    node [flags=2]\n"
+        "    a [flags=4, label=\"say \\\"hi\\\"\"];\n"
+        "    edge [weight=0.5]\n"
+        "    a -- b:n -- \"c\" [weight=1.5]\n"
+        "    subgraph cluster { d; e } -- a\n"
+        "    c -- 7\n"
+        "}\n"
+    );
+    EXPECT_FALSE(reader.is_directed());
+    ASSERT_EQ(reader.ids().size(), 6);
+    EXPECT_EQ(reader.ids()[2], "c");
+    std::size_t seven;
+    ASSERT_TRUE(reader.find("7", seven));
+    EXPECT_EQ(seven, 5);
+
+    test_graph graph;
+    reader.build_into(graph);
+    EXPECT_EQ(graph.vertex(0)->flags, 4);
+    EXPECT_EQ(graph.vertex(1)->flags, 2);
+    EXPECT_EQ(graph.edge(0, 1)->weight, 1.5F);
+    EXPECT_EQ(graph.edge(2, 1)->weight, 1.5F);
+    EXPECT_EQ(graph.edge(3, 0)->weight, 0.5F);
+    EXPECT_EQ(graph.edge(0, 4)->weight, 0.5F);
+    EXPECT_EQ(graph.edge(5, 2)->weight, 0.5F);
+    EXPECT_EQ(graph.edge(0, 2), nullptr);
+
+    gpp::dot_reader<my_vertex, my_edge> invalid;
+    EXPECT_THROW(invalid.parse("digraph {\n a -> \n}"), std::runtime_error);
+    EXPECT_THROW(invalid.parse("digraph { a -- b }"), std::runtime_error);
+}
+
+TEST(grapphs_visualization, dot_round_trip) {
+    test_graph graph;
+    populate(graph);
+    gpp::graph_writer<test_graph> writer;
+    writer.set_vertex_writer(
+        [](std::ostream& stream, std::size_t index, const my_vertex& vertex) {
+            stream << " [flags=" << static_cast<int>(vertex.flags) << "];";
+        }
+    );
+    writer.set_edge_writer(
+        [](std::ostream& stream, std::size_t from, std::size_t to, const my_edge& edge) {
+            stream << " [weight=" << edge.weight << "];";
+        }
+    );
+    writer.add_note("note");
+    auto outputPath = std::filesystem::current_path() / "round_trip.dot";
+    ASSERT_TRUE(writer.save_to_dot(graph, outputPath));
+
+    gpp::dot_reader<my_vertex, my_edge> reader;
+    set_parsers(reader);
+    reader.parse_file(outputPath);
+    ASSERT_TRUE(reader.is_directed());
+    auto csr = reader.build_csr();
+    // The note is a vertex of its own in the notes cluster.
+    ASSERT_EQ(csr.size(), graph.size() + 1);
+    EXPECT_EQ(reader.ids().back(), "note");
+    for (std::size_t i = 0; i < graph.size(); ++i) {
+        EXPECT_EQ(*csr.vertex(i), *graph.vertex(i));
+        for (auto [to, edge] : graph.edges_from(i)) {
+            ASSERT_NE(csr.edge(i, to), nullptr);
+            EXPECT_NEAR(csr.edge(i, to)->weight, edge.weight, 1e-5F);
+        }
+    }
+}
+
+TEST(grapphs_visualization, read_dot_files) {
+    auto firstPath = std::filesystem::temp_directory_path() / "grapphs_first.dot";
+    auto secondPath = std::filesystem::temp_directory_path() / "grapphs_second.dot";
+    std::ofstream(firstPath) << "digraph { a -> b [weight=2] }\n";
+    std::ofstream(secondPath) << "digraph { b -> c [weight=3] }\n";
+
+    gpp::dot_reader<my_vertex, my_edge> reader;
+    set_parsers(reader);
+    reader.parse_file(firstPath);
+    reader.parse_file(secondPath);
+    // Identifiers read from the first file outlive the second
+    ASSERT_EQ(reader.ids().size(), 3);
+    EXPECT_EQ(reader.ids()[0], "a");
+    EXPECT_EQ(reader.ids()[1], "b");
+    EXPECT_EQ(reader.ids()[2], "c");
+    auto graph = reader.build_csr();
+    EXPECT_EQ(graph.edge(0, 1)->weight, 2.0F);
+    EXPECT_EQ(graph.edge(1, 2)->weight, 3.0F);
+    std::filesystem::remove(firstPath);
+    std::filesystem::remove(secondPath);
+}
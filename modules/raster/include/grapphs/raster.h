@@ -0,0 +1,414 @@
+#ifndef GRAPPHS_RASTER_H
+#define GRAPPHS_RASTER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <vector>
+#include <grapphs/adjacency_list.h>
+#include <grapphs/parallel.h>
+
+namespace gpp {
+
+    struct raster_color {
+        std::uint8_t r = 0, g = 0, b = 0, a = 255;
+
+        static raster_color black() {
+            return raster_color{0, 0, 0, 255};
+        }
+
+        static raster_color white() {
+            return raster_color{255, 255, 255, 255};
+        }
+    };
+
+    struct raster_attributes {
+        raster_color color = raster_color::black();
+        /**
+         * Vertex radius or edge width, in viewbox units.
+         */
+        float size = 1;
+    };
+
+    /**
+     * Region of the plane, in the units of the position functor, mapped onto the image.
+     */
+    struct raster_viewbox {
+        float minX, minY, width, height;
+
+        static raster_viewbox centralized(float width, float height) {
+            return raster_viewbox{-width / 2, -height / 2, width, height};
+        }
+    };
+
+    /**
+     * Straight, non premultiplied, RGBA8 image.
+     */
+    class framebuffer {
+    private:
+        std::size_t _width = 0;
+        std::size_t _height = 0;
+        std::vector<std::uint8_t> _pixels;
+
+        void blend_span(std::size_t row, std::size_t first, std::size_t count, const float* coverage, const raster_color& color);
+
+    public:
+        framebuffer() = default;
+
+        framebuffer(std::size_t width, std::size_t height, raster_color background = raster_color::white());
+
+        std::size_t width() const;
+
+        std::size_t height() const;
+
+        /**
+         * @returns The pixels row by row, top row first, 4 bytes per pixel.
+         */
+        const std::uint8_t* data() const;
+
+        std::uint8_t* data();
+
+        raster_color pixel(std::size_t x, std::size_t y) const;
+
+        void fill(raster_color color);
+
+        /**
+         * Draws an anti-aliased line from (x0, y0) to (x1, y1), in pixels, restricted to the
+         * rows [rowBegin, rowEnd). Coverage is computed from the distance of each pixel center
+         * to the segment, over whole spans at once so that it vectorizes.
+         */
+        void draw_line(
+            float x0, float y0, float x1, float y1, float width, const raster_color& color,
+            std::size_t rowBegin = 0, std::size_t rowEnd = SIZE_MAX
+        );
+
+        /**
+         * Draws an anti-aliased disc centered at (x, y), in pixels, restricted to the rows
+         * [rowBegin, rowEnd).
+         */
+        void draw_disc(
+            float x, float y, float radius, const raster_color& color,
+            std::size_t rowBegin = 0, std::size_t rowEnd = SIZE_MAX
+        );
+
+        /**
+         * Saves as a binary PPM (P6), dropping alpha.
+         * @throws std::runtime_error if the file can't be written.
+         */
+        void save_ppm(const std::filesystem::path& path) const;
+
+        /**
+         * Saves as a PAM (P7) with an RGB_ALPHA tuple type.
+         * @throws std::runtime_error if the file can't be written.
+         */
+        void save_pam(const std::filesystem::path& path) const;
+
+        /**
+         * Saves as a PNG made of stored (uncompressed) deflate blocks, which any decoder reads
+         * without pulling in a compression library. Files are about as large as the PAM.
+         * @throws std::runtime_error if the file can't be written.
+         */
+        void save_png(const std::filesystem::path& path) const;
+    };
+
+    enum class raster_writer_flags : std::uint8_t {
+        DRAW_VERTICES = 1 << 0,
+        DRAW_EDGES = 1 << 1
+    };
+
+    inline raster_writer_flags operator|(raster_writer_flags lhs, raster_writer_flags rhs) {
+        return static_cast<raster_writer_flags>(static_cast<std::uint8_t>(lhs) | static_cast<std::uint8_t>(rhs));
+    }
+
+    /**
+     * Draws a graph straight into a framebuffer, for graphs too large for SVG. Mirrors
+     * svg_writer: vertices and edges are placed by a position functor, then filtered and
+     * styled by callbacks.
+     *
+     * Vertices are drawn before edges, each in index order. The image is split into bands of
+     * rows rendered concurrently (see set_num_threads), each band drawing the primitives
+     * overlapping it in that same order, so the image does not depend on the thread count.
+     * The callbacks are then invoked concurrently, see gpp::k_default_parallel_grain.
+     */
+    template<typename t_graph>
+    class raster_writer {
+    public:
+        using index_type = typename t_graph::index_type;
+        using vertex_type = typename t_graph::vertex_type;
+        using edge_type = typename t_graph::edge_type;
+
+        using position_functor = std::function<
+            void(
+                index_type i, const vertex_type& vertex, float& x, float& y
+            )
+        >;
+
+        using vertex_filter = std::function<
+            bool(
+                index_type i, const vertex_type& vertex
+            )
+        >;
+
+        using edge_filter = std::function<
+            bool(
+                index_type from, index_type to, const edge_type& edgeType
+            )
+        >;
+
+        template<typename TElement> using customizer = std::function<
+            void(
+                const TElement& entry, raster_attributes& attributes
+            )
+        >;
+
+        using vertex_customizer = customizer<vertex_type>;
+        using edge_customizer = customizer<edge_type>;
+
+    private:
+        /**
+         * Rows per band, small enough for bands to balance well across threads and for the
+         * rows of a band to stay in cache.
+         */
+        static constexpr std::size_t k_band_height = 32;
+        /**
+         * Minimum vertices positioned per chunk, see gpp::k_default_parallel_grain.
+         */
+        static constexpr std::size_t k_chunk_grain = 1 << 12;
+
+        struct primitive {
+            float x0, y0, x1, y1;
+            float size;
+            raster_color color;
+            bool disc;
+        };
+
+        raster_viewbox _viewBox;
+        std::size_t _width;
+        std::size_t _height;
+        raster_color _background = raster_color::white();
+        float _nodeRadius = 1;
+        raster_writer_flags _flags = raster_writer_flags::DRAW_VERTICES | raster_writer_flags::DRAW_EDGES;
+        std::size_t _numThreads = 1;
+        position_functor _positionFunctor;
+        vertex_filter _vertexFilter;
+        edge_filter _edgeFilter;
+        vertex_customizer _vertexCustomizer;
+        edge_customizer _edgeCustomizer;
+
+        bool test_flags(raster_writer_flags flags) const {
+            return (static_cast<std::uint8_t>(_flags) & static_cast<std::uint8_t>(flags))
+                   == static_cast<std::uint8_t>(flags);
+        }
+
+        bool visible(float minX, float minY, float maxX, float maxY) const {
+            return maxX >= -1 && minX <= static_cast<float>(_width) + 1
+                   && maxY >= -1 && minY <= static_cast<float>(_height) + 1;
+        }
+
+        /**
+         * Collects the primitives of the vertices (or edges) leaving [begin, end), in pixels.
+         * Removed vertices, and edges pointing to them, are skipped.
+         */
+        void collect(
+            const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph,
+            const std::vector<float>& xs,
+            const std::vector<float>& ys,
+            float scale,
+            bool edges,
+            std::size_t begin,
+            std::size_t end,
+            std::vector<primitive>& into
+        ) const {
+            for (index_type i = begin; i < end; ++i) {
+                if (graph.is_removed(i)) {
+                    continue;
+                }
+                if (!edges) {
+                    const vertex_type& vertex = *graph.vertex(i);
+                    if (_vertexFilter != nullptr && !_vertexFilter(i, vertex)) {
+                        continue;
+                    }
+                    raster_attributes attributes;
+                    attributes.size = _nodeRadius;
+                    if (_vertexCustomizer != nullptr) {
+                        _vertexCustomizer(vertex, attributes);
+                    }
+                    float radius = attributes.size * scale;
+                    if (visible(xs[i] - radius, ys[i] - radius, xs[i] + radius, ys[i] + radius)) {
+                        into.push_back(primitive{xs[i], ys[i], xs[i], ys[i], radius, attributes.color, true});
+                    }
+                    continue;
+                }
+                for (const auto& [j, edge] : graph.edges_from(i)) {
+                    if (graph.is_removed(j)) {
+                        continue;
+                    }
+                    if (_edgeFilter != nullptr && !_edgeFilter(i, j, edge)) {
+                        continue;
+                    }
+                    raster_attributes attributes;
+                    attributes.size = _nodeRadius;
+                    if (_edgeCustomizer != nullptr) {
+                        _edgeCustomizer(edge, attributes);
+                    }
+                    float width = attributes.size * scale;
+                    float margin = width / 2;
+                    if (visible(
+                        std::min(xs[i], xs[j]) - margin, std::min(ys[i], ys[j]) - margin,
+                        std::max(xs[i], xs[j]) + margin, std::max(ys[i], ys[j]) + margin
+                    )) {
+                        into.push_back(primitive{xs[i], ys[i], xs[j], ys[j], width, attributes.color, false});
+                    }
+                }
+            }
+        }
+
+    public:
+        /**
+         * Renders \p viewBox into a \p width by \p height image. The viewbox is stretched if
+         * its aspect ratio differs from the image's, and sizes are scaled horizontally.
+         */
+        raster_writer(
+            raster_viewbox viewBox,
+            std::size_t width,
+            std::size_t height,
+            const position_functor& positionFunctor
+        ) : _viewBox(viewBox), _width(width), _height(height), _positionFunctor(positionFunctor) {
+        }
+
+        void set_background(raster_color background) {
+            _background = background;
+        }
+
+        void set_node_radius(float nodeRadius) {
+            _nodeRadius = nodeRadius;
+        }
+
+        void set_flags(raster_writer_flags flags) {
+            _flags = flags;
+        }
+
+        /**
+         * Sets how many threads render, 1 by default and 0 meaning one per hardware thread.
+         * Callbacks must be thread safe when this is not 1, see raster_writer.
+         */
+        void set_num_threads(std::size_t numThreads) {
+            _numThreads = numThreads;
+        }
+
+        void set_vertex_filter(const vertex_filter& vertexFilter) {
+            _vertexFilter = vertexFilter;
+        }
+
+        void set_edge_filter(const edge_filter& edgeFilter) {
+            _edgeFilter = edgeFilter;
+        }
+
+        void set_vertex_customizer(const vertex_customizer& vertexCustomizer) {
+            _vertexCustomizer = vertexCustomizer;
+        }
+
+        void set_edge_customizer(const edge_customizer& edgeCustomizer) {
+            _edgeCustomizer = edgeCustomizer;
+        }
+
+        framebuffer render(const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph) const {
+            framebuffer image(_width, _height, _background);
+            // Positions are indexed by vertex index, so removed vertices leave unused slots behind.
+            std::size_t numVertices = graph.index_bound();
+            float scaleX = static_cast<float>(_width) / _viewBox.width;
+            float scaleY = static_cast<float>(_height) / _viewBox.height;
+
+            std::vector<float> xs(numVertices), ys(numVertices);
+            parallel_for(
+                std::size_t(0), numVertices, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (index_type i = begin; i < end; ++i) {
+                        if (graph.is_removed(i)) {
+                            continue;
+                        }
+                        float x, y;
+                        _positionFunctor(i, *graph.vertex(i), x, y);
+                        xs[i] = (x - _viewBox.minX) * scaleX;
+                        ys[i] = (y - _viewBox.minY) * scaleY;
+                    }
+                }, _numThreads, k_chunk_grain
+            );
+
+            // Primitives are collected per chunk, then concatenated in drawing order.
+            std::vector<primitive> primitives;
+            for (bool edges : {false, true}) {
+                if (!test_flags(edges ? raster_writer_flags::DRAW_EDGES : raster_writer_flags::DRAW_VERTICES)) {
+                    continue;
+                }
+                std::vector<std::vector<primitive>> chunks(num_chunks(numVertices, _numThreads, k_chunk_grain));
+                parallel_for(
+                    std::size_t(0), numVertices, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+                        collect(graph, xs, ys, scaleX, edges, begin, end, chunks[chunk]);
+                    }, _numThreads, k_chunk_grain
+                );
+                for (std::vector<primitive>& chunk : chunks) {
+                    primitives.insert(primitives.end(), chunk.begin(), chunk.end());
+                    chunk = std::vector<primitive>();
+                }
+            }
+
+            // Bins the primitives by the bands of rows they overlap, keeping their order.
+            std::size_t numBands = (_height + k_band_height - 1) / k_band_height;
+            if (numBands == 0) {
+                return image;
+            }
+            auto bandRange = [&](const primitive& p) {
+                float reach = p.size / 2 + 1;
+                if (p.disc) {
+                    reach = p.size + 1;
+                }
+                float top = std::max(std::min(p.y0, p.y1) - reach, 0.0F);
+                float bottom = std::max(std::max(p.y0, p.y1) + reach, 0.0F);
+                std::size_t first = std::min(static_cast<std::size_t>(top) / k_band_height, numBands - 1);
+                std::size_t last = std::min(static_cast<std::size_t>(bottom) / k_band_height, numBands - 1);
+                return std::make_pair(first, last);
+            };
+            std::vector<std::size_t> offsets(numBands + 1, 0);
+            for (const primitive& p : primitives) {
+                auto [first, last] = bandRange(p);
+                for (std::size_t band = first; band <= last; ++band) {
+                    offsets[band + 1]++;
+                }
+            }
+            for (std::size_t band = 0; band < numBands; ++band) {
+                offsets[band + 1] += offsets[band];
+            }
+            std::vector<std::size_t> binned(offsets.back());
+            std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (std::size_t k = 0; k < primitives.size(); ++k) {
+                auto [first, last] = bandRange(primitives[k]);
+                for (std::size_t band = first; band <= last; ++band) {
+                    binned[cursor[band]++] = k;
+                }
+            }
+
+            parallel_for(
+                std::size_t(0), numBands, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t band = begin; band < end; ++band) {
+                        std::size_t rowBegin = band * k_band_height;
+                        std::size_t rowEnd = std::min(rowBegin + k_band_height, _height);
+                        for (std::size_t k = offsets[band]; k < offsets[band + 1]; ++k) {
+                            const primitive& p = primitives[binned[k]];
+                            if (p.disc) {
+                                image.draw_disc(p.x0, p.y0, p.size, p.color, rowBegin, rowEnd);
+                            }
+                            else {
+                                image.draw_line(p.x0, p.y0, p.x1, p.y1, p.size, p.color, rowBegin, rowEnd);
+                            }
+                        }
+                    }
+                }, _numThreads, 1
+            );
+            return image;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,300 @@
+#include <grapphs/raster.h>
+#include <grapphs/output_buffer.h>
+
+#include <array>
+#include <string>
+
+namespace gpp {
+
+    /**
+     * Pixels whose coverage is evaluated at once, sized so the scratch stays on the stack.
+     */
+    constexpr std::size_t k_span_block = 256;
+
+    /**
+     * Largest payload of a stored deflate block.
+     */
+    constexpr std::size_t k_max_stored_block = 65535;
+
+    constexpr std::uint32_t k_adler_modulo = 65521;
+    constexpr std::size_t k_adler_run = 5552;
+
+    framebuffer::framebuffer(
+        std::size_t width,
+        std::size_t height,
+        raster_color background
+    ) : _width(width), _height(height), _pixels(width * height * 4) {
+        fill(background);
+    }
+
+    std::size_t framebuffer::width() const {
+        return _width;
+    }
+
+    std::size_t framebuffer::height() const {
+        return _height;
+    }
+
+    const std::uint8_t* framebuffer::data() const {
+        return _pixels.data();
+    }
+
+    std::uint8_t* framebuffer::data() {
+        return _pixels.data();
+    }
+
+    raster_color framebuffer::pixel(std::size_t x, std::size_t y) const {
+        const std::uint8_t* p = &_pixels[(y * _width + x) * 4];
+        return raster_color{p[0], p[1], p[2], p[3]};
+    }
+
+    void framebuffer::fill(raster_color color) {
+        for (std::size_t i = 0; i < _pixels.size(); i += 4) {
+            _pixels[i] = color.r;
+            _pixels[i + 1] = color.g;
+            _pixels[i + 2] = color.b;
+            _pixels[i + 3] = color.a;
+        }
+    }
+
+    void framebuffer::blend_span(
+        std::size_t row,
+        std::size_t first,
+        std::size_t count,
+        const float* coverage,
+        const raster_color& color
+    ) {
+        std::uint8_t* pixels = &_pixels[(row * _width + first) * 4];
+        float source[4] = {
+            static_cast<float>(color.r),
+            static_cast<float>(color.g),
+            static_cast<float>(color.b),
+            255.0F
+        };
+        float opacity = static_cast<float>(color.a) / 255.0F;
+        for (std::size_t i = 0; i < count; ++i) {
+            float alpha = coverage[i] * opacity;
+            for (std::size_t channel = 0; channel < 4; ++channel) {
+                float destination = pixels[i * 4 + channel];
+                pixels[i * 4 + channel] = static_cast<std::uint8_t>(
+                    destination + (source[channel] - destination) * alpha + 0.5F
+                );
+            }
+        }
+    }
+
+    void framebuffer::draw_line(
+        float x0, float y0, float x1, float y1, float width, const raster_color& color,
+        std::size_t rowBegin, std::size_t rowEnd
+    ) {
+        float halfWidth = width / 2;
+        // Pixels up to one past the edge of the line are partially covered.
+        float reach = halfWidth + 1;
+        float dx = x1 - x0;
+        float dy = y1 - y0;
+        float squaredLength = dx * dx + dy * dy;
+        float inverseSquaredLength = squaredLength > 0 ? 1 / squaredLength : 0;
+        float length = std::sqrt(squaredLength);
+        float minX = std::min(x0, x1) - reach;
+        float maxX = std::max(x0, x1) + reach;
+
+        rowEnd = std::min(rowEnd, _height);
+        float top = std::max(std::min(y0, y1) - reach, static_cast<float>(rowBegin));
+        float bottom = std::min(std::max(y0, y1) + reach, static_cast<float>(rowEnd));
+        if (!(top < bottom) || _width == 0) {
+            return;
+        }
+        float coverage[k_span_block];
+        for (auto row = static_cast<std::size_t>(top); row < static_cast<std::size_t>(std::ceil(bottom)); ++row) {
+            float py = static_cast<float>(row) + 0.5F;
+            float spanMin = minX;
+            float spanMax = maxX;
+            // Unless the line is almost horizontal, only a narrow span around where it
+            // crosses the row can be covered.
+            if (std::abs(dy) * 1024 > length) {
+                float crossing = x0 + (py - y0) * dx / dy;
+                float halfSpan = reach * length / std::abs(dy);
+                spanMin = std::max(spanMin, crossing - halfSpan);
+                spanMax = std::min(spanMax, crossing + halfSpan);
+            }
+            spanMin = std::max(spanMin, 0.0F);
+            spanMax = std::min(spanMax, static_cast<float>(_width) - 1);
+            if (spanMin > spanMax) {
+                continue;
+            }
+            auto first = static_cast<std::size_t>(spanMin);
+            auto last = static_cast<std::size_t>(spanMax) + 1;
+            for (std::size_t block = first; block < last; block += k_span_block) {
+                std::size_t count = std::min(k_span_block, last - block);
+                // Kept free of branches so that it is vectorized.
+                for (std::size_t i = 0; i < count; ++i) {
+                    float ax = static_cast<float>(block + i) + 0.5F - x0;
+                    float ay = py - y0;
+                    float t = std::clamp((ax * dx + ay * dy) * inverseSquaredLength, 0.0F, 1.0F);
+                    float ex = ax - t * dx;
+                    float ey = ay - t * dy;
+                    float distance = std::sqrt(ex * ex + ey * ey);
+                    coverage[i] = std::clamp(halfWidth + 0.5F - distance, 0.0F, 1.0F);
+                }
+                blend_span(row, block, count, coverage, color);
+            }
+        }
+    }
+
+    void framebuffer::draw_disc(
+        float x, float y, float radius, const raster_color& color,
+        std::size_t rowBegin, std::size_t rowEnd
+    ) {
+        float reach = radius + 1;
+        rowEnd = std::min(rowEnd, _height);
+        float top = std::max(y - reach, static_cast<float>(rowBegin));
+        float bottom = std::min(y + reach, static_cast<float>(rowEnd));
+        float spanMin = std::max(x - reach, 0.0F);
+        float spanMax = std::min(x + reach, static_cast<float>(_width) - 1);
+        if (!(top < bottom) || spanMin > spanMax) {
+            return;
+        }
+        auto first = static_cast<std::size_t>(spanMin);
+        auto last = static_cast<std::size_t>(spanMax) + 1;
+        float coverage[k_span_block];
+        for (auto row = static_cast<std::size_t>(top); row < static_cast<std::size_t>(std::ceil(bottom)); ++row) {
+            float ay = static_cast<float>(row) + 0.5F - y;
+            for (std::size_t block = first; block < last; block += k_span_block) {
+                std::size_t count = std::min(k_span_block, last - block);
+                for (std::size_t i = 0; i < count; ++i) {
+                    float ax = static_cast<float>(block + i) + 0.5F - x;
+                    float distance = std::sqrt(ax * ax + ay * ay);
+                    coverage[i] = std::clamp(radius + 0.5F - distance, 0.0F, 1.0F);
+                }
+                blend_span(row, block, count, coverage, color);
+            }
+        }
+    }
+
+    void framebuffer::save_ppm(const std::filesystem::path& path) const {
+        output_buffer out(path);
+        out.write("P6\n").write(_width).put(' ').write(_height).write("\n255\n");
+        for (std::size_t i = 0; i < _pixels.size(); i += 4) {
+            out.put(static_cast<char>(_pixels[i]))
+               .put(static_cast<char>(_pixels[i + 1]))
+               .put(static_cast<char>(_pixels[i + 2]));
+        }
+        out.close();
+    }
+
+    void framebuffer::save_pam(const std::filesystem::path& path) const {
+        output_buffer out(path);
+        out.write("P7\nWIDTH ").write(_width)
+           .write("\nHEIGHT ").write(_height)
+           .write("\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n");
+        out.write(std::string_view(reinterpret_cast<const char*>(_pixels.data()), _pixels.size()));
+        out.close();
+    }
+
+    namespace {
+        std::array<std::uint32_t, 256> make_crc_table() {
+            std::array<std::uint32_t, 256> table{};
+            for (std::uint32_t n = 0; n < 256; ++n) {
+                std::uint32_t c = n;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) != 0 ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+                }
+                table[n] = c;
+            }
+            return table;
+        }
+
+        std::uint32_t crc32(std::uint32_t crc, const std::uint8_t* data, std::size_t size) {
+            static const std::array<std::uint32_t, 256> table = make_crc_table();
+            crc = ~crc;
+            for (std::size_t i = 0; i < size; ++i) {
+                crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            }
+            return ~crc;
+        }
+
+        void put_big_endian(std::vector<std::uint8_t>& into, std::uint32_t value) {
+            into.push_back(static_cast<std::uint8_t>(value >> 24));
+            into.push_back(static_cast<std::uint8_t>(value >> 16));
+            into.push_back(static_cast<std::uint8_t>(value >> 8));
+            into.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        /**
+         * Writes a chunk whose type and payload are in \p chunk, starting with the type.
+         */
+        void write_png_chunk(output_buffer& out, const std::vector<std::uint8_t>& chunk) {
+            std::vector<std::uint8_t> length;
+            put_big_endian(length, static_cast<std::uint32_t>(chunk.size() - 4));
+            std::vector<std::uint8_t> crc;
+            put_big_endian(crc, crc32(0, chunk.data(), chunk.size()));
+            out.write(std::string_view(reinterpret_cast<const char*>(length.data()), length.size()));
+            out.write(std::string_view(reinterpret_cast<const char*>(chunk.data()), chunk.size()));
+            out.write(std::string_view(reinterpret_cast<const char*>(crc.data()), crc.size()));
+        }
+    }
+
+    void framebuffer::save_png(const std::filesystem::path& path) const {
+        output_buffer out(path);
+        out.write("\x89PNG\r\n\x1A\n");
+
+        std::vector<std::uint8_t> chunk = {'I', 'H', 'D', 'R'};
+        put_big_endian(chunk, static_cast<std::uint32_t>(_width));
+        put_big_endian(chunk, static_cast<std::uint32_t>(_height));
+        // 8 bits per channel, RGBA, deflate, adaptive filtering, no interlacing.
+        chunk.insert(chunk.end(), {8, 6, 0, 0, 0});
+        write_png_chunk(out, chunk);
+
+        // Each scanline is preceded by its filter type, 0 (none), and the whole stream is cut
+        // into stored deflate blocks, one per IDAT chunk.
+        std::size_t rowBytes = _width * 4 + 1;
+        std::size_t total = rowBytes * _height;
+        std::uint32_t adlerA = 1;
+        std::uint32_t adlerB = 0;
+        std::size_t position = 0;
+        do {
+            std::size_t blockSize = std::min(k_max_stored_block, total - position);
+            bool last = position + blockSize == total;
+            chunk.assign({'I', 'D', 'A', 'T'});
+            if (position == 0) {
+                // zlib header: deflate with a 32K window, no dictionary, fastest level.
+                chunk.insert(chunk.end(), {0x78, 0x01});
+            }
+            chunk.push_back(last ? 1 : 0);
+            chunk.push_back(static_cast<std::uint8_t>(blockSize));
+            chunk.push_back(static_cast<std::uint8_t>(blockSize >> 8));
+            chunk.push_back(static_cast<std::uint8_t>(~blockSize));
+            chunk.push_back(static_cast<std::uint8_t>(~blockSize >> 8));
+            for (std::size_t end = position + blockSize; position < end;) {
+                std::size_t row = position / rowBytes;
+                std::size_t column = position % rowBytes;
+                std::size_t count = std::min(end - position, rowBytes - column);
+                std::size_t pixelCount = count;
+                if (column == 0) {
+                    chunk.push_back(0);
+                    pixelCount--;
+                }
+                const std::uint8_t* rowData = _pixels.data() + row * _width * 4 + (column == 0 ? 0 : column - 1);
+                chunk.insert(chunk.end(), rowData, rowData + pixelCount);
+                position += count;
+            }
+            // The sums can't overflow within k_adler_run bytes, so they are reduced once per run.
+            for (std::size_t run = chunk.size() - blockSize; run < chunk.size(); run += k_adler_run) {
+                std::size_t runEnd = std::min(run + k_adler_run, chunk.size());
+                for (std::size_t i = run; i < runEnd; ++i) {
+                    adlerA += chunk[i];
+                    adlerB += adlerA;
+                }
+                adlerA %= k_adler_modulo;
+                adlerB %= k_adler_modulo;
+            }
+            if (last) {
+                put_big_endian(chunk, (adlerB << 16) | adlerA);
+            }
+            write_png_chunk(out, chunk);
+        } while (position < total);
+
+        write_png_chunk(out, {'I', 'E', 'N', 'D'});
+        out.close();
+    }
+}
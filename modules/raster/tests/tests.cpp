@@ -0,0 +1,206 @@
+#include <grapphs/raster.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+typedef gpp::adjacency_list<int, float> test_graph;
+typedef gpp::raster_writer<test_graph> test_writer;
+
+namespace {
+
+    std::vector<std::uint8_t> read_file(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    std::uint32_t read_big_endian(const std::uint8_t* data) {
+        return (std::uint32_t(data[0]) << 24) | (std::uint32_t(data[1]) << 16)
+               | (std::uint32_t(data[2]) << 8) | std::uint32_t(data[3]);
+    }
+
+    /**
+     * Bitwise CRC-32, independent from the table driven one of the writer.
+     */
+    std::uint32_t reference_crc32(const std::uint8_t* data, std::size_t size) {
+        std::uint32_t crc = 0xFFFFFFFFU;
+        for (std::size_t i = 0; i < size; ++i) {
+            crc ^= data[i];
+            for (int k = 0; k < 8; ++k) {
+                crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1)));
+            }
+        }
+        return ~crc;
+    }
+
+    /**
+     * Vertices on a spiral, each connected to the next and to the one 97 further.
+     */
+    test_graph make_spiral(int numVertices) {
+        test_graph graph;
+        for (int i = 0; i < numVertices; ++i) {
+            graph.push(i);
+        }
+        for (int i = 0; i + 1 < numVertices; ++i) {
+            graph.connect(i, i + 1, 1.0F);
+            graph.connect(i, (i + 97) % numVertices, 2.0F);
+        }
+        return graph;
+    }
+
+    test_writer make_writer(std::size_t width, std::size_t height) {
+        test_writer writer(
+            gpp::raster_viewbox::centralized(2, 2), width, height, [](
+                std::size_t i, const int&, float& x, float& y
+            ) {
+                float angle = static_cast<float>(i) * 0.01F;
+                float radius = 0.9F * static_cast<float>(i % 1000) / 1000.0F;
+                x = radius * std::cos(angle);
+                y = radius * std::sin(angle);
+            }
+        );
+        writer.set_node_radius(0.01F);
+        writer.set_edge_customizer(
+            [](const float& edge, gpp::raster_attributes& attributes) {
+                attributes.color = gpp::raster_color{static_cast<std::uint8_t>(edge * 100), 0, 128, 200};
+                attributes.size = 0.005F * edge;
+            }
+        );
+        return writer;
+    }
+}
+
+TEST(grapphs_raster, band_count_independence) {
+    // More vertices than a chunk, and a height that isn't a whole number of bands
+    test_graph graph = make_spiral(10000);
+    test_writer writer = make_writer(300, 250);
+    gpp::framebuffer single = writer.render(graph);
+    for (std::size_t numThreads : {2, 3, 8}) {
+        writer.set_num_threads(numThreads);
+        gpp::framebuffer banded = writer.render(graph);
+        ASSERT_EQ(banded.width(), single.width());
+        ASSERT_EQ(banded.height(), single.height());
+        std::size_t size = single.width() * single.height() * 4;
+        EXPECT_TRUE(std::equal(single.data(), single.data() + size, banded.data())) << numThreads << " threads";
+    }
+}
+
+TEST(grapphs_raster, removed_vertices) {
+    test_graph graph;
+    for (int i = 0; i < 3; ++i) {
+        graph.push(i);
+    }
+    graph.connect(0, 2, 1.0F);
+    graph.connect(0, 1, 1.0F);
+    graph.remove(1);
+    test_writer writer(
+        gpp::raster_viewbox{0, 0, 10, 10}, 10, 10, [](std::size_t i, const int&, float& x, float& y) {
+            x = 1.5F + 3 * static_cast<float>(i);
+            y = i == 1 ? 7.5F : 1.5F;
+        }
+    );
+    writer.set_node_radius(0.5F);
+    gpp::framebuffer image = writer.render(graph);
+    EXPECT_NE(image.pixel(1, 1).r, 255);
+    EXPECT_NE(image.pixel(4, 1).r, 255);
+    EXPECT_NE(image.pixel(7, 1).r, 255);
+    // The removed vertex is not drawn, and the dangling edge towards it neither
+    EXPECT_EQ(image.pixel(4, 7).r, 255);
+    EXPECT_EQ(image.pixel(3, 4).r, 255);
+}
+
+TEST(grapphs_raster, ppm) {
+    gpp::framebuffer image(3, 2);
+    image.draw_disc(0.5F, 0.5F, 0.5F, gpp::raster_color{10, 20, 30, 255});
+    auto path = std::filesystem::temp_directory_path() / "grapphs_raster.ppm";
+    image.save_ppm(path);
+
+    std::vector<std::uint8_t> file = read_file(path);
+    std::string header = "P6\n3 2\n255\n";
+    ASSERT_EQ(file.size(), header.size() + 3 * 2 * 3);
+    EXPECT_EQ(std::string(file.begin(), file.begin() + header.size()), header);
+    for (std::size_t i = 0; i < 3 * 2; ++i) {
+        for (std::size_t channel = 0; channel < 3; ++channel) {
+            EXPECT_EQ(file[header.size() + i * 3 + channel], image.data()[i * 4 + channel]);
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(grapphs_raster, png) {
+    // Large enough to span several stored deflate blocks
+    test_graph graph = make_spiral(2000);
+    gpp::framebuffer image = make_writer(200, 120).render(graph);
+    auto path = std::filesystem::temp_directory_path() / "grapphs_raster.png";
+    image.save_png(path);
+
+    std::vector<std::uint8_t> file = read_file(path);
+    const std::uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    ASSERT_GT(file.size(), sizeof(signature));
+    ASSERT_TRUE(std::equal(std::begin(signature), std::end(signature), file.begin()));
+
+    std::vector<std::string> types;
+    std::vector<std::uint8_t> stream;
+    for (std::size_t offset = sizeof(signature); offset < file.size();) {
+        ASSERT_LE(offset + 12, file.size());
+        std::uint32_t length = read_big_endian(&file[offset]);
+        ASSERT_LE(offset + 12 + length, file.size());
+        const std::uint8_t* typeAndData = &file[offset + 4];
+        std::string type(typeAndData, typeAndData + 4);
+        EXPECT_EQ(read_big_endian(typeAndData + 4 + length), reference_crc32(typeAndData, 4 + length)) << type;
+        if (type == "IHDR") {
+            ASSERT_EQ(length, 13);
+            EXPECT_EQ(read_big_endian(typeAndData + 4), 200);
+            EXPECT_EQ(read_big_endian(typeAndData + 8), 120);
+            // 8 bits per channel, RGBA
+            EXPECT_EQ(typeAndData[12], 8);
+            EXPECT_EQ(typeAndData[13], 6);
+        }
+        else if (type == "IDAT") {
+            stream.insert(stream.end(), typeAndData + 4, typeAndData + 4 + length);
+        }
+        types.push_back(type);
+        offset += 12 + length;
+    }
+    ASSERT_GE(types.size(), 4);
+    EXPECT_EQ(types.front(), "IHDR");
+    EXPECT_EQ(types.back(), "IEND");
+
+    // Inflates the stored blocks and checks the Adler-32 trailer
+    ASSERT_GE(stream.size(), 6);
+    EXPECT_EQ((stream[0] * 256 + stream[1]) % 31, 0);
+    std::vector<std::uint8_t> inflated;
+    std::size_t position = 2;
+    bool last = false;
+    while (!last) {
+        ASSERT_LE(position + 5, stream.size());
+        last = (stream[position] & 1) != 0;
+        ASSERT_EQ(stream[position] >> 1, 0) << "Only stored blocks are expected";
+        std::uint16_t length = stream[position + 1] | (stream[position + 2] << 8);
+        std::uint16_t complement = stream[position + 3] | (stream[position + 4] << 8);
+        ASSERT_EQ(static_cast<std::uint16_t>(~length), complement);
+        position += 5;
+        ASSERT_LE(position + length, stream.size());
+        inflated.insert(inflated.end(), stream.begin() + position, stream.begin() + position + length);
+        position += length;
+    }
+    ASSERT_EQ(position + 4, stream.size());
+    std::uint32_t a = 1, b = 0;
+    for (std::uint8_t byte : inflated) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    EXPECT_EQ(read_big_endian(&stream[position]), (b << 16) | a);
+
+    std::size_t rowBytes = image.width() * 4;
+    ASSERT_EQ(inflated.size(), (rowBytes + 1) * image.height());
+    for (std::size_t row = 0; row < image.height(); ++row) {
+        const std::uint8_t* scanline = &inflated[row * (rowBytes + 1)];
+        EXPECT_EQ(scanline[0], 0);
+        EXPECT_TRUE(std::equal(scanline + 1, scanline + 1 + rowBytes, image.data() + row * rowBytes)) << row;
+    }
+    std::filesystem::remove(path);
+}
@@ -5,9 +5,17 @@
 #ifndef GRAPPHS_SVG_H
 #define GRAPPHS_SVG_H
 
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <map>
 #include <ostream>
+#include <tuple>
 #include <functional>
+#include <vector>
 #include <grapphs/adjacency_list.h>
+#include <grapphs/output_buffer.h>
+#include <grapphs/parallel.h>
 
 namespace gpp {
     struct svg_viewbox {
@@ -23,9 +31,24 @@ namespace gpp {
     enum svg_writer_flags : std::uint8_t {
         VERBOSE = 1 << 0,
         DRAW_VERTICES = 1 << 1,
-        DRAW_EDGES = 1 << 2
+        DRAW_EDGES = 1 << 2,
+        /**
+         * Skips vertices and edges which lie entirely outside of the viewbox. Off by default,
+         * always on for tiles, see svg_writer::write_tiles.
+         */
+        CULL_TO_VIEWBOX = 1 << 3,
+        /**
+         * Draws the edges of each style as a single <path>, chaining edges which share a
+         * vertex into polylines and dropping points which are collinear at the output
+         * precision. Edges lose their direction, so a->b and b->a are only drawn once.
+         */
+        MERGE_EDGES = 1 << 4
     };
 
+    inline svg_writer_flags operator|(svg_writer_flags lhs, svg_writer_flags rhs) {
+        return static_cast<svg_writer_flags>(static_cast<std::uint8_t>(lhs) | static_cast<std::uint8_t>(rhs));
+    }
+
     union svg_color {
         struct {
             uint8_t r, g, b, a;
@@ -49,6 +72,14 @@ namespace gpp {
         friend std::ostream& operator<<(std::ostream& os, const svg_attributes& attributes);
     };
 
+    /**
+     * Writes a graph as an SVG document, or as a pyramid of tiles, see write_tiles().
+     *
+     * With more than one thread (see set_num_threads), the vertex range is split into chunks
+     * rendered concurrently into their own buffers, which are then concatenated in order, so
+     * the output is the same as with a single thread. The position functor, filters and
+     * customizers are then invoked concurrently, see gpp::k_default_parallel_grain.
+     */
     template<typename t_graph>
     class svg_writer {
     public:
@@ -85,19 +116,559 @@ namespace gpp {
     private:
         svg_viewbox _viewBox;
         float _nodeRadius = 1;
-        svg_writer_flags _flags = static_cast<svg_writer_flags>(
-            svg_writer_flags::DRAW_EDGES | svg_writer_flags::DRAW_VERTICES
-        );
+        int _precision = 2;
+        float _minEdgeLength = 0;
+        std::size_t _numThreads = 1;
+        svg_writer_flags _flags = svg_writer_flags::DRAW_EDGES | svg_writer_flags::DRAW_VERTICES;
         position_functor _positionFunctor;
         vertex_filter _vertexFilter;
         edge_filter _edgeFilter;
         vertex_customizer _vertexCustomizer;
         edge_customizer _edgeCustomizer;
-
-        bool test_flags(svg_writer_flags flags) {
+        /**
+         * Vertices rendered, in order, when only some of them are, as in tiles. All of them
+         * when null.
+         */
+        const index_type* _renderedVertices = nullptr;
+        std::size_t _numRenderedVertices = 0;
+
+        /**
+         * Minimum vertices rendered per chunk, see gpp::k_default_parallel_grain.
+         */
+        static constexpr std::size_t k_chunk_grain = 1 << 12;
+
+        bool test_flags(svg_writer_flags flags) const {
             return (_flags & flags) == flags;
         }
 
+        /**
+         * @returns How many vertices are rendered, out of the \p numVertices positioned.
+         */
+        std::size_t num_rendered(std::size_t numVertices) const {
+            return _renderedVertices == nullptr ? numVertices : _numRenderedVertices;
+        }
+
+        /**
+         * @returns The index of the \p k th vertex rendered.
+         */
+        index_type rendered_vertex(std::size_t k) const {
+            return _renderedVertices == nullptr ? static_cast<index_type>(k) : _renderedVertices[k];
+        }
+
+        /**
+         * @returns Whether the box from (minX, minY) to (maxX, maxY), grown by \p margin,
+         * touches the viewbox. Always true unless culling is enabled.
+         */
+        bool visible(float minX, float minY, float maxX, float maxY, float margin) const {
+            if (!test_flags(svg_writer_flags::CULL_TO_VIEWBOX)) {
+                return true;
+            }
+            return maxX + margin >= _viewBox.minX
+                   && minX - margin <= _viewBox.minX + _viewBox.width
+                   && maxY + margin >= _viewBox.minY
+                   && minY - margin <= _viewBox.minY + _viewBox.height;
+        }
+
+        /**
+         * Half of the smallest step representable at the output precision.
+         */
+        float tolerance() const {
+            return 0.5F * std::pow(10.0F, static_cast<float>(-_precision));
+        }
+
+        /**
+         * Invokes \p render(buffer, begin, end) over chunks of [0, \p count), in parallel when
+         * allowed, and appends the buffers to \p out in order.
+         */
+        template<typename t_render>
+        void render_chunks(output_buffer& out, std::size_t count, std::size_t grain, const t_render& render) const {
+            std::size_t chunks = num_chunks(count, _numThreads, grain);
+            if (chunks <= 1) {
+                render(out, 0, count);
+                return;
+            }
+            std::vector<output_buffer> buffers(chunks);
+            parallel_for(
+                std::size_t(0), count, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+                    render(buffers[chunk], begin, end);
+                }, _numThreads, grain
+            );
+            for (const output_buffer& buffer : buffers) {
+                out.write(buffer.view());
+            }
+        }
+
+        /**
+         * Invokes \p visit(from, to, attributes) for every edge between live vertices leaving
+         * the rendered vertices [\p begin, \p end) which passes the filter, is at least the minimum length long and, when culling,
+         * touches the viewbox.
+         */
+        template<typename t_visit>
+        void visit_edges(
+            const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph,
+            const std::vector<float>& xs,
+            const std::vector<float>& ys,
+            std::size_t begin,
+            std::size_t end,
+            const t_visit& visit
+        ) const {
+            for (std::size_t k = begin; k < end; ++k) {
+                index_type i = rendered_vertex(k);
+                if (graph.is_removed(i)) {
+                    continue;
+                }
+                for (const auto& [j, edge] : graph.edges_from(i)) {
+                    if (graph.is_removed(j)) {
+                        continue;
+                    }
+                    if (_edgeFilter != nullptr && !_edgeFilter(i, j, edge)) {
+                        continue;
+                    }
+                    float dx = xs[j] - xs[i];
+                    float dy = ys[j] - ys[i];
+                    if (_minEdgeLength > 0 && dx * dx + dy * dy < _minEdgeLength * _minEdgeLength) {
+                        continue;
+                    }
+                    svg_attributes attributes;
+                    attributes.size = _nodeRadius;
+
+                    if (_edgeCustomizer != nullptr) {
+                        _edgeCustomizer(edge, attributes);
+                    }
+                    if (!visible(
+                        std::min(xs[i], xs[j]), std::min(ys[i], ys[j]),
+                        std::max(xs[i], xs[j]), std::max(ys[i], ys[j]),
+                        attributes.size / 2
+                    )) {
+                        continue;
+                    }
+                    visit(i, j, attributes);
+                }
+            }
+        }
+
+        void write_lines(
+            output_buffer& out,
+            const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph,
+            const std::vector<float>& xs,
+            const std::vector<float>& ys
+        ) const {
+            bool verbose = test_flags(svg_writer_flags::VERBOSE);
+            render_chunks(
+                out, num_rendered(xs.size()), k_chunk_grain, [&](output_buffer& chunk, std::size_t begin, std::size_t end) {
+                    visit_edges(
+                        graph, xs, ys, begin, end, [&](index_type i, index_type j, const svg_attributes& attributes) {
+                            if (verbose) {
+                                chunk.write("<!-- ").write(i).put('-').write(j).write(" --> \n");
+                            }
+                            chunk.write("<line x1=\"").write(xs[i], _precision)
+                                 .write("\" y1=\"").write(ys[i], _precision)
+                                 .write("\" x2=\"").write(xs[j], _precision)
+                                 .write("\" y2=\"").write(ys[j], _precision)
+                                 .write("\" stroke=\"");
+                            write_color(chunk, attributes.color);
+                            chunk.write("\" stroke-width=\"").write(attributes.size, _precision).write("\"/>\n");
+                        }
+                    );
+                }
+            );
+        }
+
+        struct styled_segment {
+            std::size_t style;
+            index_type a;
+            index_type b;
+
+            bool operator<(const styled_segment& other) const {
+                return std::tie(style, a, b) < std::tie(other.style, other.a, other.b);
+            }
+
+            bool operator==(const styled_segment& other) const {
+                return style == other.style && a == other.a && b == other.b;
+            }
+        };
+
+        void write_paths(
+            output_buffer& out,
+            const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph,
+            const std::vector<float>& xs,
+            const std::vector<float>& ys
+        ) const {
+            using style_map = std::map<std::pair<std::uint32_t, float>, std::size_t>;
+            struct chunk_segments {
+                std::vector<svg_attributes> styles;
+                style_map styleIndices;
+                std::vector<styled_segment> segments;
+            };
+            std::size_t numRendered = num_rendered(xs.size());
+            std::vector<chunk_segments> chunks(num_chunks(numRendered, _numThreads, k_chunk_grain));
+            parallel_for(
+                std::size_t(0), numRendered, [&](std::size_t begin, std::size_t end, std::size_t chunkIndex) {
+                    chunk_segments& chunk = chunks[chunkIndex];
+                    visit_edges(
+                        graph, xs, ys, begin, end, [&](index_type i, index_type j, const svg_attributes& attributes) {
+                            auto [found, inserted] = chunk.styleIndices.emplace(
+                                std::make_pair(attributes.color.rgba32, attributes.size), chunk.styles.size()
+                            );
+                            if (inserted) {
+                                chunk.styles.push_back(attributes);
+                            }
+                            chunk.segments.push_back(styled_segment{found->second, std::min(i, j), std::max(i, j)});
+                        }
+                    );
+                }, _numThreads, k_chunk_grain
+            );
+
+            // Styles are numbered per chunk, renumber them in order of first appearance.
+            std::vector<svg_attributes> styles;
+            style_map styleIndices;
+            std::vector<styled_segment> segments;
+            for (chunk_segments& chunk : chunks) {
+                std::vector<std::size_t> remap(chunk.styles.size());
+                for (std::size_t local = 0; local < chunk.styles.size(); ++local) {
+                    const svg_attributes& attributes = chunk.styles[local];
+                    auto [found, inserted] = styleIndices.emplace(
+                        std::make_pair(attributes.color.rgba32, attributes.size), styles.size()
+                    );
+                    if (inserted) {
+                        styles.push_back(attributes);
+                    }
+                    remap[local] = found->second;
+                }
+                for (styled_segment& segment : chunk.segments) {
+                    segment.style = remap[segment.style];
+                    segments.push_back(segment);
+                }
+                chunk = chunk_segments();
+            }
+            std::sort(segments.begin(), segments.end());
+            segments.erase(std::unique(segments.begin(), segments.end()), segments.end());
+
+            // Segments touching each endpoint, so that chains can be followed from either end.
+            // Endpoints are numbered densely, so that tiles only pay for the vertices they show.
+            std::vector<index_type> endpoints;
+            endpoints.reserve(2 * segments.size());
+            for (const styled_segment& segment : segments) {
+                endpoints.push_back(segment.a);
+                endpoints.push_back(segment.b);
+            }
+            std::sort(endpoints.begin(), endpoints.end());
+            endpoints.erase(std::unique(endpoints.begin(), endpoints.end()), endpoints.end());
+            auto endpointOf = [&](index_type vertex) {
+                return static_cast<std::size_t>(
+                    std::lower_bound(endpoints.begin(), endpoints.end(), vertex) - endpoints.begin()
+                );
+            };
+            std::vector<std::size_t> offsets(endpoints.size() + 1, 0);
+            for (const styled_segment& segment : segments) {
+                offsets[endpointOf(segment.a) + 1]++;
+                offsets[endpointOf(segment.b) + 1]++;
+            }
+            for (std::size_t v = 0; v < endpoints.size(); ++v) {
+                offsets[v + 1] += offsets[v];
+            }
+            std::vector<std::size_t> incident(offsets.back());
+            std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (std::size_t s = 0; s < segments.size(); ++s) {
+                incident[cursor[endpointOf(segments[s].a)]++] = s;
+                incident[cursor[endpointOf(segments[s].b)]++] = s;
+            }
+
+            // Chains never leave their style, so styles are rendered concurrently.
+            std::vector<char> used(segments.size(), false);
+            float epsilon = tolerance();
+            auto nextSegment = [&](index_type vertex, std::size_t style) -> std::size_t {
+                std::size_t endpoint = endpointOf(vertex);
+                for (std::size_t k = offsets[endpoint]; k < offsets[endpoint + 1]; ++k) {
+                    std::size_t s = incident[k];
+                    if (segments[s].style == style && !used[s]) {
+                        return s;
+                    }
+                }
+                return segments.size();
+            };
+
+            std::vector<std::size_t> styleStarts;
+            for (std::size_t s = 0; s < segments.size(); ++s) {
+                if (s == 0 || segments[s].style != segments[s - 1].style) {
+                    styleStarts.push_back(s);
+                }
+            }
+            styleStarts.push_back(segments.size());
+
+            render_chunks(
+                out, styleStarts.size() - 1, 1, [&](output_buffer& chunk, std::size_t begin, std::size_t end) {
+                    for (std::size_t group = begin; group < end; ++group) {
+                        std::size_t first = styleStarts[group];
+                        std::size_t style = segments[first].style;
+                        const svg_attributes& attributes = styles[style];
+                        chunk.write("<path fill=\"none\" stroke=\"");
+                        write_color(chunk, attributes.color);
+                        chunk.write("\" stroke-width=\"").write(attributes.size, _precision).write("\" d=\"");
+
+                        for (std::size_t start = first; start < styleStarts[group + 1]; ++start) {
+                            if (used[start]) {
+                                continue;
+                            }
+                            // Coordinate pairs following a moveto are implicit linetos, so only
+                            // the start of each chain needs a command.
+                            index_type anchor = segments[start].a;
+                            index_type pending = segments[start].b;
+                            used[start] = true;
+                            chunk.write(start == first ? "M" : " M").write(xs[anchor], _precision)
+                                 .put(' ').write(ys[anchor], _precision);
+                            for (std::size_t s = nextSegment(pending, style);
+                                 s < segments.size();
+                                 s = nextSegment(pending, style)) {
+                                used[s] = true;
+                                index_type next = segments[s].a == pending ? segments[s].b : segments[s].a;
+                                if (!is_redundant(xs, ys, anchor, pending, next, epsilon)) {
+                                    chunk.put(' ').write(xs[pending], _precision)
+                                         .put(' ').write(ys[pending], _precision);
+                                    anchor = pending;
+                                }
+                                pending = next;
+                            }
+                            chunk.put(' ').write(xs[pending], _precision).put(' ').write(ys[pending], _precision);
+                        }
+                        chunk.write("\"/>\n");
+                    }
+                }
+            );
+        }
+
+        /**
+         * @returns Whether \p middle can be dropped from the polyline anchor, middle, next:
+         * it is closer to \p anchor than the minimum edge length, or lies on the segment
+         * from \p anchor to \p next within \p epsilon.
+         */
+        bool is_redundant(
+            const std::vector<float>& xs,
+            const std::vector<float>& ys,
+            index_type anchor,
+            index_type middle,
+            index_type next,
+            float epsilon
+        ) const {
+            float mx = xs[middle] - xs[anchor];
+            float my = ys[middle] - ys[anchor];
+            if (_minEdgeLength > 0 && mx * mx + my * my < _minEdgeLength * _minEdgeLength) {
+                return true;
+            }
+            float nx = xs[next] - xs[anchor];
+            float ny = ys[next] - ys[anchor];
+            float squaredLength = nx * nx + ny * ny;
+            float along = mx * nx + my * ny;
+            if (along < 0 || along > squaredLength) {
+                return false;
+            }
+            float cross = mx * ny - my * nx;
+            return cross * cross <= epsilon * epsilon * squaredLength;
+        }
+
+        void compute_positions(
+            const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph,
+            std::vector<float>& xs,
+            std::vector<float>& ys
+        ) const {
+            // Positions are computed once per vertex, rather than once per incident edge. They are
+            // indexed by vertex index, so removed vertices leave unused slots behind.
+            std::size_t numVertices = graph.index_bound();
+            xs.assign(numVertices, 0);
+            ys.assign(numVertices, 0);
+            parallel_for(
+                std::size_t(0), numVertices, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (index_type i = begin; i < end; i++) {
+                        if (!graph.is_removed(i)) {
+                            _positionFunctor(i, *graph.vertex(i), xs[i], ys[i]);
+                        }
+                    }
+                }, _numThreads, k_chunk_grain
+            );
+        }
+
+        void write_vertices(
+            output_buffer& out,
+            const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph,
+            const std::vector<float>& xs,
+            const std::vector<float>& ys
+        ) const {
+            bool verbose = test_flags(svg_writer_flags::VERBOSE);
+            render_chunks(
+                out, num_rendered(xs.size()), k_chunk_grain, [&](output_buffer& chunk, std::size_t begin, std::size_t end) {
+                    for (std::size_t k = begin; k < end; k++) {
+                        index_type i = rendered_vertex(k);
+                        if (graph.is_removed(i)) {
+                            continue;
+                        }
+                        const vertex_type& vertex = *graph.vertex(i);
+                        if (_vertexFilter != nullptr && !_vertexFilter(i, vertex)) {
+                            continue;
+                        }
+
+                        svg_attributes attributes;
+                        attributes.size = _nodeRadius;
+
+                        if (_vertexCustomizer != nullptr) {
+                            _vertexCustomizer(vertex, attributes);
+                        }
+
+                        if (!visible(xs[i], ys[i], xs[i], ys[i], attributes.size)) {
+                            continue;
+                        }
+
+                        if (verbose) {
+                            chunk.write("<!-- ").write(i).write(" --> \n");
+                        }
+
+                        chunk.write("<circle cx=\"").write(xs[i], _precision)
+                             .write("\" cy=\"").write(ys[i], _precision)
+                             .write("\" r=\"").write(attributes.size, _precision)
+                             .write("\" fill=\"");
+                        write_color(chunk, attributes.color);
+                        chunk.write("\"/>\n");
+                    }
+                }
+            );
+        }
+
+        /**
+         * Bins the vertices by the tiles of the \p tilesPerSide by \p tilesPerSide grid over the
+         * viewbox that they, or any edge leaving them, may show in. Each tile gets a superset
+         * of the vertices culling would keep, in index order, so that it renders the same as
+         * if the whole graph was culled to it. Vertices of tile t are
+         * binned[offsets[t]] to binned[offsets[t + 1]], tiles being numbered row by row.
+         */
+        void bin_tiles(
+            const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph,
+            const std::vector<float>& xs,
+            const std::vector<float>& ys,
+            std::size_t tilesPerSide,
+            std::vector<std::size_t>& offsets,
+            std::vector<index_type>& binned
+        ) const {
+            float tileWidth = _viewBox.width / static_cast<float>(tilesPerSide);
+            float tileHeight = _viewBox.height / static_cast<float>(tilesPerSide);
+            // Boxes are padded a little, so that rounding never drops a tile culling would keep
+            float padX = tileWidth * 1e-3F;
+            float padY = tileHeight * 1e-3F;
+            auto tileRange = [&](float min, float max, float viewMin, float tileSize, float pad) {
+                float first = std::floor((min - pad - viewMin) / tileSize);
+                float last = std::floor((max + pad - viewMin) / tileSize);
+                auto limit = static_cast<float>(tilesPerSide - 1);
+                return std::make_pair(
+                    static_cast<std::size_t>(std::clamp(first, 0.0F, limit)),
+                    last < 0 || first > limit ? std::size_t(0) : static_cast<std::size_t>(std::min(last, limit)) + 1
+                );
+            };
+            bool drawVertices = test_flags(svg_writer_flags::DRAW_VERTICES);
+            bool drawEdges = test_flags(svg_writer_flags::DRAW_EDGES);
+
+            // (tile, vertex) pairs, per chunk of vertices so that they stay in index order
+            std::size_t numVertices = xs.size();
+            std::vector<std::vector<std::pair<std::size_t, index_type>>> chunks(
+                num_chunks(numVertices, _numThreads, k_chunk_grain)
+            );
+            parallel_for(
+                std::size_t(0), numVertices, [&](std::size_t begin, std::size_t end, std::size_t chunkIndex) {
+                    auto& chunk = chunks[chunkIndex];
+                    std::vector<std::size_t> tiles;
+                    auto addBox = [&](float minX, float minY, float maxX, float maxY, float margin) {
+                        auto [firstX, endX] = tileRange(minX - margin, maxX + margin, _viewBox.minX, tileWidth, padX);
+                        auto [firstY, endY] = tileRange(minY - margin, maxY + margin, _viewBox.minY, tileHeight, padY);
+                        for (std::size_t y = firstY; y < endY; ++y) {
+                            for (std::size_t x = firstX; x < endX; ++x) {
+                                tiles.push_back(y * tilesPerSide + x);
+                            }
+                        }
+                    };
+                    for (index_type i = begin; i < end; ++i) {
+                        if (graph.is_removed(i)) {
+                            continue;
+                        }
+                        tiles.clear();
+                        const vertex_type& vertex = *graph.vertex(i);
+                        if (drawVertices && (_vertexFilter == nullptr || _vertexFilter(i, vertex))) {
+                            svg_attributes attributes;
+                            attributes.size = _nodeRadius;
+                            if (_vertexCustomizer != nullptr) {
+                                _vertexCustomizer(vertex, attributes);
+                            }
+                            addBox(xs[i], ys[i], xs[i], ys[i], attributes.size);
+                        }
+                        if (drawEdges) {
+                            for (const auto& [j, edge] : graph.edges_from(i)) {
+                                if (graph.is_removed(j) || (_edgeFilter != nullptr && !_edgeFilter(i, j, edge))) {
+                                    continue;
+                                }
+                                svg_attributes attributes;
+                                attributes.size = _nodeRadius;
+                                if (_edgeCustomizer != nullptr) {
+                                    _edgeCustomizer(edge, attributes);
+                                }
+                                addBox(
+                                    std::min(xs[i], xs[j]), std::min(ys[i], ys[j]),
+                                    std::max(xs[i], xs[j]), std::max(ys[i], ys[j]),
+                                    attributes.size / 2
+                                );
+                            }
+                        }
+                        std::sort(tiles.begin(), tiles.end());
+                        tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+                        for (std::size_t tile : tiles) {
+                            chunk.emplace_back(tile, i);
+                        }
+                    }
+                }, _numThreads, k_chunk_grain
+            );
+
+            offsets.assign(tilesPerSide * tilesPerSide + 1, 0);
+            for (const auto& chunk : chunks) {
+                for (const auto& [tile, vertex] : chunk) {
+                    offsets[tile + 1]++;
+                }
+            }
+            for (std::size_t tile = 0; tile + 1 < offsets.size(); ++tile) {
+                offsets[tile + 1] += offsets[tile];
+            }
+            binned.resize(offsets.back());
+            std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (const auto& chunk : chunks) {
+                for (const auto& [tile, vertex] : chunk) {
+                    binned[cursor[tile]++] = vertex;
+                }
+            }
+        }
+
+        void write_document(
+            output_buffer& out,
+            const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph,
+            const std::vector<float>& xs,
+            const std::vector<float>& ys
+        ) const {
+            out.write("<svg viewBox=\"").write(_viewBox.minX, _precision)
+               .put(' ').write(_viewBox.minY, _precision)
+               .put(' ').write(_viewBox.width, _precision)
+               .put(' ').write(_viewBox.height, _precision)
+               .write("\" xmlns=\"http://www.w3.org/2000/svg\">\n");
+            if (test_flags(svg_writer_flags::DRAW_VERTICES)) {
+                write_vertices(out, graph, xs, ys);
+            }
+            if (test_flags(svg_writer_flags::DRAW_EDGES)) {
+                if (test_flags(svg_writer_flags::MERGE_EDGES)) {
+                    write_paths(out, graph, xs, ys);
+                }
+                else {
+                    write_lines(out, graph, xs, ys);
+                }
+            }
+            out.write("</svg>\n");
+        }
+
+        static void write_color(output_buffer& out, const svg_color& color) {
+            out.put('#').write_hex(color.r).write_hex(color.g).write_hex(color.b);
+        }
+
     public:
         svg_writer(
             svg_viewbox viewBox, const position_functor& positionFunctor
@@ -108,6 +679,30 @@ namespace gpp {
             _nodeRadius = nodeRadius;
         }
 
+        /**
+         * Sets the maximum number of decimals of coordinates and sizes, 2 by default.
+         */
+        void set_precision(int precision) {
+            _precision = precision;
+        }
+
+        /**
+         * Sets the length under which edges are not drawn, typically the size of a pixel in
+         * viewbox units. When merging edges, points closer than this to the previous point of
+         * their polyline are dropped instead. 0, the default, draws everything.
+         */
+        void set_min_edge_length(float minEdgeLength) {
+            _minEdgeLength = minEdgeLength;
+        }
+
+        /**
+         * Sets how many threads render, 1 by default and 0 meaning one per hardware thread.
+         * Callbacks must be thread safe when this is not 1, see svg_writer.
+         */
+        void set_num_threads(std::size_t numThreads) {
+            _numThreads = numThreads;
+        }
+
         void set_flags(svg_writer_flags flags) {
             _flags = flags;
         }
@@ -131,67 +726,86 @@ namespace gpp {
         void write(
             std::ostream& os, const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph
         ) {
-            bool verbose = test_flags(svg_writer_flags::VERBOSE);
-            os << "<svg viewBox=\"" << _viewBox.minX << " " << _viewBox.minY << " "
-               << _viewBox.width << " " << _viewBox.height
-               << R"(" xmlns="http://www.w3.org/2000/svg">)" << std::endl;
-
-            if (test_flags(svg_writer_flags::DRAW_VERTICES)) {
-                for (index_type i = 0; i < graph.size(); i++) {
-                    const vertex_type& vertex = *graph.vertex(i);
-                    if (_vertexFilter != nullptr && !_vertexFilter(i, vertex)) {
-                        continue;
-                    }
-
-                    float x, y;
-                    _positionFunctor(i, vertex, x, y);
-
-                    if (verbose) {
-                        os << "<!-- " << i << " --> " << std::endl;
-                    }
+            output_buffer out(os);
+            write(out, graph);
+            out.close();
+        }
 
-                    svg_attributes attributes;
-                    attributes.size = _nodeRadius;
+        /**
+         * Writes straight into the file at \p path, which is memory mapped where possible.
+         */
+        void write(
+            const std::filesystem::path& path, const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph
+        ) {
+            output_buffer out(path);
+            write(out, graph);
+            out.close();
+        }
 
-                    if (_vertexCustomizer != nullptr) {
-                        _vertexCustomizer(vertex, attributes);
-                    }
+        void write(
+            output_buffer& out, const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph
+        ) {
+            std::vector<float> xs, ys;
+            compute_positions(graph, xs, ys);
+            write_document(out, graph, xs, ys);
+        }
 
-                    os << "<circle cx=\"" << x << "\" cy=\"" << y << "\" r=\"" << attributes.size
-                       << "\" fill=\"" << attributes.color << "\"/> " << std::endl;
+        /**
+         * Writes the graph as a pyramid of tiles for slippy map viewers, into
+         * \p directory/z/x/y.svg for every zoom level z from \p minZoom to \p maxZoom. Zoom
+         * level z splits the viewbox into 2^z by 2^z tiles, each written with its own viewbox
+         * and culled to it. The minimum edge length is divided by 2^z, so that deeper levels
+         * show more detail. Vertices are binned by tile once per level, so that each tile only
+         * goes through the vertices and edges it may show. Tiles are written concurrently, see
+         * set_num_threads().
+         * @throws std::runtime_error if a tile can't be written.
+         */
+        void write_tiles(
+            const std::filesystem::path& directory,
+            const gpp::adjacency_list<vertex_type, edge_type, index_type>& graph,
+            std::size_t maxZoom,
+            std::size_t minZoom = 0
+        ) {
+            std::vector<float> xs, ys;
+            compute_positions(graph, xs, ys);
+            for (std::size_t zoom = minZoom; zoom <= maxZoom; ++zoom) {
+                std::size_t tilesPerSide = std::size_t(1) << zoom;
+                for (std::size_t x = 0; x < tilesPerSide; ++x) {
+                    std::filesystem::create_directories(
+                        directory / std::to_string(zoom) / std::to_string(x)
+                    );
                 }
-            }
-            if (test_flags(svg_writer_flags::DRAW_EDGES)) {
-                for (index_type i = 0; i < graph.size(); ++i) {
-                    const vertex_type& fromVertex = *graph.vertex(i);
-
-                    float x1, y1;
-                    _positionFunctor(i, fromVertex, x1, y1);
-                    for (const auto& [j, edge] : graph.edges_from(i)) {
-                        float x2, y2;
-                        const vertex_type& toVertex = *graph.vertex(j);
-
-                        if (_edgeFilter != nullptr && !_edgeFilter(i, j, edge)) {
-                            continue;
+                float tileWidth = _viewBox.width / static_cast<float>(tilesPerSide);
+                float tileHeight = _viewBox.height / static_cast<float>(tilesPerSide);
+                std::vector<std::size_t> offsets;
+                std::vector<index_type> binned;
+                bin_tiles(graph, xs, ys, tilesPerSide, offsets, binned);
+                parallel_for(
+                    std::size_t(0), tilesPerSide * tilesPerSide, [&](std::size_t begin, std::size_t end, std::size_t) {
+                        for (std::size_t tile = begin; tile < end; ++tile) {
+                            std::size_t x = tile % tilesPerSide;
+                            std::size_t y = tile / tilesPerSide;
+                            svg_writer tileWriter = *this;
+                            tileWriter._viewBox = svg_viewbox(
+                                _viewBox.minX + static_cast<float>(x) * tileWidth,
+                                _viewBox.minY + static_cast<float>(y) * tileHeight,
+                                tileWidth,
+                                tileHeight
+                            );
+                            tileWriter._minEdgeLength = _minEdgeLength / static_cast<float>(tilesPerSide);
+                            tileWriter._flags = _flags | svg_writer_flags::CULL_TO_VIEWBOX;
+                            tileWriter._numThreads = 1;
+                            tileWriter._renderedVertices = binned.data() + offsets[tile];
+                            tileWriter._numRenderedVertices = offsets[tile + 1] - offsets[tile];
+                            output_buffer out(
+                                directory / std::to_string(zoom) / std::to_string(x) / (std::to_string(y) + ".svg")
+                            );
+                            tileWriter.write_document(out, graph, xs, ys);
+                            out.close();
                         }
-
-                        _positionFunctor(j, toVertex, x2, y2);
-                        if (verbose) {
-                            os << "<!-- " << i << "-" << j << " --> " << std::endl;
-                        }
-                        svg_attributes attributes;
-                        attributes.size = _nodeRadius;
-
-                        if (_edgeCustomizer != nullptr) {
-                            _edgeCustomizer(edge, attributes);
-                        }
-                        os << "<line x1=\"" << x1 << "\" y1=\"" << y1 << "\" x2=\"" << x2
-                           << "\" y2=\"" << y2 << "\" stroke=\"" << attributes.color
-                           << "\" stroke-width=\"" << attributes.size << "\"/>" << std::endl;
-                    }
-                }
+                    }, _numThreads, 1
+                );
             }
-            os << "</svg>" << std::endl;
         }
     };
 
@@ -0,0 +1,223 @@
+#include <grapphs/svg.h>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+typedef gpp::adjacency_list<int, float> test_graph;
+typedef gpp::svg_writer<test_graph> test_writer;
+
+namespace {
+
+    const char* const k_header = "<svg viewBox=\"0 0 10 10\" xmlns=\"http://www.w3.org/2000/svg\">\n";
+
+    /**
+     * Graph whose vertex i lies at points[i], connected by \p edges.
+     */
+    struct placed_graph {
+        test_graph graph;
+        std::vector<std::pair<float, float>> points;
+
+        placed_graph(
+            std::vector<std::pair<float, float>> vertexPoints,
+            const std::vector<std::pair<int, int>>& edges
+        ) : points(std::move(vertexPoints)) {
+            for (std::size_t i = 0; i < points.size(); ++i) {
+                graph.push(static_cast<int>(i));
+            }
+            for (const auto& [from, to] : edges) {
+                graph.connect(from, to, 1.0F);
+            }
+        }
+
+        test_writer writer(gpp::svg_writer_flags flags) const {
+            test_writer result(
+                gpp::svg_viewbox(0, 0, 10, 10), [this](std::size_t i, const int&, float& x, float& y) {
+                    x = points[i].first;
+                    y = points[i].second;
+                }
+            );
+            result.set_flags(flags);
+            return result;
+        }
+    };
+
+    std::string write(test_writer& writer, const test_graph& graph) {
+        std::ostringstream stream;
+        writer.write(stream, graph);
+        return stream.str();
+    }
+
+    std::string merged_path(const std::string& d) {
+        return std::string(k_header) + "<path fill=\"none\" stroke=\"#000000\" stroke-width=\"1\" d=\"" + d + "\"/>\n</svg>\n";
+    }
+
+    std::string line(float x1, float y1, float x2, float y2) {
+        std::ostringstream stream;
+        stream << "<line x1=\"" << x1 << "\" y1=\"" << y1 << "\" x2=\"" << x2 << "\" y2=\"" << y2
+               << "\" stroke=\"#000000\" stroke-width=\"1\"/>\n";
+        return stream.str();
+    }
+
+    const gpp::svg_writer_flags k_merged = gpp::svg_writer_flags::DRAW_EDGES | gpp::svg_writer_flags::MERGE_EDGES;
+}
+
+TEST(grapphs_svg, merge_line) {
+    // Chained into one polyline, whose inner points are collinear and dropped
+    placed_graph line({{0, 0}, {1, 0}, {2, 0}, {3, 0}, {4, 0}}, {{0, 1}, {1, 2}, {3, 2}, {3, 4}});
+    test_writer writer = line.writer(k_merged);
+    EXPECT_EQ(write(writer, line.graph), merged_path("M0 0 4 0"));
+}
+
+TEST(grapphs_svg, merge_branch) {
+    // The chain goes straight through the branching vertex, the branch starts a new one
+    placed_graph branch({{0, 0}, {1, 0}, {2, 0}, {1, 1}}, {{0, 1}, {1, 2}, {1, 3}});
+    test_writer writer = branch.writer(k_merged);
+    EXPECT_EQ(write(writer, branch.graph), merged_path("M0 0 2 0 M1 0 1 1"));
+}
+
+TEST(grapphs_svg, merge_cycle) {
+    // Both directions of an edge are drawn once
+    placed_graph square({{0, 0}, {2, 0}, {2, 2}, {0, 2}}, {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {1, 0}});
+    test_writer writer = square.writer(k_merged);
+    EXPECT_EQ(write(writer, square.graph), merged_path("M0 0 2 0 2 2 0 2 0 0"));
+}
+
+TEST(grapphs_svg, min_edge_length) {
+    placed_graph graph({{0, 0}, {0.5F, 0}, {5, 5}}, {{0, 1}, {1, 2}});
+    test_writer merged = graph.writer(k_merged);
+    merged.set_min_edge_length(1);
+    EXPECT_EQ(write(merged, graph.graph), merged_path("M0.5 0 5 5"));
+
+    test_writer lines = graph.writer(gpp::svg_writer_flags::DRAW_EDGES);
+    lines.set_min_edge_length(1);
+    EXPECT_EQ(write(lines, graph.graph), k_header + line(0.5F, 0, 5, 5) + "</svg>\n");
+}
+
+TEST(grapphs_svg, cull_to_viewbox) {
+    // The second edge crosses the viewbox without either end being inside, the third is outside
+    placed_graph graph({{1, 1}, {2, 1}, {-5, 5}, {15, 5}, {20, 20}, {30, 20}}, {{0, 1}, {2, 3}, {4, 5}});
+    test_writer all = graph.writer(gpp::svg_writer_flags::DRAW_EDGES);
+    EXPECT_EQ(write(all, graph.graph), k_header + line(1, 1, 2, 1) + line(-5, 5, 15, 5) + line(20, 20, 30, 20) + "</svg>\n");
+
+    test_writer culled = graph.writer(gpp::svg_writer_flags::DRAW_EDGES | gpp::svg_writer_flags::CULL_TO_VIEWBOX);
+    EXPECT_EQ(write(culled, graph.graph), k_header + line(1, 1, 2, 1) + line(-5, 5, 15, 5) + "</svg>\n");
+
+    test_writer culledPaths = graph.writer(k_merged | gpp::svg_writer_flags::CULL_TO_VIEWBOX);
+    EXPECT_EQ(write(culledPaths, graph.graph), merged_path("M1 1 2 1 M-5 5 15 5"));
+}
+
+namespace {
+
+    /**
+     * Grid of \p gridSide by \p gridSide vertices over a 100 by 100 viewbox, with a few long
+     * edges across it, and colors and sizes depending on the vertex and edge.
+     */
+    struct grid_fixture {
+        test_graph graph;
+        std::size_t side;
+
+        explicit grid_fixture(std::size_t gridSide) : side(gridSide) {
+            for (std::size_t i = 0; i < side * side; ++i) {
+                graph.push(static_cast<int>(i));
+            }
+            for (std::size_t y = 0; y < side; ++y) {
+                for (std::size_t x = 0; x < side; ++x) {
+                    std::size_t i = y * side + x;
+                    if (x + 1 < side) {
+                        graph.connect(i, i + 1, static_cast<float>(i % 3));
+                    }
+                    if (y + 1 < side) {
+                        graph.connect(i, i + side, static_cast<float>(i % 5));
+                    }
+                    if (i % 97 == 0) {
+                        graph.connect(i, (i * 31 + 7) % (side * side), 7.0F);
+                    }
+                }
+            }
+        }
+
+        test_writer writer(gpp::svg_viewbox viewBox, gpp::svg_writer_flags flags) const {
+            std::size_t gridSide = side;
+            test_writer result(
+                viewBox, [gridSide](std::size_t i, const int&, float& x, float& y) {
+                    float step = 100.0F / static_cast<float>(gridSide);
+                    x = (static_cast<float>(i % gridSide) + 0.5F + 0.3F * static_cast<float>(i % 7) / 7) * step;
+                    y = (static_cast<float>(i / gridSide) + 0.5F) * step;
+                }
+            );
+            result.set_flags(flags);
+            result.set_node_radius(0.2F);
+            result.set_min_edge_length(0.5F);
+            result.set_vertex_customizer(
+                [](const int& vertex, gpp::svg_attributes& attributes) {
+                    attributes.color = gpp::svg_color(0xFF000000 | static_cast<std::uint32_t>(vertex % 4) * 0x40);
+                }
+            );
+            result.set_edge_customizer(
+                [](const float& edge, gpp::svg_attributes& attributes) {
+                    attributes.color = gpp::svg_color(0xFF000000 | static_cast<std::uint32_t>(edge) * 0x2000);
+                    attributes.size = 0.1F + 0.05F * edge;
+                }
+            );
+            return result;
+        }
+    };
+
+    std::string read_file(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    const gpp::svg_writer_flags k_everything = gpp::svg_writer_flags::DRAW_VERTICES | gpp::svg_writer_flags::DRAW_EDGES;
+}
+
+TEST(grapphs_svg, thread_count_independence) {
+    // Several chunks of vertices
+    grid_fixture grid(100);
+    for (gpp::svg_writer_flags flags : {k_everything, k_everything | gpp::svg_writer_flags::MERGE_EDGES}) {
+        test_writer writer = grid.writer(gpp::svg_viewbox(0, 0, 100, 100), flags);
+        std::string single = write(writer, grid.graph);
+        writer.set_num_threads(8);
+        EXPECT_EQ(write(writer, grid.graph), single) << static_cast<int>(flags);
+    }
+}
+
+TEST(grapphs_svg, write_tiles) {
+    grid_fixture grid(30);
+    auto directory = std::filesystem::temp_directory_path() / "grapphs_svg_tiles";
+    std::filesystem::remove_all(directory);
+    gpp::svg_writer_flags flags = k_everything | gpp::svg_writer_flags::MERGE_EDGES;
+    test_writer writer = grid.writer(gpp::svg_viewbox(0, 0, 100, 100), flags);
+    writer.set_num_threads(4);
+    writer.write_tiles(directory, grid.graph, 2);
+
+    std::size_t numFiles = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+        numFiles += entry.is_regular_file() ? 1 : 0;
+    }
+    EXPECT_EQ(numFiles, 1 + 4 + 16);
+
+    // Each tile renders as the whole graph culled to the tile would
+    for (std::size_t zoom = 0; zoom <= 2; ++zoom) {
+        std::size_t tilesPerSide = std::size_t(1) << zoom;
+        float tileSize = 100.0F / static_cast<float>(tilesPerSide);
+        for (std::size_t x = 0; x < tilesPerSide; ++x) {
+            for (std::size_t y = 0; y < tilesPerSide; ++y) {
+                auto path = directory / std::to_string(zoom) / std::to_string(x) / (std::to_string(y) + ".svg");
+                ASSERT_TRUE(std::filesystem::exists(path)) << path;
+                test_writer expected = grid.writer(
+                    gpp::svg_viewbox(static_cast<float>(x) * tileSize, static_cast<float>(y) * tileSize, tileSize, tileSize),
+                    flags | gpp::svg_writer_flags::CULL_TO_VIEWBOX
+                );
+                expected.set_min_edge_length(0.5F / static_cast<float>(tilesPerSide));
+                EXPECT_EQ(read_file(path), write(expected, grid.graph)) << path;
+            }
+        }
+    }
+    std::filesystem::remove_all(directory);
+}
@@ -7,7 +7,36 @@
 
 namespace gpp::osm {
 
-    void parse(const std::filesystem::path& file, gpp::osm::osm_graph& into);
+    struct parse_options {
+        /**
+         * Load the graph from the snapshot kept next to the parsed file when it is up to date,
+         * and write a new snapshot after parsing otherwise. See gpp::osm::load_snapshot.
+         */
+        bool useSnapshot = true;
+
+        /**
+         * Threads used to decode .osm.pbf files, 0 meaning one per hardware thread.
+         */
+        std::size_t numThreads = 0;
+
+        /**
+         * Keep only routable ways and the nodes they reference, dropping buildings, points of
+         * interest and every other node. This reads the file twice, once for ways and once for
+         * nodes, but keeps far less in memory for large extracts.
+         */
+        bool routableOnly = false;
+    };
+
+    /**
+     * Parses an OpenStreetMap file into \p into. XML files are read through readosm, while
+     * files ending in .pbf are decoded natively and in parallel.
+     * @throws std::runtime_error if a .pbf file is malformed or requires unsupported features.
+     */
+    void parse(
+        const std::filesystem::path& file,
+        gpp::osm::osm_graph& into,
+        const parse_options& options = parse_options()
+    );
 }
 
 #endif
@@ -0,0 +1,40 @@
+#ifndef GRAPPHS_SNAPSHOT_H
+#define GRAPPHS_SNAPSHOT_H
+
+#include <grapphs/osm/way.h>
+
+#include <cstdint>
+#include <filesystem>
+
+namespace gpp::osm {
+
+    /**
+     * @returns Where the snapshot of the graph parsed from \p source is kept.
+     */
+    std::filesystem::path snapshot_path(const std::filesystem::path& source);
+
+    /**
+     * Writes \p graph, which was parsed from \p source, into a grapphs binary file next to it.
+     * The snapshot is stamped with the size and modification time of \p source, and with
+     * \p importFlags, which tell apart graphs imported from the same file with different options.
+     * @returns false if the snapshot could not be written.
+     */
+    bool save_snapshot(
+        const gpp::osm::osm_graph& graph,
+        const std::filesystem::path& source,
+        std::uint32_t importFlags = 0
+    );
+
+    /**
+     * Loads the snapshot of \p source into \p into, which must be empty.
+     * @returns false if there is no snapshot, or it is stale, unreadable or was saved with
+     * different \p importFlags.
+     */
+    bool load_snapshot(
+        const std::filesystem::path& source,
+        gpp::osm::osm_graph& into,
+        std::uint32_t importFlags = 0
+    );
+}
+
+#endif
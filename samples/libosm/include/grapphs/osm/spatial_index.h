@@ -0,0 +1,120 @@
+#ifndef GRAPPHS_SPATIAL_INDEX_H
+#define GRAPPHS_SPATIAL_INDEX_H
+
+#include <grapphs/osm/way.h>
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace gpp::osm {
+
+    struct geo_bounds {
+        double minLongitude = std::numeric_limits<double>::max();
+        double minLatitude = std::numeric_limits<double>::max();
+        double maxLongitude = -std::numeric_limits<double>::max();
+        double maxLatitude = -std::numeric_limits<double>::max();
+
+        bool empty() const {
+            return minLongitude > maxLongitude || minLatitude > maxLatitude;
+        }
+    };
+
+    struct nearest_vertex {
+        static constexpr std::size_t invalid_vertex() {
+            return std::numeric_limits<std::size_t>::max();
+        }
+
+        std::size_t vertex = invalid_vertex();
+        /**
+         * Distance in meters.
+         */
+        float distance = std::numeric_limits<float>::infinity();
+    };
+
+    /**
+     * Static uniform grid over the locations of the vertices of an osm_graph, bulk loaded once
+     * after parsing. Used to snap coordinates, such as GPS fixes, to the graph.
+     *
+     * Locations are projected onto a plane tangent at the center of the graph's bounds, so
+     * distances are in meters and accurate for city and region sized graphs. Cells are square
+     * and store their points contiguously, as structure of arrays, so that the distance
+     * evaluation over a cell is vectorized by the compiler.
+     *
+     * The index does not track changes made to the graph after it was built. All queries
+     * are safe to run concurrently.
+     */
+    class spatial_index {
+    private:
+        geo_bounds _bounds;
+        double _metersPerLongitude = 0;
+        double _metersPerLatitude = 0;
+        float _cellSize = 0;
+        std::size_t _columns = 0;
+        std::size_t _rows = 0;
+        std::vector<std::size_t> _cellOffsets;
+        std::vector<float> _xs;
+        std::vector<float> _ys;
+        std::vector<std::size_t> _vertices;
+
+        float project_x(const coordinate& location) const;
+
+        float project_y(const coordinate& location) const;
+
+        std::size_t column_of(float x) const;
+
+        std::size_t row_of(float y) const;
+
+        template<typename t_visit>
+        void visit_cell(std::size_t cell, float x, float y, const t_visit& visit) const;
+
+        template<typename t_visit, typename t_done>
+        void search(const coordinate& location, const t_visit& visit, const t_done& done) const;
+
+    public:
+        spatial_index() = default;
+
+        /**
+         * Indexes every vertex of \p graph, aiming at \p pointsPerCell vertices per cell.
+         */
+        explicit spatial_index(const osm_graph& graph, std::size_t pointsPerCell = 8);
+
+        std::size_t size() const;
+
+        bool empty() const;
+
+        /**
+         * @returns The bounds of every indexed vertex.
+         */
+        const geo_bounds& get_bounds() const;
+
+        /**
+         * @returns The vertex closest to \p location, with an invalid vertex if the index is
+         * empty.
+         */
+        nearest_vertex nearest(const coordinate& location) const;
+
+        /**
+         * @returns The \p k vertices closest to \p location, closest first.
+         */
+        std::vector<nearest_vertex> k_nearest(const coordinate& location, std::size_t k) const;
+
+        /**
+         * @returns Every vertex within \p radius meters of \p location, closest first.
+         */
+        std::vector<nearest_vertex> within_radius(const coordinate& location, float radius) const;
+
+        /**
+         * Snaps \p count locations at once, writing the vertex closest to each into \p into.
+         * Locations are split among \p numThreads threads, 0 meaning one per hardware thread.
+         */
+        void snap(
+            const coordinate* locations,
+            std::size_t count,
+            nearest_vertex* into,
+            std::size_t numThreads = 0
+        ) const;
+    };
+}
+
+#endif
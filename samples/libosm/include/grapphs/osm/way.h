@@ -3,8 +3,13 @@
 
 #include <grapphs/adjacency_list.h>
 
+#include <cstdint>
+#include <limits>
 #include <ostream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace gpp::osm {
@@ -40,13 +45,11 @@ namespace gpp::osm {
 
     class way_metadata {
     public:
-        way_metadata(const way_metadata&) = default;
-
         enum class flags : uint8_t {
             SIDEWALK_LEFT = 1 << 0,
             SIDEWALK_RIGHT = 1 << 1,
             LIT = 1 << 2,
-            BUILDING,
+            BUILDING = 1 << 3,
             SIDEWALK_BOTH = SIDEWALK_LEFT | SIDEWALK_RIGHT
         };
 
@@ -58,7 +61,7 @@ namespace gpp::osm {
         };
 
     private:
-        std::string _name;
+        std::string_view _name;
         float _maxSpeed;
         flags _flags;
         kind _kind;
@@ -67,9 +70,13 @@ namespace gpp::osm {
     public:
         way_metadata() = default;
 
-        way_metadata(const std::string& name, float maxSpeed, flags flags, kind kind, surface surface);
+        /**
+         * \p name is only referenced. Metadata pushed into an osm_graph references the
+         * graph's own copy of it instead.
+         */
+        way_metadata(std::string_view name, float maxSpeed, flags flags, kind kind, surface surface);
 
-        const std::string& get_name() const;
+        std::string_view get_name() const;
 
         flags get_flags() const;
 
@@ -78,27 +85,46 @@ namespace gpp::osm {
         float get_max_speed() const;
 
         kind get_kind() const;
+
+        bool operator==(const way_metadata& other) const;
     };
 
     way_metadata::flags operator|(way_metadata::flags a, way_metadata::flags b);
 
     way_metadata::flags operator&(way_metadata::flags a, way_metadata::flags b);
 
-    way_metadata::flags operator|=(way_metadata::flags a, way_metadata::flags b);
+    way_metadata::flags& operator|=(way_metadata::flags& a, way_metadata::flags b);
+
+    /**
+     * Great-circle distance between \p a and \p b in meters.
+     */
+    double haversine_distance(const coordinate& a, const coordinate& b);
 
+    /**
+     * Edge of an osm_graph. Besides its metadata, a way stores its length in meters and its
+     * travel time in seconds, see osm_graph::compute_weights.
+     */
     class way {
     private:
-        std::size_t _metadataIndex;
+        std::uint32_t _metadataIndex;
+        float _length;
+        float _travelTime;
 
     public:
-        static constexpr std::size_t invalid_metadata() {
-            return -1;
+        static constexpr std::uint32_t invalid_metadata() {
+            return std::numeric_limits<std::uint32_t>::max();
         }
 
         way(size_t metadataIndex = invalid_metadata());
 
         size_t get_metadata_index() const;
 
+        float get_length() const;
+
+        float get_travel_time() const;
+
+        void set_weights(float length, float travelTime);
+
         friend std::ostream& operator<<(std::ostream& os, const way& way);
 
         bool has_metadata() const;
@@ -106,14 +132,66 @@ namespace gpp::osm {
 
     class osm_graph : public gpp::adjacency_list<osm_node, way> {
     private:
+        struct metadata_hash {
+            std::size_t operator()(const way_metadata& metadata) const;
+        };
+
         std::vector<way_metadata> _metadata;
+        std::unordered_map<way_metadata, std::size_t, metadata_hash> _metadataIndices;
+        // Node based, so names never move once interned.
+        std::unordered_set<std::string> _names;
 
     public:
         osm_graph() = default;
 
-        std::size_t push_meta(gpp::osm::way_metadata&& metadata);
+        // Metadata references names owned by the graph, so copies would dangle.
+        osm_graph(const osm_graph&) = delete;
+
+        osm_graph& operator=(const osm_graph&) = delete;
+
+        osm_graph(osm_graph&&) = default;
 
-        bool get_metadata(const way& way, gpp::osm::way_metadata& metadata);
+        osm_graph& operator=(osm_graph&&) = default;
+
+        /**
+         * Removes all vertices, edges and metadata.
+         */
+        void clear();
+
+        /**
+         * Interns \p metadata, and its name into the graph's string pool.
+         * @returns The index of \p metadata, which is shared by every equal metadata pushed.
+         */
+        std::size_t push_meta(const gpp::osm::way_metadata& metadata);
+
+        /**
+         * @returns The metadata of \p way, or nullptr if it has none.
+         */
+        const gpp::osm::way_metadata* get_metadata(const way& way) const;
+
+        const std::vector<way_metadata>& get_metadata_table() const;
+
+        /**
+         * Computes the length and travel time of every edge from the location of its endpoints
+         * and its metadata, and stores them into the edge. Ways without a max speed travel at a
+         * default speed for their kind.
+         */
+        void compute_weights();
+
+        /**
+         * @returns The length of \p way in meters, as of the last compute_weights().
+         */
+        float length_of(const way& way) const {
+            return way.get_length();
+        }
+
+        /**
+         * @returns The time it takes to travel along \p way in seconds, as of the last
+         * compute_weights().
+         */
+        float travel_time_of(const way& way) const {
+            return way.get_travel_time();
+        }
     };
 } // namespace gpp::osm
 #endif
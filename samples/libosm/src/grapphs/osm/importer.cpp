@@ -0,0 +1,211 @@
+#include <grapphs/osm/importer.h>
+
+#include <algorithm>
+#include <charconv>
+
+namespace gpp::osm {
+
+    static gpp::osm::way_metadata::surface parse_surface(std::string_view value) {
+        if (value == "asphalt") {
+            return gpp::osm::way_metadata::surface::ASPHALT;
+        }
+        if (value == "dirt") {
+            return gpp::osm::way_metadata::surface::DIRT;
+        }
+        return gpp::osm::way_metadata::surface::UNKNOWN;
+    }
+
+    template<typename t_number>
+    static bool parse_number(std::string_view value, t_number& number, std::string_view& rest) {
+        auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+        if (error != std::errc()) {
+            return false;
+        }
+        rest = value.substr(static_cast<std::size_t>(end - value.data()));
+        return true;
+    }
+
+    /**
+     * Parses maxspeed values, which are in km/h unless followed by "mph".
+     */
+    static float parse_max_speed(std::string_view value) {
+        float speed;
+        std::string_view unit;
+        if (!parse_number(value, speed, unit)) {
+            return -1;
+        }
+        while (!unit.empty() && unit.front() == ' ') {
+            unit.remove_prefix(1);
+        }
+        if (unit == "mph") {
+            speed *= 1.609344F;
+        }
+        return speed;
+    }
+
+    static bool is_interesting(const gpp::osm::way_metadata& meta) {
+        if (meta.get_kind() != way_metadata::kind::UNKNOWN) {
+            return true;
+        }
+        if (meta.get_surface() != way_metadata::surface::UNKNOWN) {
+            return true;
+        }
+        if (meta.get_max_speed() > 0) {
+            return true;
+        }
+        return false;
+    }
+
+    way_metadata make_way_metadata(const tag_values& values) {
+        auto value = [&values](tag_key key) {
+            return values[static_cast<std::size_t>(key)];
+        };
+
+        gpp::osm::way_metadata::flags flags{};
+        if (value(tag_key::LIT) == "yes") {
+            flags |= gpp::osm::way_metadata::flags::LIT;
+        }
+        if (value(tag_key::BUILDING) == "yes") {
+            flags |= gpp::osm::way_metadata::flags::BUILDING;
+        }
+
+        gpp::osm::way_metadata::kind kind = gpp::osm::way_metadata::kind::UNKNOWN;
+        int numLanes;
+        std::string_view rest;
+        if (!value(tag_key::HIGHWAY).empty()) {
+            kind = gpp::osm::way_metadata::kind::HIGHWAY;
+        }
+        else if (parse_number(value(tag_key::LANES), numLanes, rest)) {
+            if (numLanes > 4) {
+                kind = gpp::osm::way_metadata::kind::HIGHWAY;
+            }
+            else if (numLanes > 2) {
+                kind = gpp::osm::way_metadata::kind::AVENUE;
+            }
+            else if (numLanes > 1) {
+                kind = gpp::osm::way_metadata::kind::ROAD;
+            }
+            else if (numLanes == 1) {
+                kind = gpp::osm::way_metadata::kind::WAY;
+            }
+        }
+
+        float maxSpeed = -1;
+        if (!value(tag_key::MAX_SPEED).empty()) {
+            maxSpeed = parse_max_speed(value(tag_key::MAX_SPEED));
+        }
+
+        gpp::osm::way_metadata::surface surface = parse_surface(value(tag_key::SURFACE));
+
+        return gpp::osm::way_metadata(value(tag_key::NAME), maxSpeed, flags, kind, surface);
+    }
+
+    bool is_routable(const way_metadata& metadata) {
+        return metadata.get_kind() != way_metadata::kind::UNKNOWN;
+    }
+
+    importer::importer(gpp::osm::osm_graph* graph, bool routableOnly)
+        : _graph(graph),
+          _builder(),
+          _routableOnly(routableOnly),
+          _osm2gpp(),
+          _refs(),
+          _ways(),
+          _ids(),
+          _locations(),
+          _found() {
+    }
+
+    bool importer::is_two_pass() const {
+        return _routableOnly;
+    }
+
+    std::size_t importer::push_metadata(const way_metadata& metadata) {
+        if (is_interesting(metadata)) {
+            return _graph->push_meta(metadata);
+        }
+        return gpp::osm::way::invalid_metadata();
+    }
+
+    void importer::add_node(std::int64_t osmId, const coordinate& location) {
+        if (!_routableOnly) {
+            _osm2gpp[osmId] = _graph->push(gpp::osm::osm_node(location));
+            return;
+        }
+        auto it = std::lower_bound(_ids.begin(), _ids.end(), osmId);
+        if (it == _ids.end() || *it != osmId) {
+            return;
+        }
+        auto position = static_cast<std::size_t>(it - _ids.begin());
+        _locations[position] = location;
+        _found[position] = true;
+    }
+
+    void importer::add_way(const std::int64_t* refs, std::size_t numRefs, const way_metadata& metadata) {
+        if (_routableOnly) {
+            if (numRefs < 2 || !is_routable(metadata)) {
+                return;
+            }
+            _ways.push_back(pending_way{push_metadata(metadata), _refs.size(), numRefs});
+            _refs.insert(_refs.end(), refs, refs + numRefs);
+            return;
+        }
+
+        std::size_t metaIndex = push_metadata(metadata);
+        for (std::size_t i = 1; i < numRefs; ++i) {
+            auto from = _osm2gpp.find(refs[i - 1]);
+            auto to = _osm2gpp.find(refs[i]);
+            if (from == _osm2gpp.end() || to == _osm2gpp.end()) {
+                continue;
+            }
+            _builder.add(from->second, to->second, gpp::osm::way(metaIndex));
+        }
+    }
+
+    void importer::end_ways() {
+        _ids = _refs;
+        std::sort(_ids.begin(), _ids.end());
+        _ids.erase(std::unique(_ids.begin(), _ids.end()), _ids.end());
+        _ids.shrink_to_fit();
+        _locations.assign(_ids.size(), coordinate(0, 0));
+        _found.assign(_ids.size(), false);
+    }
+
+    void importer::finish() {
+        if (_routableOnly) {
+            // Referenced nodes missing from the file are dropped, so that a node's position in
+            // _ids is also its vertex index.
+            std::size_t numKept = 0;
+            _graph->reserve(std::count(_found.begin(), _found.end(), true));
+            for (std::size_t i = 0; i < _ids.size(); ++i) {
+                if (_found[i]) {
+                    _ids[numKept++] = _ids[i];
+                    _graph->push(gpp::osm::osm_node(_locations[i]));
+                }
+            }
+            _ids.resize(numKept);
+            _locations = std::vector<coordinate>();
+            _found = std::vector<bool>();
+
+            auto find = [this](std::int64_t osmId, std::size_t& index) {
+                auto it = std::lower_bound(_ids.begin(), _ids.end(), osmId);
+                index = static_cast<std::size_t>(it - _ids.begin());
+                return it != _ids.end() && *it == osmId;
+            };
+            for (const pending_way& way : _ways) {
+                const std::int64_t* refs = _refs.data() + way.firstRef;
+                for (std::size_t i = 1; i < way.numRefs; ++i) {
+                    std::size_t from, to;
+                    if (find(refs[i - 1], from) && find(refs[i], to)) {
+                        _builder.add(from, to, gpp::osm::way(way.metadataIndex));
+                    }
+                }
+            }
+            _refs = std::vector<std::int64_t>();
+            _ways = std::vector<pending_way>();
+        }
+        // Ways sharing a segment keep the first one added, as the builder keeps edges in order
+        _builder.build_into(*_graph);
+        _graph->compute_weights();
+    }
+}
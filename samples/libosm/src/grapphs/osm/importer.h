@@ -0,0 +1,88 @@
+#ifndef GRAPPHS_IMPORTER_H
+#define GRAPPHS_IMPORTER_H
+
+#include <grapphs/osm/way.h>
+#include <grapphs/osm/tags.h>
+#include <grapphs/graph_builder.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace gpp::osm {
+
+    /**
+     * @returns Whether a way classified as \p metadata can be travelled along.
+     */
+    bool is_routable(const way_metadata& metadata);
+
+    /**
+     * Turns the nodes and ways read by any of the OSM readers into an osm_graph.
+     *
+     * By default every node is pushed as soon as it is added, and ways must come after the
+     * nodes they reference, as they do in OSM files.
+     *
+     * When \p routableOnly is set the import takes two passes: first every way is added, then
+     * end_ways() is called, and then every node is added. Only routable ways are kept, and
+     * only the nodes they reference become vertices. OSM ids are resolved through a sorted
+     * array of the referenced ids instead of a hash map.
+     */
+    class importer {
+    private:
+        struct pending_way {
+            std::size_t metadataIndex;
+            std::size_t firstRef;
+            std::size_t numRefs;
+        };
+
+        gpp::osm::osm_graph* _graph;
+        gpp::graph_builder<gpp::osm::way> _builder;
+        bool _routableOnly;
+
+        // Single pass import
+        std::unordered_map<std::int64_t, std::size_t> _osm2gpp;
+
+        // Two pass import
+        std::vector<std::int64_t> _refs;
+        std::vector<pending_way> _ways;
+        std::vector<std::int64_t> _ids;
+        std::vector<coordinate> _locations;
+        std::vector<bool> _found;
+
+        std::size_t push_metadata(const way_metadata& metadata);
+
+    public:
+        explicit importer(gpp::osm::osm_graph* graph, bool routableOnly = false);
+
+        bool is_two_pass() const;
+
+        /**
+         * Classifies a way with the tag profile matching the import mode, see classify_way.
+         * Safe to call concurrently.
+         */
+        template<typename t_tag_at>
+        bool classify(std::size_t numTags, const t_tag_at& tagAt, way_metadata& metadata) const {
+            if (_routableOnly) {
+                return classify_way<routing_tag_profile>(numTags, tagAt, metadata);
+            }
+            return classify_way<default_tag_profile>(numTags, tagAt, metadata);
+        }
+
+        void add_node(std::int64_t osmId, const coordinate& location);
+
+        /**
+         * Connects every consecutive pair of \p refs, skipping segments that reference nodes
+         * which were never added.
+         */
+        void add_way(const std::int64_t* refs, std::size_t numRefs, const way_metadata& metadata);
+
+        /**
+         * Ends the first pass of a two pass import, collecting the ids of the nodes to keep.
+         */
+        void end_ways();
+
+        void finish();
+    };
+}
+
+#endif
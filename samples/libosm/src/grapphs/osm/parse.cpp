@@ -1,36 +1,23 @@
 #include <grapphs/osm/parse.h>
+#include <grapphs/osm/snapshot.h>
+#include <grapphs/osm/importer.h>
+#include <grapphs/osm/pbf.h>
 #include <readosm.h>
 
 #include <iostream>
-#include <unordered_map>
 
 namespace gpp::osm {
 
-    static std::unordered_map<std::string, gpp::osm::way_metadata::surface> NAME_TO_SURFACE = {
-        {"dirt",    gpp::osm::way_metadata::surface::DIRT},
-        {"asphalt", gpp::osm::way_metadata::surface::ASPHALT}
-    };
-
     class parser_helper {
     private:
-        std::unordered_map<std::size_t, std::size_t> _osm2gpp;
-        gpp::osm::osm_graph* _graph;
+        gpp::osm::importer _importer;
 
     public:
-        explicit parser_helper(osm_graph* graph) : _graph(graph), _osm2gpp() {
-        }
-
-        void add(std::size_t osmIndex, gpp::osm::osm_node&& node) {
-            std::size_t gpp = _graph->push(std::forward<gpp::osm::osm_node&&>(node));
-            _osm2gpp[osmIndex] = gpp;
+        parser_helper(osm_graph* graph, bool routableOnly) : _importer(graph, routableOnly) {
         }
 
-        gpp::osm::osm_graph& get_graph() {
-            return *_graph;
-        }
-
-        std::size_t get_gpp_index(std::size_t of) const {
-            return _osm2gpp.at(of);
+        gpp::osm::importer& get_importer() {
+            return _importer;
         }
     };
 
@@ -38,35 +25,10 @@ namespace gpp::osm {
         gpp::osm::coordinate loc(node->longitude, node->latitude);
         auto& into = const_cast<parser_helper&>(*static_cast<const parser_helper*>(pHelper));
 
-        gpp::osm::osm_node gppNode(loc);
-
-        into.add(node->id, std::move(gppNode));
+        into.get_importer().add_node(node->id, loc);
         return READOSM_OK;
     }
 
-    std::string find_tag(const std::string& key, const readosm_way* way) {
-        for (int i = 0; i < way->tag_count; ++i) {
-            const auto& tag = way->tags[i];
-            if (key == tag.key) {
-                return tag.value;
-            }
-        }
-        return "";
-    }
-
-    bool is_interesting(const gpp::osm::way_metadata& meta) {
-        if (meta.get_kind() != way_metadata::kind::UNKNOWN) {
-            return true;
-        }
-        if (meta.get_surface() != way_metadata::surface::UNKNOWN) {
-            return true;
-        }
-        if (meta.get_max_speed() > 0) {
-            return true;
-        }
-        return false;
-    }
-
     int way_parse(const void* pHelper, const readosm_way* way) {
         auto& into = const_cast<parser_helper&>(*static_cast<const parser_helper*>(pHelper));
 
@@ -86,69 +48,22 @@ namespace gpp::osm {
                 std::cout << "Tag #" << i << ": " << tag.key << " -> " << tag.value << std::endl;
             }
         }*/
-        std::string name = find_tag("name", way);
-
-        gpp::osm::way_metadata::surface surface = gpp::osm::way_metadata::surface::UNKNOWN;
-        std::string surfaceKind = find_tag("surface", way);
-        if (auto it = NAME_TO_SURFACE.find(surfaceKind); it != NAME_TO_SURFACE.end()) {
-            surface = it->second;
-        }
-
-        gpp::osm::way_metadata::flags flags{};
-
-        if (find_tag("lit", way) == "yes") {
-            flags |= gpp::osm::way_metadata::flags::LIT;
-        }
-
-        if (find_tag("building", way) == "yes") {
-            flags |= gpp::osm::way_metadata::flags::BUILDING;
-        }
-
-        gpp::osm::way_metadata::kind kind = gpp::osm::way_metadata::kind::UNKNOWN;
-        if (!find_tag("highway", way).empty()) {
-            kind = gpp::osm::way_metadata::kind::HIGHWAY;
-        }
-        else {
-            std::string lanesStr = find_tag("lanes", way);
-            if (!lanesStr.empty()) {
-                auto numLanes = std::stoi(lanesStr);
-                if (numLanes > 4) {
-                    kind = gpp::osm::way_metadata::kind::HIGHWAY;
-                }
-                else if (numLanes > 2) {
-                    kind = gpp::osm::way_metadata::kind::AVENUE;
-                }
-                else if (numLanes > 1) {
-                    kind = gpp::osm::way_metadata::kind::ROAD;
-                }
-                else if (numLanes == 1) {
-                    kind = gpp::osm::way_metadata::kind::WAY;
-                }
-            }
-        }
-
-        float maxSpeed = -1;
-        std::string speedStr = find_tag("max_speed", way);
-        if (!speedStr.empty()) {
-            maxSpeed = std::stof(speedStr);
-        }
-
-        gpp::osm::way_metadata meta(name, maxSpeed, flags, kind, surface);
-
-        osm_graph& graph = into.get_graph();
-        std::size_t metaIndex;
-        if (is_interesting(meta)) {
-            metaIndex = graph.push_meta(std::move(meta));
-        }
-        else {
-            metaIndex = gpp::osm::way::invalid_metadata();
-        }
-
-        for (int i = 1; i < way->node_ref_count; ++i) {
-            const auto& from = into.get_gpp_index(way->node_refs[i - 1]);
-            const auto& to = into.get_gpp_index(way->node_refs[i]);
-            graph.connect(from, to, gpp::osm::way(metaIndex));
-        }
+        gpp::osm::way_metadata meta;
+        bool keep = into.get_importer().classify(
+            static_cast<std::size_t>(way->tag_count), [way](std::size_t i) {
+                return tag_view{way->tags[i].key, way->tags[i].value};
+            }, meta
+        );
+        if (!keep) {
+            return READOSM_OK;
+        }
+
+        static_assert(sizeof(long long) == sizeof(std::int64_t), "readosm node refs must be 64 bit");
+        into.get_importer().add_way(
+            reinterpret_cast<const std::int64_t*>(way->node_refs),
+            static_cast<std::size_t>(way->node_ref_count),
+            meta
+        );
 
         return READOSM_OK;
     }
@@ -165,17 +80,62 @@ namespace gpp::osm {
         return READOSM_OK;
     }
 
-    void parse(const std::filesystem::path& file, gpp::osm::osm_graph& into) {
+    static bool is_pbf(const std::filesystem::path& file) {
+        return file.extension() == ".pbf";
+    }
+
+    static void parse_osm(
+        const std::filesystem::path& file,
+        parser_helper& helper,
+        readosm_node_callback pfnNodeCb,
+        readosm_way_callback pfnWayCb
+    ) {
         const void* osmHandle;
-        parser_helper helper(&into);
         const std::string& fileStr = file.string();
         readosm_open(fileStr.c_str(), reinterpret_cast<const void**>(&osmHandle));
 
-        readosm_node_callback pfnNodeCb = &node_parse;
-        readosm_way_callback pfnWayCb = &way_parse;
         readosm_relation_callback pfnRelationCb = &relation_parse;
 
         readosm_parse(osmHandle, &helper, pfnNodeCb, pfnWayCb, pfnRelationCb);
         readosm_close(osmHandle);
     }
-}  // namespace gpp::osm
\ No newline at end of file
+
+    void parse(
+        const std::filesystem::path& file,
+        gpp::osm::osm_graph& into,
+        const parse_options& options
+    ) {
+        std::uint32_t importFlags = options.routableOnly ? 1 : 0;
+        if (options.useSnapshot && load_snapshot(file, into, importFlags)) {
+            return;
+        }
+
+        parser_helper helper(&into, options.routableOnly);
+        gpp::osm::importer& importer = helper.get_importer();
+        if (is_pbf(file)) {
+            if (importer.is_two_pass()) {
+                parse_pbf(file, importer, options.numThreads, pbf_elements::WAYS);
+                importer.end_ways();
+                parse_pbf(file, importer, options.numThreads, pbf_elements::NODES);
+            }
+            else {
+                parse_pbf(file, importer, options.numThreads);
+            }
+        }
+        else {
+            if (importer.is_two_pass()) {
+                parse_osm(file, helper, nullptr, &way_parse);
+                importer.end_ways();
+                parse_osm(file, helper, &node_parse, nullptr);
+            }
+            else {
+                parse_osm(file, helper, &node_parse, &way_parse);
+            }
+        }
+        importer.finish();
+
+        if (options.useSnapshot) {
+            save_snapshot(into, file, importFlags);
+        }
+    }
+}  // namespace gpp::osm
@@ -0,0 +1,603 @@
+#include <grapphs/osm/pbf.h>
+#include <grapphs/mapped_file.h>
+#include <grapphs/parallel.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gpp::osm {
+
+    /**
+     * Minimal reader for the protocol buffers wire format, which is all that is needed to
+     * walk the messages described in OpenStreetMap's fileformat.proto and osmformat.proto.
+     */
+    class pbf_message {
+    public:
+        enum wire_type : std::uint32_t {
+            VARINT = 0,
+            FIXED64 = 1,
+            LENGTH_DELIMITED = 2,
+            FIXED32 = 5
+        };
+
+    private:
+        const std::uint8_t* _ptr;
+        const std::uint8_t* _end;
+
+        [[noreturn]] static void truncated() {
+            throw std::runtime_error("truncated protocol buffer message");
+        }
+
+        void advance(std::uint64_t numBytes) {
+            if (numBytes > static_cast<std::uint64_t>(_end - _ptr)) {
+                truncated();
+            }
+            _ptr += numBytes;
+        }
+
+    public:
+        pbf_message(const void* data, std::size_t size)
+            : _ptr(static_cast<const std::uint8_t*>(data)), _end(_ptr + size) {
+        }
+
+        explicit pbf_message(std::string_view bytes) : pbf_message(bytes.data(), bytes.size()) {
+        }
+
+        bool next(std::uint32_t& field, std::uint32_t& wireType) {
+            if (_ptr >= _end) {
+                return false;
+            }
+            std::uint64_t key = varint();
+            field = static_cast<std::uint32_t>(key >> 3);
+            wireType = static_cast<std::uint32_t>(key & 7);
+            return true;
+        }
+
+        std::uint64_t varint() {
+            std::uint64_t value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                if (_ptr >= _end) {
+                    truncated();
+                }
+                std::uint8_t byte = *_ptr++;
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            throw std::runtime_error("malformed protocol buffer varint");
+        }
+
+        std::int64_t svarint() {
+            std::uint64_t value = varint();
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+
+        std::string_view bytes() {
+            std::uint64_t size = varint();
+            const std::uint8_t* begin = _ptr;
+            advance(size);
+            return std::string_view(reinterpret_cast<const char*>(begin), static_cast<std::size_t>(size));
+        }
+
+        pbf_message message() {
+            return pbf_message(bytes());
+        }
+
+        void skip(std::uint32_t wireType) {
+            switch (wireType) {
+                case VARINT:
+                    varint();
+                    break;
+                case FIXED64:
+                    advance(8);
+                    break;
+                case LENGTH_DELIMITED:
+                    advance(varint());
+                    break;
+                case FIXED32:
+                    advance(4);
+                    break;
+                default:
+                    throw std::runtime_error("unsupported protocol buffer wire type");
+            }
+        }
+
+        /**
+         * Reads a repeated integer field, which may be either packed or a single element.
+         */
+        template<typename t_block>
+        void repeated_varint(std::uint32_t wireType, const t_block& block) {
+            if (wireType == LENGTH_DELIMITED) {
+                pbf_message packed = message();
+                while (packed._ptr < packed._end) {
+                    block(packed);
+                }
+            }
+            else {
+                block(*this);
+            }
+        }
+    };
+
+    /**
+     * Fields of the messages in fileformat.proto and osmformat.proto that are read.
+     */
+    namespace pbf_fields {
+        constexpr std::uint32_t BLOB_HEADER_TYPE = 1;
+        constexpr std::uint32_t BLOB_HEADER_DATA_SIZE = 3;
+
+        constexpr std::uint32_t BLOB_RAW = 1;
+        constexpr std::uint32_t BLOB_RAW_SIZE = 2;
+        constexpr std::uint32_t BLOB_ZLIB_DATA = 3;
+
+        constexpr std::uint32_t HEADER_REQUIRED_FEATURES = 4;
+
+        constexpr std::uint32_t BLOCK_STRING_TABLE = 1;
+        constexpr std::uint32_t BLOCK_PRIMITIVE_GROUP = 2;
+        constexpr std::uint32_t BLOCK_GRANULARITY = 17;
+        constexpr std::uint32_t BLOCK_LAT_OFFSET = 19;
+        constexpr std::uint32_t BLOCK_LON_OFFSET = 20;
+
+        constexpr std::uint32_t STRING_TABLE_S = 1;
+
+        constexpr std::uint32_t GROUP_NODES = 1;
+        constexpr std::uint32_t GROUP_DENSE = 2;
+        constexpr std::uint32_t GROUP_WAYS = 3;
+
+        constexpr std::uint32_t NODE_ID = 1;
+        constexpr std::uint32_t NODE_LAT = 8;
+        constexpr std::uint32_t NODE_LON = 9;
+
+        constexpr std::uint32_t DENSE_ID = 1;
+        constexpr std::uint32_t DENSE_LAT = 8;
+        constexpr std::uint32_t DENSE_LON = 9;
+
+        constexpr std::uint32_t WAY_KEYS = 2;
+        constexpr std::uint32_t WAY_VALS = 3;
+        constexpr std::uint32_t WAY_REFS = 8;
+    }
+
+    struct pbf_blob_location {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    struct pbf_way {
+        way_metadata metadata;
+        std::size_t firstRef;
+        std::size_t numRefs;
+    };
+
+    /**
+     * Contents of a single OSMData block, converted into grapphs types. Way names reference
+     * the block's string table, so the inflated block is kept alongside.
+     */
+    struct pbf_block {
+        std::vector<char> inflated;
+        std::vector<std::int64_t> nodeIds;
+        std::vector<coordinate> nodeLocations;
+        std::vector<std::int64_t> refs;
+        std::vector<pbf_way> ways;
+
+        void clear() {
+            nodeIds.clear();
+            nodeLocations.clear();
+            refs.clear();
+            ways.clear();
+        }
+    };
+
+    /**
+     * Per thread buffers reused across blocks.
+     */
+    struct pbf_scratch {
+        std::vector<std::string_view> strings;
+        std::vector<std::int64_t> ids, lats, lons;
+        std::vector<std::uint32_t> keys, values;
+    };
+
+    static std::string_view inflate_blob(std::string_view data, std::vector<char>& buffer) {
+        using namespace pbf_fields;
+        pbf_message blob(data);
+        std::string_view raw, compressed;
+        std::uint64_t rawSize = 0;
+        std::uint32_t field, wireType;
+        while (blob.next(field, wireType)) {
+            switch (field) {
+                case BLOB_RAW:
+                    raw = blob.bytes();
+                    break;
+                case BLOB_RAW_SIZE:
+                    rawSize = blob.varint();
+                    break;
+                case BLOB_ZLIB_DATA:
+                    compressed = blob.bytes();
+                    break;
+                default:
+                    blob.skip(wireType);
+                    break;
+            }
+        }
+        if (!raw.empty()) {
+            return raw;
+        }
+        if (compressed.empty()) {
+            throw std::runtime_error("unsupported pbf blob compression, only zlib is supported");
+        }
+        buffer.resize(static_cast<std::size_t>(rawSize));
+        auto inflatedSize = static_cast<uLongf>(rawSize);
+        int result = uncompress(
+            reinterpret_cast<Bytef*>(buffer.data()), &inflatedSize,
+            reinterpret_cast<const Bytef*>(compressed.data()), static_cast<uLong>(compressed.size())
+        );
+        if (result != Z_OK || inflatedSize != rawSize) {
+            throw std::runtime_error("unable to inflate pbf blob");
+        }
+        return std::string_view(buffer.data(), buffer.size());
+    }
+
+    static bool has_elements(pbf_elements elements, pbf_elements kind) {
+        return (static_cast<std::uint8_t>(elements) & static_cast<std::uint8_t>(kind)) != 0;
+    }
+
+    class pbf_block_decoder {
+    private:
+        const importer& _importer;
+        pbf_scratch& _scratch;
+        pbf_block& _block;
+        bool _nodes;
+        bool _ways;
+        std::int64_t _granularity = 100;
+        std::int64_t _latOffset = 0;
+        std::int64_t _lonOffset = 0;
+
+        coordinate to_coordinate(std::int64_t lat, std::int64_t lon) const {
+            return coordinate(
+                1e-9 * static_cast<double>(_lonOffset + _granularity * lon),
+                1e-9 * static_cast<double>(_latOffset + _granularity * lat)
+            );
+        }
+
+        std::string_view string_at(std::uint32_t index) const {
+            if (index >= _scratch.strings.size()) {
+                throw std::runtime_error("pbf string table index out of range");
+            }
+            return _scratch.strings[index];
+        }
+
+        void decode_node(pbf_message node) {
+            using namespace pbf_fields;
+            std::int64_t id = 0, lat = 0, lon = 0;
+            std::uint32_t field, wireType;
+            while (node.next(field, wireType)) {
+                switch (field) {
+                    case NODE_ID:
+                        id = node.svarint();
+                        break;
+                    case NODE_LAT:
+                        lat = node.svarint();
+                        break;
+                    case NODE_LON:
+                        lon = node.svarint();
+                        break;
+                    default:
+                        node.skip(wireType);
+                        break;
+                }
+            }
+            _block.nodeIds.push_back(id);
+            _block.nodeLocations.push_back(to_coordinate(lat, lon));
+        }
+
+        void decode_dense(pbf_message dense) {
+            using namespace pbf_fields;
+            _scratch.ids.clear();
+            _scratch.lats.clear();
+            _scratch.lons.clear();
+            auto readSigned = [](std::vector<std::int64_t>& into) {
+                return [&into](pbf_message& packed) {
+                    into.push_back(packed.svarint());
+                };
+            };
+            std::uint32_t field, wireType;
+            while (dense.next(field, wireType)) {
+                switch (field) {
+                    case DENSE_ID:
+                        dense.repeated_varint(wireType, readSigned(_scratch.ids));
+                        break;
+                    case DENSE_LAT:
+                        dense.repeated_varint(wireType, readSigned(_scratch.lats));
+                        break;
+                    case DENSE_LON:
+                        dense.repeated_varint(wireType, readSigned(_scratch.lons));
+                        break;
+                    default:
+                        dense.skip(wireType);
+                        break;
+                }
+            }
+            std::size_t count = _scratch.ids.size();
+            if (_scratch.lats.size() != count || _scratch.lons.size() != count) {
+                throw std::runtime_error("pbf dense nodes have mismatched column lengths");
+            }
+            std::int64_t id = 0, lat = 0, lon = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                id += _scratch.ids[i];
+                lat += _scratch.lats[i];
+                lon += _scratch.lons[i];
+                _block.nodeIds.push_back(id);
+                _block.nodeLocations.push_back(to_coordinate(lat, lon));
+            }
+        }
+
+        void decode_way(pbf_message way) {
+            using namespace pbf_fields;
+            _scratch.keys.clear();
+            _scratch.values.clear();
+            std::size_t firstRef = _block.refs.size();
+            auto readUnsigned = [](std::vector<std::uint32_t>& into) {
+                return [&into](pbf_message& packed) {
+                    into.push_back(static_cast<std::uint32_t>(packed.varint()));
+                };
+            };
+            std::int64_t ref = 0;
+            std::uint32_t field, wireType;
+            while (way.next(field, wireType)) {
+                switch (field) {
+                    case WAY_KEYS:
+                        way.repeated_varint(wireType, readUnsigned(_scratch.keys));
+                        break;
+                    case WAY_VALS:
+                        way.repeated_varint(wireType, readUnsigned(_scratch.values));
+                        break;
+                    case WAY_REFS:
+                        way.repeated_varint(
+                            wireType, [&](pbf_message& packed) {
+                                ref += packed.svarint();
+                                _block.refs.push_back(ref);
+                            }
+                        );
+                        break;
+                    default:
+                        way.skip(wireType);
+                        break;
+                }
+            }
+            if (_scratch.keys.size() != _scratch.values.size()) {
+                throw std::runtime_error("pbf way has mismatched keys and values");
+            }
+            way_metadata metadata;
+            bool keep = _importer.classify(
+                _scratch.keys.size(), [this](std::size_t i) {
+                    return tag_view{string_at(_scratch.keys[i]), string_at(_scratch.values[i])};
+                }, metadata
+            );
+            if (!keep) {
+                _block.refs.resize(firstRef);
+                return;
+            }
+            _block.ways.push_back(pbf_way{metadata, firstRef, _block.refs.size() - firstRef});
+        }
+
+        void decode_group(pbf_message group) {
+            using namespace pbf_fields;
+            std::uint32_t field, wireType;
+            while (group.next(field, wireType)) {
+                switch (field) {
+                    case GROUP_NODES:
+                        if (_nodes) {
+                            decode_node(group.message());
+                        }
+                        else {
+                            group.skip(wireType);
+                        }
+                        break;
+                    case GROUP_DENSE:
+                        if (_nodes) {
+                            decode_dense(group.message());
+                        }
+                        else {
+                            group.skip(wireType);
+                        }
+                        break;
+                    case GROUP_WAYS:
+                        if (_ways) {
+                            decode_way(group.message());
+                        }
+                        else {
+                            group.skip(wireType);
+                        }
+                        break;
+                    default:
+                        group.skip(wireType);
+                        break;
+                }
+            }
+        }
+
+    public:
+        pbf_block_decoder(
+            const importer& importer,
+            pbf_scratch& scratch,
+            pbf_block& block,
+            pbf_elements elements
+        )
+            : _importer(importer),
+              _scratch(scratch),
+              _block(block),
+              _nodes(has_elements(elements, pbf_elements::NODES)),
+              _ways(has_elements(elements, pbf_elements::WAYS)) {
+        }
+
+        void decode(std::string_view data) {
+            using namespace pbf_fields;
+            _block.clear();
+            _scratch.strings.clear();
+            std::vector<std::string_view> groups;
+            pbf_message primitiveBlock(data);
+            std::uint32_t field, wireType;
+            while (primitiveBlock.next(field, wireType)) {
+                switch (field) {
+                    case BLOCK_STRING_TABLE: {
+                        pbf_message table = primitiveBlock.message();
+                        std::uint32_t tableField, tableWireType;
+                        while (table.next(tableField, tableWireType)) {
+                            if (tableField == STRING_TABLE_S) {
+                                _scratch.strings.push_back(table.bytes());
+                            }
+                            else {
+                                table.skip(tableWireType);
+                            }
+                        }
+                        break;
+                    }
+                    case BLOCK_PRIMITIVE_GROUP:
+                        groups.push_back(primitiveBlock.bytes());
+                        break;
+                    case BLOCK_GRANULARITY:
+                        _granularity = static_cast<std::int64_t>(primitiveBlock.varint());
+                        break;
+                    case BLOCK_LAT_OFFSET:
+                        _latOffset = static_cast<std::int64_t>(primitiveBlock.varint());
+                        break;
+                    case BLOCK_LON_OFFSET:
+                        _lonOffset = static_cast<std::int64_t>(primitiveBlock.varint());
+                        break;
+                    default:
+                        primitiveBlock.skip(wireType);
+                        break;
+                }
+            }
+            for (std::string_view group : groups) {
+                decode_group(pbf_message(group));
+            }
+        }
+    };
+
+    static void check_header(std::string_view data) {
+        using namespace pbf_fields;
+        pbf_message header(data);
+        std::uint32_t field, wireType;
+        while (header.next(field, wireType)) {
+            if (field != HEADER_REQUIRED_FEATURES) {
+                header.skip(wireType);
+                continue;
+            }
+            std::string_view feature = header.bytes();
+            if (feature != "OsmSchema-V0.6" && feature != "DenseNodes") {
+                throw std::runtime_error("unsupported pbf feature '" + std::string(feature) + "'");
+            }
+        }
+    }
+
+    static std::uint32_t read_big_endian(const char* data) {
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(data);
+        return (static_cast<std::uint32_t>(bytes[0]) << 24) | (static_cast<std::uint32_t>(bytes[1]) << 16)
+               | (static_cast<std::uint32_t>(bytes[2]) << 8) | static_cast<std::uint32_t>(bytes[3]);
+    }
+
+    /**
+     * Walks the blob headers of the whole file, checking the OSMHeader blob and collecting
+     * the location of every OSMData blob.
+     */
+    static std::vector<pbf_blob_location> index_blobs(const gpp::mapped_file& file) {
+        using namespace pbf_fields;
+        std::vector<pbf_blob_location> blobs;
+        std::vector<char> buffer;
+        std::size_t position = 0;
+        while (position < file.size()) {
+            if (file.size() - position < 4) {
+                throw std::runtime_error("truncated pbf blob header length");
+            }
+            std::size_t headerSize = read_big_endian(file.data() + position);
+            position += 4;
+            if (file.size() - position < headerSize) {
+                throw std::runtime_error("truncated pbf blob header");
+            }
+            pbf_message header(file.data() + position, headerSize);
+            position += headerSize;
+
+            std::string_view type;
+            std::size_t dataSize = 0;
+            std::uint32_t field, wireType;
+            while (header.next(field, wireType)) {
+                if (field == BLOB_HEADER_TYPE) {
+                    type = header.bytes();
+                }
+                else if (field == BLOB_HEADER_DATA_SIZE) {
+                    dataSize = static_cast<std::size_t>(header.varint());
+                }
+                else {
+                    header.skip(wireType);
+                }
+            }
+            if (file.size() - position < dataSize) {
+                throw std::runtime_error("truncated pbf blob");
+            }
+            if (type == "OSMHeader") {
+                check_header(inflate_blob(std::string_view(file.data() + position, dataSize), buffer));
+            }
+            else if (type == "OSMData") {
+                blobs.push_back(pbf_blob_location{position, dataSize});
+            }
+            position += dataSize;
+        }
+        return blobs;
+    }
+
+    void parse_pbf(
+        const std::filesystem::path& file,
+        importer& into,
+        std::size_t numThreads,
+        pbf_elements elements
+    ) {
+        gpp::mapped_file mapped(file);
+        mapped.advise_sequential();
+        std::vector<pbf_blob_location> blobs = index_blobs(mapped);
+
+        if (numThreads == 0) {
+            numThreads = gpp::default_concurrency();
+        }
+        // Blocks are decoded in windows and merged in file order, which keeps memory bounded
+        // and ways always see the nodes that precede them.
+        std::size_t window = numThreads * 4;
+        std::vector<pbf_block> blocks(std::min(window, blobs.size()));
+        std::vector<pbf_scratch> scratches(std::min(numThreads, blocks.size()));
+
+        for (std::size_t first = 0; first < blobs.size(); first += window) {
+            std::size_t count = std::min(window, blobs.size() - first);
+            std::atomic<std::size_t> next(0);
+            gpp::parallel_invoke(
+                std::min(scratches.size(), count), [&](std::size_t worker) {
+                    pbf_scratch& scratch = scratches[worker];
+                    for (std::size_t i = next++; i < count; i = next++) {
+                        const pbf_blob_location& blob = blobs[first + i];
+                        std::string_view data = inflate_blob(
+                            std::string_view(mapped.data() + blob.offset, blob.size),
+                            blocks[i].inflated
+                        );
+                        pbf_block_decoder(into, scratch, blocks[i], elements).decode(data);
+                    }
+                }
+            );
+
+            for (std::size_t i = 0; i < count; ++i) {
+                pbf_block& block = blocks[i];
+                for (std::size_t j = 0; j < block.nodeIds.size(); ++j) {
+                    into.add_node(block.nodeIds[j], block.nodeLocations[j]);
+                }
+                for (const pbf_way& way : block.ways) {
+                    into.add_way(block.refs.data() + way.firstRef, way.numRefs, way.metadata);
+                }
+            }
+        }
+    }
+}
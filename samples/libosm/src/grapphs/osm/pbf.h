@@ -0,0 +1,31 @@
+#ifndef GRAPPHS_PBF_H
+#define GRAPPHS_PBF_H
+
+#include <grapphs/osm/importer.h>
+
+#include <cstdint>
+#include <filesystem>
+
+namespace gpp::osm {
+
+    enum class pbf_elements : std::uint8_t {
+        NODES = 1 << 0,
+        WAYS = 1 << 1,
+        ALL = NODES | WAYS
+    };
+
+    /**
+     * Decodes an .osm.pbf file into \p into. File blocks are inflated and decoded on
+     * \p numThreads threads (0 meaning one per hardware thread), and then handed over to
+     * \p into in file order. Only the kinds of \p elements are decoded.
+     * @throws std::runtime_error if the file is malformed or requires unsupported features.
+     */
+    void parse_pbf(
+        const std::filesystem::path& file,
+        importer& into,
+        std::size_t numThreads,
+        pbf_elements elements = pbf_elements::ALL
+    );
+}
+
+#endif
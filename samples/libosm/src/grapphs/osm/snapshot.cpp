@@ -0,0 +1,176 @@
+#include <grapphs/osm/snapshot.h>
+#include <grapphs/binary.h>
+#include <grapphs/csr_graph.h>
+#include <grapphs/parallel.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace gpp::osm {
+
+    /**
+     * Bumped whenever the meaning of the stored osm_graph data changes, so that old
+     * snapshots are discarded instead of misread.
+     */
+    constexpr std::uint32_t k_snapshot_version = 5;
+
+    enum snapshot_section : std::uint32_t {
+        STAMP = static_cast<std::uint32_t>(gpp::binary_section_id::USER) + 1,
+        METADATA,
+        NAMES
+    };
+
+    struct snapshot_stamp {
+        std::uint64_t sourceSize;
+        std::int64_t sourceModificationTime;
+        std::uint32_t version;
+        std::uint32_t importFlags;
+    };
+
+    struct snapshot_metadata {
+        std::uint64_t nameOffset;
+        std::uint32_t nameLength;
+        float maxSpeed;
+        std::uint8_t flags;
+        std::uint8_t kind;
+        std::uint8_t surface;
+        std::uint8_t reserved;
+    };
+
+    static bool stamp_source(
+        const std::filesystem::path& source,
+        std::uint32_t importFlags,
+        snapshot_stamp& stamp
+    ) {
+        std::error_code error;
+        auto size = std::filesystem::file_size(source, error);
+        if (error) {
+            return false;
+        }
+        auto modificationTime = std::filesystem::last_write_time(source, error);
+        if (error) {
+            return false;
+        }
+        stamp = snapshot_stamp{};
+        stamp.sourceSize = size;
+        stamp.sourceModificationTime = modificationTime.time_since_epoch().count();
+        stamp.version = k_snapshot_version;
+        stamp.importFlags = importFlags;
+        return true;
+    }
+
+    std::filesystem::path snapshot_path(const std::filesystem::path& source) {
+        std::filesystem::path path = source;
+        path += ".gppsnap";
+        return path;
+    }
+
+    bool save_snapshot(
+        const gpp::osm::osm_graph& graph,
+        const std::filesystem::path& source,
+        std::uint32_t importFlags
+    ) {
+        snapshot_stamp stamp{};
+        if (!stamp_source(source, importFlags, stamp)) {
+            return false;
+        }
+
+        auto csr = gpp::to_csr(graph);
+
+        std::vector<snapshot_metadata> metadata;
+        std::string names;
+        const std::vector<way_metadata>& table = graph.get_metadata_table();
+        metadata.reserve(table.size());
+        for (const way_metadata& meta : table) {
+            snapshot_metadata entry{};
+            entry.nameOffset = names.size();
+            entry.nameLength = static_cast<std::uint32_t>(meta.get_name().size());
+            entry.maxSpeed = meta.get_max_speed();
+            entry.flags = static_cast<std::uint8_t>(meta.get_flags());
+            entry.kind = static_cast<std::uint8_t>(meta.get_kind());
+            entry.surface = static_cast<std::uint8_t>(meta.get_surface());
+            names += meta.get_name();
+            metadata.push_back(entry);
+        }
+
+        gpp::binary_writer writer;
+        gpp::add_graph_sections(writer, csr);
+        writer.add_section(snapshot_section::STAMP, &stamp, 1);
+        writer.add_section(snapshot_section::METADATA, metadata);
+        writer.add_section(snapshot_section::NAMES, names.data(), names.size());
+        return writer.write(snapshot_path(source));
+    }
+
+    bool load_snapshot(
+        const std::filesystem::path& source,
+        gpp::osm::osm_graph& into,
+        std::uint32_t importFlags
+    ) {
+        std::filesystem::path path = snapshot_path(source);
+        snapshot_stamp expected{};
+        if (!std::filesystem::exists(path) || !stamp_source(source, importFlags, expected)) {
+            return false;
+        }
+        try {
+            gpp::binary_reader reader(path);
+            std::size_t count;
+            const snapshot_stamp* stamp = reader.section<snapshot_stamp>(snapshot_section::STAMP, count);
+            if (count != 1
+                || stamp->version != expected.version
+                || stamp->importFlags != expected.importFlags
+                || stamp->sourceSize != expected.sourceSize
+                || stamp->sourceModificationTime != expected.sourceModificationTime) {
+                return false;
+            }
+
+            std::size_t numNames;
+            const char* names = reader.section<char>(snapshot_section::NAMES, numNames);
+            std::size_t numMetadata;
+            const auto* metadata = reader.section<snapshot_metadata>(snapshot_section::METADATA, numMetadata);
+            for (std::size_t i = 0; i < numMetadata; ++i) {
+                if (metadata[i].nameOffset + metadata[i].nameLength > numNames) {
+                    return false;
+                }
+            }
+
+            auto mapped = gpp::mapped_graph<osm_node, way>(std::move(reader));
+            for (std::size_t i = 0; i < numMetadata; ++i) {
+                const snapshot_metadata& entry = metadata[i];
+                into.push_meta(
+                    way_metadata(
+                        std::string_view(names + entry.nameOffset, entry.nameLength),
+                        entry.maxSpeed,
+                        static_cast<way_metadata::flags>(entry.flags),
+                        static_cast<way_metadata::kind>(entry.kind),
+                        static_cast<way_metadata::surface>(entry.surface)
+                    )
+                );
+            }
+
+            std::size_t numVertices = mapped.size();
+            into.reserve(numVertices);
+            for (std::size_t i = 0; i < numVertices; ++i) {
+                into.push(*mapped.vertex(i));
+            }
+            gpp::parallel_for(
+                std::size_t(0), numVertices, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        auto& node = into.node(i);
+                        node.reserve(mapped.degree(i));
+                        for (const auto& [to, edge] : mapped.edges_from(i)) {
+                            if (to >= numVertices) {
+                                throw std::runtime_error("edge out of range in snapshot '" + path.string() + "'");
+                            }
+                            node.connect(to, edge);
+                        }
+                    }
+                }
+            );
+        } catch (const std::runtime_error&) {
+            into.clear();
+            return false;
+        }
+        return true;
+    }
+}
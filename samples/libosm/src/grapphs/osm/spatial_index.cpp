@@ -0,0 +1,292 @@
+#include <grapphs/osm/spatial_index.h>
+#include <grapphs/parallel.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace gpp::osm {
+
+    constexpr double k_earth_radius = 6371008.8;
+    constexpr double k_to_radians = 3.14159265358979323846 / 180.0;
+
+    /**
+     * Points whose distances are evaluated at once, sized so the scratch stays on the stack.
+     */
+    constexpr std::size_t k_distance_block = 64;
+
+    spatial_index::spatial_index(const osm_graph& graph, std::size_t pointsPerCell) {
+        std::size_t numVertices = graph.index_bound();
+        _cellOffsets.assign(1, 0);
+        if (numVertices == 0) {
+            return;
+        }
+
+        std::vector<geo_bounds> chunkBounds(gpp::num_chunks(numVertices));
+        gpp::parallel_for(
+            std::size_t(0), numVertices, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+                geo_bounds& bounds = chunkBounds[chunk];
+                for (std::size_t i = begin; i < end; ++i) {
+                    const coordinate& location = graph.vertex(i)->get_location();
+                    bounds.minLongitude = std::min(bounds.minLongitude, location.get_longitude());
+                    bounds.minLatitude = std::min(bounds.minLatitude, location.get_latitude());
+                    bounds.maxLongitude = std::max(bounds.maxLongitude, location.get_longitude());
+                    bounds.maxLatitude = std::max(bounds.maxLatitude, location.get_latitude());
+                }
+            }
+        );
+        for (const geo_bounds& bounds : chunkBounds) {
+            _bounds.minLongitude = std::min(_bounds.minLongitude, bounds.minLongitude);
+            _bounds.minLatitude = std::min(_bounds.minLatitude, bounds.minLatitude);
+            _bounds.maxLongitude = std::max(_bounds.maxLongitude, bounds.maxLongitude);
+            _bounds.maxLatitude = std::max(_bounds.maxLatitude, bounds.maxLatitude);
+        }
+
+        double centerLatitude = (_bounds.minLatitude + _bounds.maxLatitude) / 2;
+        _metersPerLatitude = k_earth_radius * k_to_radians;
+        _metersPerLongitude = _metersPerLatitude * std::cos(centerLatitude * k_to_radians);
+
+        double width = (_bounds.maxLongitude - _bounds.minLongitude) * _metersPerLongitude;
+        double height = (_bounds.maxLatitude - _bounds.minLatitude) * _metersPerLatitude;
+        double numCells = std::max<double>(1, static_cast<double>(numVertices / std::max<std::size_t>(pointsPerCell, 1)));
+        double cellSize = width * height > 0
+                          ? std::sqrt(width * height / numCells)
+                          : std::max(width, height) / numCells;
+        _cellSize = cellSize > 0 ? static_cast<float>(cellSize) : 1.0F;
+        _columns = static_cast<std::size_t>(width / _cellSize) + 1;
+        _rows = static_cast<std::size_t>(height / _cellSize) + 1;
+
+        std::vector<float> xs(numVertices), ys(numVertices);
+        std::vector<std::size_t> cells(numVertices);
+        gpp::parallel_for(
+            std::size_t(0), numVertices, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    const coordinate& location = graph.vertex(i)->get_location();
+                    xs[i] = project_x(location);
+                    ys[i] = project_y(location);
+                    cells[i] = row_of(ys[i]) * _columns + column_of(xs[i]);
+                }
+            }
+        );
+
+        // Counting sort by cell, so that each cell's points are contiguous.
+        _cellOffsets.assign(_columns * _rows + 1, 0);
+        for (std::size_t cell : cells) {
+            _cellOffsets[cell + 1]++;
+        }
+        for (std::size_t i = 1; i < _cellOffsets.size(); ++i) {
+            _cellOffsets[i] += _cellOffsets[i - 1];
+        }
+        std::vector<std::size_t> cursor(_cellOffsets.begin(), _cellOffsets.end() - 1);
+        _xs.resize(numVertices);
+        _ys.resize(numVertices);
+        _vertices.resize(numVertices);
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            std::size_t slot = cursor[cells[i]]++;
+            _xs[slot] = xs[i];
+            _ys[slot] = ys[i];
+            _vertices[slot] = i;
+        }
+    }
+
+    float spatial_index::project_x(const coordinate& location) const {
+        return static_cast<float>((location.get_longitude() - _bounds.minLongitude) * _metersPerLongitude);
+    }
+
+    float spatial_index::project_y(const coordinate& location) const {
+        return static_cast<float>((location.get_latitude() - _bounds.minLatitude) * _metersPerLatitude);
+    }
+
+    std::size_t spatial_index::column_of(float x) const {
+        if (!(x > 0)) {
+            return 0;
+        }
+        return std::min(static_cast<std::size_t>(x / _cellSize), _columns - 1);
+    }
+
+    std::size_t spatial_index::row_of(float y) const {
+        if (!(y > 0)) {
+            return 0;
+        }
+        return std::min(static_cast<std::size_t>(y / _cellSize), _rows - 1);
+    }
+
+    template<typename t_visit>
+    void spatial_index::visit_cell(std::size_t cell, float x, float y, const t_visit& visit) const {
+        std::size_t begin = _cellOffsets[cell];
+        std::size_t end = _cellOffsets[cell + 1];
+        const float* xs = _xs.data();
+        const float* ys = _ys.data();
+        float squared[k_distance_block];
+        for (std::size_t first = begin; first < end; first += k_distance_block) {
+            std::size_t count = std::min(k_distance_block, end - first);
+            // Kept free of branches so that it is vectorized.
+            for (std::size_t i = 0; i < count; ++i) {
+                float dx = xs[first + i] - x;
+                float dy = ys[first + i] - y;
+                squared[i] = dx * dx + dy * dy;
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                visit(first + i, squared[i]);
+            }
+        }
+    }
+
+    /**
+     * Visits cells in rings of growing size around the cell of \p location. After each ring,
+     * \p done is given the squared distance under which every point has been visited.
+     */
+    template<typename t_visit, typename t_done>
+    void spatial_index::search(const coordinate& location, const t_visit& visit, const t_done& done) const {
+        if (empty()) {
+            return;
+        }
+        float x = project_x(location);
+        float y = project_y(location);
+        auto column = static_cast<std::ptrdiff_t>(column_of(x));
+        auto row = static_cast<std::ptrdiff_t>(row_of(y));
+        auto lastColumn = static_cast<std::ptrdiff_t>(_columns) - 1;
+        auto lastRow = static_cast<std::ptrdiff_t>(_rows) - 1;
+        std::ptrdiff_t maxRing = std::max(std::max(column, lastColumn - column), std::max(row, lastRow - row));
+
+        auto visitAt = [&](std::ptrdiff_t c, std::ptrdiff_t r) {
+            visit_cell(static_cast<std::size_t>(r) * _columns + static_cast<std::size_t>(c), x, y, visit);
+        };
+        for (std::ptrdiff_t ring = 0; ring <= maxRing; ++ring) {
+            std::ptrdiff_t minC = std::max<std::ptrdiff_t>(column - ring, 0);
+            std::ptrdiff_t maxC = std::min(column + ring, lastColumn);
+            if (row - ring >= 0) {
+                for (std::ptrdiff_t c = minC; c <= maxC; ++c) {
+                    visitAt(c, row - ring);
+                }
+            }
+            if (ring > 0 && row + ring <= lastRow) {
+                for (std::ptrdiff_t c = minC; c <= maxC; ++c) {
+                    visitAt(c, row + ring);
+                }
+            }
+            std::ptrdiff_t minR = std::max<std::ptrdiff_t>(row - ring + 1, 0);
+            std::ptrdiff_t maxR = std::min(row + ring - 1, lastRow);
+            for (std::ptrdiff_t r = minR; ring > 0 && r <= maxR; ++r) {
+                if (column - ring >= 0) {
+                    visitAt(column - ring, r);
+                }
+                if (column + ring <= lastColumn) {
+                    visitAt(column + ring, r);
+                }
+            }
+            float reach = static_cast<float>(ring) * _cellSize;
+            if (done(reach * reach)) {
+                return;
+            }
+        }
+    }
+
+    std::size_t spatial_index::size() const {
+        return _vertices.size();
+    }
+
+    bool spatial_index::empty() const {
+        return _vertices.empty();
+    }
+
+    const geo_bounds& spatial_index::get_bounds() const {
+        return _bounds;
+    }
+
+    nearest_vertex spatial_index::nearest(const coordinate& location) const {
+        float best = std::numeric_limits<float>::infinity();
+        std::size_t bestSlot = 0;
+        search(
+            location, [&](std::size_t slot, float squared) {
+                if (squared < best) {
+                    best = squared;
+                    bestSlot = slot;
+                }
+            }, [&](float reached) {
+                return best <= reached;
+            }
+        );
+        nearest_vertex result;
+        if (best != std::numeric_limits<float>::infinity()) {
+            result.vertex = _vertices[bestSlot];
+            result.distance = std::sqrt(best);
+        }
+        return result;
+    }
+
+    std::vector<nearest_vertex> spatial_index::k_nearest(const coordinate& location, std::size_t k) const {
+        std::vector<std::pair<float, std::size_t>> heap;
+        if (k == 0) {
+            return {};
+        }
+        heap.reserve(k);
+        search(
+            location, [&](std::size_t slot, float squared) {
+                if (heap.size() < k) {
+                    heap.emplace_back(squared, slot);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (squared < heap.front().first) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = std::make_pair(squared, slot);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }, [&](float reached) {
+                return heap.size() == k && heap.front().first <= reached;
+            }
+        );
+        std::sort_heap(heap.begin(), heap.end());
+        std::vector<nearest_vertex> result(heap.size());
+        for (std::size_t i = 0; i < heap.size(); ++i) {
+            result[i].vertex = _vertices[heap[i].second];
+            result[i].distance = std::sqrt(heap[i].first);
+        }
+        return result;
+    }
+
+    std::vector<nearest_vertex> spatial_index::within_radius(const coordinate& location, float radius) const {
+        std::vector<std::pair<float, std::size_t>> found;
+        if (empty() || radius < 0) {
+            return {};
+        }
+        float x = project_x(location);
+        float y = project_y(location);
+        float squaredRadius = radius * radius;
+        std::size_t lastColumn = column_of(x + radius);
+        std::size_t lastRow = row_of(y + radius);
+        for (std::size_t row = row_of(y - radius); row <= lastRow; ++row) {
+            for (std::size_t column = column_of(x - radius); column <= lastColumn; ++column) {
+                visit_cell(
+                    row * _columns + column, x, y, [&](std::size_t slot, float squared) {
+                        if (squared <= squaredRadius) {
+                            found.emplace_back(squared, slot);
+                        }
+                    }
+                );
+            }
+        }
+        std::sort(found.begin(), found.end());
+        std::vector<nearest_vertex> result(found.size());
+        for (std::size_t i = 0; i < found.size(); ++i) {
+            result[i].vertex = _vertices[found[i].second];
+            result[i].distance = std::sqrt(found[i].first);
+        }
+        return result;
+    }
+
+    void spatial_index::snap(
+        const coordinate* locations,
+        std::size_t count,
+        nearest_vertex* into,
+        std::size_t numThreads
+    ) const {
+        constexpr std::size_t k_snap_grain = 256;
+        gpp::parallel_for(
+            std::size_t(0), count, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    into[i] = nearest(locations[i]);
+                }
+            }, numThreads, k_snap_grain
+        );
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef GRAPPHS_TAGS_H
+#define GRAPPHS_TAGS_H
+
+#include <grapphs/osm/way.h>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace gpp::osm {
+
+    struct tag_view {
+        std::string_view key;
+        std::string_view value;
+    };
+
+    /**
+     * Tag keys understood when classifying ways.
+     */
+    enum class tag_key : std::uint8_t {
+        NAME,
+        SURFACE,
+        LIT,
+        BUILDING,
+        HIGHWAY,
+        LANES,
+        MAX_SPEED,
+        UNKNOWN
+    };
+
+    constexpr std::size_t k_num_tag_keys = static_cast<std::size_t>(tag_key::UNKNOWN);
+
+    /**
+     * Maps a tag key to its tag_key, looking at its length first so that most keys are
+     * rejected without comparing any characters.
+     */
+    constexpr tag_key intern_tag_key(std::string_view key) {
+        switch (key.size()) {
+            case 3:
+                return key == "lit" ? tag_key::LIT : tag_key::UNKNOWN;
+            case 4:
+                return key == "name" ? tag_key::NAME : tag_key::UNKNOWN;
+            case 5:
+                return key == "lanes" ? tag_key::LANES : tag_key::UNKNOWN;
+            case 7:
+                if (key == "highway") {
+                    return tag_key::HIGHWAY;
+                }
+                return key == "surface" ? tag_key::SURFACE : tag_key::UNKNOWN;
+            case 8:
+                if (key == "building") {
+                    return tag_key::BUILDING;
+                }
+                return key == "maxspeed" ? tag_key::MAX_SPEED : tag_key::UNKNOWN;
+            case 9:
+                return key == "max_speed" ? tag_key::MAX_SPEED : tag_key::UNKNOWN;
+            default:
+                return tag_key::UNKNOWN;
+        }
+    }
+
+    template<tag_key... t_keys>
+    struct tag_key_set {
+        static constexpr std::uint32_t mask = (0u | ... | (1u << static_cast<std::uint32_t>(t_keys)));
+
+        static constexpr bool contains(tag_key key) {
+            return key != tag_key::UNKNOWN && ((mask >> static_cast<std::uint32_t>(key)) & 1u) != 0;
+        }
+    };
+
+    /**
+     * Declares which tags are read when classifying ways. Tags whose key is not in
+     * \p t_read are ignored, and ways that carry none of the keys in \p t_required are
+     * skipped before anything else is parsed. An empty \p t_required keeps every way.
+     */
+    template<typename t_read, typename t_required = tag_key_set<>>
+    struct tag_profile {
+        using read = t_read;
+        using required = t_required;
+    };
+
+    using default_tag_profile = tag_profile<
+        tag_key_set<
+            tag_key::NAME,
+            tag_key::SURFACE,
+            tag_key::LIT,
+            tag_key::BUILDING,
+            tag_key::HIGHWAY,
+            tag_key::LANES,
+            tag_key::MAX_SPEED
+        >
+    >;
+
+    using routing_tag_profile = tag_profile<
+        tag_key_set<
+            tag_key::NAME,
+            tag_key::SURFACE,
+            tag_key::LIT,
+            tag_key::HIGHWAY,
+            tag_key::LANES,
+            tag_key::MAX_SPEED
+        >,
+        tag_key_set<tag_key::HIGHWAY, tag_key::LANES>
+    >;
+
+    /**
+     * Values of the tags a profile read from a way, indexed by tag_key. Missing tags are empty.
+     */
+    using tag_values = std::array<std::string_view, k_num_tag_keys>;
+
+    /**
+     * Builds the metadata of a way from the values of its tags. The name of the result
+     * references the name in \p values. Safe to call concurrently.
+     */
+    way_metadata make_way_metadata(const tag_values& values);
+
+    /**
+     * Classifies a way in a single pass over its tags. \p tagAt is called with every index
+     * below \p numTags and returns the tag_view at that index.
+     * @returns false, leaving \p metadata untouched, if the way is skipped by \p t_profile.
+     */
+    template<typename t_profile, typename t_tag_at>
+    bool classify_way(std::size_t numTags, const t_tag_at& tagAt, way_metadata& metadata) {
+        tag_values values{};
+        std::uint32_t present = 0;
+        for (std::size_t i = 0; i < numTags; ++i) {
+            tag_view tag = tagAt(i);
+            tag_key key = intern_tag_key(tag.key);
+            if (!t_profile::read::contains(key)) {
+                continue;
+            }
+            values[static_cast<std::size_t>(key)] = tag.value;
+            present |= 1u << static_cast<std::uint32_t>(key);
+        }
+        constexpr std::uint32_t required = t_profile::required::mask;
+        if (required != 0 && (present & required) == 0) {
+            return false;
+        }
+        metadata = make_way_metadata(values);
+        return true;
+    }
+}
+
+#endif
@@ -1,4 +1,8 @@
 #include <grapphs/osm/way.h>
+#include <grapphs/parallel.h>
+
+#include <algorithm>
+#include <cmath>
 
 namespace gpp::osm {
 
@@ -31,20 +35,46 @@ namespace gpp::osm {
         return os;
     }
 
-    way::way(size_t metadataIndex) : _metadataIndex(metadataIndex) {
+    double haversine_distance(const coordinate& a, const coordinate& b) {
+        constexpr double k_earth_radius = 6371008.8;
+        constexpr double k_to_radians = 3.14159265358979323846 / 180.0;
+        double latA = a.get_latitude() * k_to_radians;
+        double latB = b.get_latitude() * k_to_radians;
+        double sinLat = std::sin((latB - latA) / 2);
+        double sinLon = std::sin((b.get_longitude() - a.get_longitude()) * k_to_radians / 2);
+        double h = sinLat * sinLat + std::cos(latA) * std::cos(latB) * sinLon * sinLon;
+        return 2 * k_earth_radius * std::asin(std::min(1.0, std::sqrt(h)));
+    }
+
+    way::way(size_t metadataIndex)
+        : _metadataIndex(static_cast<std::uint32_t>(metadataIndex)), _length(0), _travelTime(0) {
     }
 
     size_t way::get_metadata_index() const {
         return _metadataIndex;
     }
 
+    float way::get_length() const {
+        return _length;
+    }
+
+    float way::get_travel_time() const {
+        return _travelTime;
+    }
+
+    void way::set_weights(float length, float travelTime) {
+        _length = length;
+        _travelTime = travelTime;
+    }
+
     std::ostream& operator<<(std::ostream& os, const way& way) {
         os << "_metadataIndex: " << way._metadataIndex;
         return os;
     }
 
-    way_metadata::flags operator|=(way_metadata::flags a, way_metadata::flags b) {
-        return a | b;
+    way_metadata::flags& operator|=(way_metadata::flags& a, way_metadata::flags b) {
+        a = a | b;
+        return a;
     }
 
     way_metadata::flags operator|(way_metadata::flags a, way_metadata::flags b) {
@@ -58,7 +88,7 @@ namespace gpp::osm {
         return _metadataIndex != invalid_metadata();
     }
 
-    const std::string& way_metadata::get_name() const {
+    std::string_view way_metadata::get_name() const {
         return _name;
     }
 
@@ -71,7 +101,7 @@ namespace gpp::osm {
     }
 
     way_metadata::way_metadata(
-        const std::string& name,
+        std::string_view name,
         float maxSpeed,
         way_metadata::flags flags,
         way_metadata::kind kind,
@@ -87,18 +117,100 @@ namespace gpp::osm {
         return _kind;
     }
 
-    std::size_t osm_graph::push_meta(way_metadata&& metadata) {
+    bool way_metadata::operator==(const way_metadata& other) const {
+        return _name == other._name
+               && _maxSpeed == other._maxSpeed
+               && _flags == other._flags
+               && _kind == other._kind
+               && _surface == other._surface;
+    }
+
+    std::size_t osm_graph::metadata_hash::operator()(const way_metadata& metadata) const {
+        std::size_t hash = std::hash<std::string_view>()(metadata.get_name());
+        auto combine = [&hash](std::size_t value) {
+            hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        };
+        combine(std::hash<float>()(metadata.get_max_speed()));
+        combine(static_cast<std::size_t>(metadata.get_flags()));
+        combine(static_cast<std::size_t>(metadata.get_kind()));
+        combine(static_cast<std::size_t>(metadata.get_surface()));
+        return hash;
+    }
+
+    void osm_graph::clear() {
+        gpp::adjacency_list<osm_node, way>::clear();
+        _metadata.clear();
+        _metadataIndices.clear();
+        _names.clear();
+    }
+
+    std::size_t osm_graph::push_meta(const way_metadata& metadata) {
+        auto existing = _metadataIndices.find(metadata);
+        if (existing != _metadataIndices.end()) {
+            return existing->second;
+        }
+        std::string_view name = *_names.emplace(metadata.get_name()).first;
         std::size_t i = _metadata.size();
-        _metadata.push_back(std::move(metadata));
+        _metadata.emplace_back(
+            name,
+            metadata.get_max_speed(),
+            metadata.get_flags(),
+            metadata.get_kind(),
+            metadata.get_surface()
+        );
+        _metadataIndices.emplace(_metadata.back(), i);
         return i;
     }
 
-    bool osm_graph::get_metadata(const way& way, way_metadata& metadata) {
+    const way_metadata* osm_graph::get_metadata(const way& way) const {
         std::size_t index = way.get_metadata_index();
         if (index >= _metadata.size()) {
-            return false;
+            return nullptr;
+        }
+        return &_metadata[index];
+    }
+
+    const std::vector<way_metadata>& osm_graph::get_metadata_table() const {
+        return _metadata;
+    }
+
+    /**
+     * Speed in km/h assumed for ways of each kind that have no max speed.
+     */
+    static float default_speed(way_metadata::kind kind) {
+        switch (kind) {
+            case way_metadata::kind::WAY:
+                return 20;
+            case way_metadata::kind::ROAD:
+                return 40;
+            case way_metadata::kind::AVENUE:
+                return 60;
+            case way_metadata::kind::HIGHWAY:
+                return 90;
+            default:
+                return 30;
         }
-        metadata = _metadata[index];
-        return true;
     }
-}
\ No newline at end of file
+
+    void osm_graph::compute_weights() {
+        std::size_t numVertices = index_bound();
+        gpp::parallel_for(
+            std::size_t(0), numVertices, [this](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    const coordinate& from = vertex(i)->get_location();
+                    for (auto& [to, edge] : node(i).connections()) {
+                        double meters = haversine_distance(from, vertex(to)->get_location());
+                        const way_metadata* metadata = get_metadata(edge);
+                        float speed = metadata != nullptr ? metadata->get_max_speed() : -1;
+                        if (speed <= 0) {
+                            speed = default_speed(
+                                metadata != nullptr ? metadata->get_kind() : way_metadata::kind::UNKNOWN
+                            );
+                        }
+                        edge.set_weights(static_cast<float>(meters), static_cast<float>(meters * 3.6 / speed));
+                    }
+                }
+            }
+        );
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef GRAPPHS_OSM_GRAPH_HELPER_H
+#define GRAPPHS_OSM_GRAPH_HELPER_H
+
+#include <grapphs/osm/way.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace gpp::osm::tests {
+
+    using edge_entry = std::tuple<std::size_t, std::size_t, std::string_view>;
+
+    /**
+     * @returns Every edge of \p graph with the name of its way, sorted.
+     */
+    inline std::vector<edge_entry> list_edges(const gpp::osm::osm_graph& graph) {
+        std::vector<edge_entry> edges;
+        for (std::size_t i = 0; i < graph.size(); ++i) {
+            for (const auto& [to, edge] : graph.node(i).connections()) {
+                const gpp::osm::way_metadata* metadata = graph.get_metadata(edge);
+                edges.emplace_back(i, to, metadata != nullptr ? metadata->get_name() : "");
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        return edges;
+    }
+
+    inline void expect_same_graph(const gpp::osm::osm_graph& a, const gpp::osm::osm_graph& b) {
+        ASSERT_EQ(a.size(), b.size());
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            const coordinate& locationA = a.vertex(i)->get_location();
+            const coordinate& locationB = b.vertex(i)->get_location();
+            EXPECT_EQ(locationA.get_longitude(), locationB.get_longitude());
+            EXPECT_EQ(locationA.get_latitude(), locationB.get_latitude());
+        }
+        EXPECT_EQ(list_edges(a), list_edges(b));
+    }
+}
+
+#endif
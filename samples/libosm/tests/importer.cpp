@@ -0,0 +1,145 @@
+#include <grapphs/osm/parse.h>
+#include <grapphs/osm/importer.h>
+
+#include "graph_helper.h"
+#include "pbf_writer.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <vector>
+
+using gpp::osm::tests::pbf_compression;
+
+namespace {
+
+    /**
+     * Mixes routable ways with a building, an untagged path and a point of interest. Nodes
+     * come in id order, so that both import modes push the vertices they keep in the same
+     * order.
+     */
+    std::filesystem::path write_mixed_fixture() {
+        gpp::osm::tests::pbf_file_writer writer;
+        writer.dense_nodes(
+            {
+                {1, -49.270, -25.430},
+                {2, -49.271, -25.430},
+                {3, -49.272, -25.430},
+                {4, -49.275, -25.435},
+                {5, -49.276, -25.435}
+            }, pbf_compression::ZLIB
+        );
+        writer.dense_nodes(
+            {
+                {6, -49.280, -25.440},
+                {7, -49.272, -25.431},
+                {8, -49.273, -25.432},
+                {9, -49.273, -25.430}
+            }, pbf_compression::RAW
+        );
+        writer.ways(
+            {
+                {100, {1, 2, 3}, {{"highway", "residential"}, {"name", "Main"}}},
+                {101, {4, 5, 4}, {{"building", "yes"}, {"name", "House"}}},
+                {102, {3, 8}, {{"name", "Trail"}}},
+                {103, {3, 7, 42}, {{"lanes", "2"}, {"name", "Side"}}},
+                {104, {9, 3}, {{"highway", "primary"}, {"name", "Long"}, {"maxspeed", "60"}}}
+            }, pbf_compression::ZLIB
+        );
+        std::filesystem::path file = std::filesystem::temp_directory_path() / "grapphs_routable.osm.pbf";
+        writer.write(file);
+        return file;
+    }
+
+    void parse_fixture(const std::filesystem::path& file, gpp::osm::osm_graph& into, bool routableOnly) {
+        gpp::osm::parse_options options;
+        options.useSnapshot = false;
+        options.numThreads = 1;
+        options.routableOnly = routableOnly;
+        gpp::osm::parse(file, into, options);
+    }
+
+    /**
+     * Copies the routable edges of \p graph, and the vertices they connect, into \p into.
+     */
+    void filter_routable(const gpp::osm::osm_graph& graph, gpp::osm::osm_graph& into) {
+        auto isRoutable = [&graph](const gpp::osm::way& edge) {
+            const gpp::osm::way_metadata* metadata = graph.get_metadata(edge);
+            return metadata != nullptr && gpp::osm::is_routable(*metadata);
+        };
+        std::vector<bool> used(graph.size(), false);
+        for (std::size_t i = 0; i < graph.size(); ++i) {
+            for (const auto& [to, edge] : graph.node(i).connections()) {
+                if (isRoutable(edge)) {
+                    used[i] = true;
+                    used[to] = true;
+                }
+            }
+        }
+        std::vector<std::size_t> remapped(graph.size());
+        for (std::size_t i = 0; i < graph.size(); ++i) {
+            if (used[i]) {
+                remapped[i] = into.push(*graph.vertex(i));
+            }
+        }
+        for (std::size_t i = 0; i < graph.size(); ++i) {
+            for (const auto& [to, edge] : graph.node(i).connections()) {
+                if (isRoutable(edge)) {
+                    std::size_t metadataIndex = into.push_meta(*graph.get_metadata(edge));
+                    into.connect(remapped[i], remapped[to], gpp::osm::way(metadataIndex));
+                }
+            }
+        }
+        into.compute_weights();
+    }
+}
+
+TEST(grapphs_osm, routable_only_import) {
+    std::filesystem::path file = write_mixed_fixture();
+    gpp::osm::osm_graph graph;
+    parse_fixture(file, graph, true);
+
+    // Only nodes 1, 2, 3, 7 and 9 are referenced by routable ways, and 42 is not in the file.
+    ASSERT_EQ(graph.size(), 5);
+    double expectedLongitudes[] = {-49.270, -49.271, -49.272, -49.272, -49.273};
+    double expectedLatitudes[] = {-25.430, -25.430, -25.430, -25.431, -25.430};
+    for (std::size_t i = 0; i < graph.size(); ++i) {
+        EXPECT_NEAR(graph.vertex(i)->get_location().get_longitude(), expectedLongitudes[i], 1e-9);
+        EXPECT_NEAR(graph.vertex(i)->get_location().get_latitude(), expectedLatitudes[i], 1e-9);
+    }
+
+    std::vector<gpp::osm::tests::edge_entry> expected = {
+        {0, 1, "Main"},
+        {1, 2, "Main"},
+        {2, 3, "Side"},
+        {4, 2, "Long"}
+    };
+    EXPECT_EQ(gpp::osm::tests::list_edges(graph), expected);
+    for (const gpp::osm::way_metadata& metadata : graph.get_metadata_table()) {
+        EXPECT_TRUE(gpp::osm::is_routable(metadata));
+    }
+    std::filesystem::remove(file);
+}
+
+TEST(grapphs_osm, routable_only_matches_filtered_import) {
+    std::filesystem::path file = write_mixed_fixture();
+    gpp::osm::osm_graph full;
+    parse_fixture(file, full, false);
+    EXPECT_EQ(full.size(), 9);
+
+    gpp::osm::osm_graph filtered;
+    filter_routable(full, filtered);
+    gpp::osm::osm_graph routable;
+    parse_fixture(file, routable, true);
+
+    gpp::osm::tests::expect_same_graph(filtered, routable);
+    for (std::size_t i = 0; i < routable.size(); ++i) {
+        for (const auto& [to, edge] : routable.node(i).connections()) {
+            const gpp::osm::way* filteredEdge = filtered.edge(i, to);
+            ASSERT_NE(filteredEdge, nullptr);
+            EXPECT_TRUE(*filtered.get_metadata(*filteredEdge) == *routable.get_metadata(edge));
+            EXPECT_EQ(filtered.travel_time_of(*filteredEdge), routable.travel_time_of(edge));
+        }
+    }
+    std::filesystem::remove(file);
+}
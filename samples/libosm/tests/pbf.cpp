@@ -0,0 +1,178 @@
+#include <grapphs/osm/pbf.h>
+
+#include "graph_helper.h"
+#include "pbf_writer.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using gpp::osm::tests::pbf_compression;
+using gpp::osm::tests::pbf_file_writer;
+
+namespace {
+
+    std::filesystem::path fixture_path(const std::string& name) {
+        return std::filesystem::temp_directory_path() / ("grapphs_" + name + ".osm.pbf");
+    }
+
+    void import_pbf(const std::filesystem::path& file, gpp::osm::osm_graph& into, std::size_t numThreads) {
+        gpp::osm::importer importer(&into);
+        gpp::osm::parse_pbf(file, importer, numThreads);
+        importer.finish();
+    }
+
+    void expect_location(const gpp::osm::osm_graph& graph, std::size_t index, double longitude, double latitude) {
+        const gpp::osm::coordinate& location = graph.vertex(index)->get_location();
+        EXPECT_NEAR(location.get_longitude(), longitude, 1e-9);
+        EXPECT_NEAR(location.get_latitude(), latitude, 1e-9);
+    }
+}
+
+TEST(grapphs_osm, pbf_dense_nodes_and_ways) {
+    pbf_file_writer writer;
+    // Ids and coordinates go up and down, so that deltas take both signs.
+    writer.dense_nodes(
+        {
+            {20, -49.2701, -25.4301},
+            {10, -49.2700, -25.4310},
+            {11, -49.2712, -25.4305},
+            {3000000000, 12.5, 41.9}
+        }, pbf_compression::ZLIB
+    );
+    writer.ways(
+        {
+            {1, {10, 11, 20}, {{"highway", "residential"}, {"name", "Rua XV"}, {"maxspeed", "40"}}},
+            {2, {20, 99, 3000000000}, {{"highway", "service"}, {"name", "Missing"}}},
+            {3, {11, 20}, {{"building", "yes"}}}
+        }, pbf_compression::RAW
+    );
+    std::filesystem::path file = fixture_path("dense");
+    writer.write(file);
+
+    gpp::osm::osm_graph graph;
+    import_pbf(file, graph, 1);
+
+    ASSERT_EQ(graph.size(), 4);
+    expect_location(graph, 0, -49.2701, -25.4301);
+    expect_location(graph, 1, -49.2700, -25.4310);
+    expect_location(graph, 2, -49.2712, -25.4305);
+    expect_location(graph, 3, 12.5, 41.9);
+
+    // Segments through node 99, which is not in the file, are skipped, and the only segment
+    // of the building was already added by the road.
+    std::vector<gpp::osm::tests::edge_entry> expected = {
+        {1, 2, "Rua XV"},
+        {2, 0, "Rua XV"}
+    };
+    EXPECT_EQ(gpp::osm::tests::list_edges(graph), expected);
+
+    const gpp::osm::way_metadata* metadata = graph.get_metadata(*graph.edge(1, 2));
+    ASSERT_NE(metadata, nullptr);
+    EXPECT_EQ(metadata->get_kind(), gpp::osm::way_metadata::kind::HIGHWAY);
+    EXPECT_EQ(metadata->get_max_speed(), 40);
+    std::filesystem::remove(file);
+}
+
+TEST(grapphs_osm, pbf_plain_nodes_and_compression) {
+    for (pbf_compression compression : {pbf_compression::RAW, pbf_compression::ZLIB}) {
+        pbf_file_writer writer;
+        writer.nodes({{5, 1.5, 2.5}, {4, -1.25, -2.75}}, compression);
+        writer.ways({{1, {4, 5}, {{"lanes", "2"}}}}, compression);
+        std::filesystem::path file = fixture_path("plain");
+        writer.write(file);
+
+        gpp::osm::osm_graph graph;
+        import_pbf(file, graph, 1);
+
+        ASSERT_EQ(graph.size(), 2);
+        expect_location(graph, 0, 1.5, 2.5);
+        expect_location(graph, 1, -1.25, -2.75);
+        ASSERT_NE(graph.edge(1, 0), nullptr);
+        const gpp::osm::way_metadata* metadata = graph.get_metadata(*graph.edge(1, 0));
+        ASSERT_NE(metadata, nullptr);
+        EXPECT_EQ(metadata->get_kind(), gpp::osm::way_metadata::kind::ROAD);
+        std::filesystem::remove(file);
+    }
+}
+
+TEST(grapphs_osm, pbf_thread_count_independence) {
+    // 30 blocks span several decode windows of 4 blocks per thread, and ways reference
+    // nodes from earlier windows.
+    pbf_file_writer writer;
+    std::int64_t nextId = 1;
+    for (std::size_t block = 0; block < 15; ++block) {
+        std::vector<gpp::osm::tests::pbf_test_node> nodes;
+        std::vector<gpp::osm::tests::pbf_test_way> ways;
+        for (std::size_t i = 0; i < 20; ++i, ++nextId) {
+            nodes.push_back({nextId, -49.3 + 0.001 * block, -25.4 + 0.0001 * i});
+            if (nextId > 30) {
+                std::string name = "Way " + std::to_string(nextId);
+                ways.push_back({nextId, {nextId - 30, nextId - 1, nextId}, {{"highway", "primary"}, {"name", name}}});
+            }
+        }
+        pbf_compression compression = block % 2 == 0 ? pbf_compression::ZLIB : pbf_compression::RAW;
+        writer.dense_nodes(nodes, compression);
+        writer.ways(ways, compression);
+    }
+    std::filesystem::path file = fixture_path("windows");
+    writer.write(file);
+
+    gpp::osm::osm_graph single;
+    import_pbf(file, single, 1);
+    EXPECT_EQ(single.size(), 300);
+    EXPECT_EQ(gpp::osm::tests::list_edges(single).size(), 2 * (300 - 30));
+    for (std::size_t numThreads : {2, 3}) {
+        gpp::osm::osm_graph multi;
+        import_pbf(file, multi, numThreads);
+        gpp::osm::tests::expect_same_graph(single, multi);
+    }
+    std::filesystem::remove(file);
+}
+
+TEST(grapphs_osm, pbf_unsupported) {
+    std::filesystem::path file = fixture_path("unsupported");
+    gpp::osm::osm_graph graph;
+
+    pbf_file_writer historical({"OsmSchema-V0.6", "DenseNodes", "HistoricalInformation"});
+    historical.write(file);
+    EXPECT_THROW(import_pbf(file, graph, 1), std::runtime_error);
+
+    pbf_file_writer lzma;
+    lzma.dense_nodes({{1, 0, 0}}, pbf_compression::UNSUPPORTED);
+    lzma.write(file);
+    EXPECT_THROW(import_pbf(file, graph, 1), std::runtime_error);
+    std::filesystem::remove(file);
+}
+
+TEST(grapphs_osm, pbf_truncated) {
+    pbf_file_writer writer;
+    writer.dense_nodes({{1, 0, 0}, {2, 1, 1}}, pbf_compression::RAW);
+    std::size_t lastBlob = writer.str().size();
+    writer.ways({{1, {1, 2}, {{"highway", "primary"}}}}, pbf_compression::ZLIB);
+    std::size_t fullSize = writer.str().size();
+    std::filesystem::path file = fixture_path("truncated");
+
+    // Cut inside the length of the blob header, the header itself, and the blob.
+    for (std::size_t size : {lastBlob + 2, lastBlob + 6, fullSize - 1}) {
+        writer.write(file, size);
+        gpp::osm::osm_graph graph;
+        EXPECT_THROW(import_pbf(file, graph, 1), std::runtime_error) << size;
+    }
+
+    // Blob sizes that check out, with a block cut short inside.
+    pbf_file_writer shortBlock;
+    shortBlock.dense_nodes({{1, 0, 0}, {2, 1, 1}}, pbf_compression::RAW);
+    std::string bytes = shortBlock.str();
+    bytes.back() = static_cast<char>(0x80);
+    {
+        std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+        stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    gpp::osm::osm_graph graph;
+    EXPECT_THROW(import_pbf(file, graph, 1), std::runtime_error);
+    std::filesystem::remove(file);
+}
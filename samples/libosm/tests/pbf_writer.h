@@ -0,0 +1,252 @@
+#ifndef GRAPPHS_PBF_WRITER_H
+#define GRAPPHS_PBF_WRITER_H
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace gpp::osm::tests {
+
+    /**
+     * Minimal writer for the protocol buffers wire format, the counterpart of the reader
+     * in pbf.cpp, used to generate .osm.pbf fixtures.
+     */
+    class pbf_message_writer {
+    private:
+        std::string _bytes;
+
+        void key(std::uint32_t field, std::uint32_t wireType) {
+            raw_varint((static_cast<std::uint64_t>(field) << 3) | wireType);
+        }
+
+        static std::uint64_t zigzag(std::int64_t value) {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+    public:
+        void raw_varint(std::uint64_t value) {
+            while (value >= 0x80) {
+                _bytes.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            _bytes.push_back(static_cast<char>(value));
+        }
+
+        pbf_message_writer& varint(std::uint32_t field, std::uint64_t value) {
+            key(field, 0);
+            raw_varint(value);
+            return *this;
+        }
+
+        pbf_message_writer& svarint(std::uint32_t field, std::int64_t value) {
+            return varint(field, zigzag(value));
+        }
+
+        pbf_message_writer& bytes(std::uint32_t field, std::string_view value) {
+            key(field, 2);
+            raw_varint(value.size());
+            _bytes.append(value.data(), value.size());
+            return *this;
+        }
+
+        pbf_message_writer& packed_varints(std::uint32_t field, const std::vector<std::uint64_t>& values) {
+            pbf_message_writer packed;
+            for (std::uint64_t value : values) {
+                packed.raw_varint(value);
+            }
+            return bytes(field, packed.str());
+        }
+
+        /**
+         * Writes \p values delta coded, as DenseNodes columns and way refs are.
+         */
+        pbf_message_writer& packed_deltas(std::uint32_t field, const std::vector<std::int64_t>& values) {
+            pbf_message_writer packed;
+            std::int64_t previous = 0;
+            for (std::int64_t value : values) {
+                packed.raw_varint(zigzag(value - previous));
+                previous = value;
+            }
+            return bytes(field, packed.str());
+        }
+
+        const std::string& str() const {
+            return _bytes;
+        }
+    };
+
+    struct pbf_test_node {
+        std::int64_t id;
+        double longitude;
+        double latitude;
+    };
+
+    struct pbf_test_way {
+        std::int64_t id;
+        std::vector<std::int64_t> refs;
+        std::vector<std::pair<std::string, std::string>> tags;
+    };
+
+    /**
+     * UNSUPPORTED stores data as LZMA, which the decoder does not implement.
+     */
+    enum class pbf_compression {
+        RAW, ZLIB, UNSUPPORTED
+    };
+
+    /**
+     * Builds an .osm.pbf file block by block. Every OSMData block holds a single primitive
+     * group, with coordinates stored at the default granularity of 100 nanodegrees.
+     */
+    class pbf_file_writer {
+    private:
+        std::string _file;
+
+        void blob(std::string_view type, const std::string& data, pbf_compression compression) {
+            pbf_message_writer blob;
+            if (compression == pbf_compression::RAW) {
+                blob.bytes(1, data);
+            }
+            else if (compression == pbf_compression::UNSUPPORTED) {
+                blob.varint(2, data.size());
+                blob.bytes(4, data);
+            }
+            else {
+                std::string compressed(compressBound(static_cast<uLong>(data.size())), '\0');
+                auto compressedSize = static_cast<uLongf>(compressed.size());
+                compress(
+                    reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+                    reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size())
+                );
+                compressed.resize(compressedSize);
+                blob.varint(2, data.size());
+                blob.bytes(3, compressed);
+            }
+            pbf_message_writer header;
+            header.bytes(1, type);
+            header.varint(3, blob.str().size());
+
+            auto headerSize = static_cast<std::uint32_t>(header.str().size());
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                _file.push_back(static_cast<char>((headerSize >> shift) & 0xFF));
+            }
+            _file += header.str();
+            _file += blob.str();
+        }
+
+        static std::int64_t to_nanodegrees(double degrees) {
+            return std::llround(degrees * 1e7);
+        }
+
+        void data_block(
+            const std::vector<std::string>& strings,
+            std::uint32_t groupField,
+            const std::vector<std::string>& elements,
+            pbf_compression compression
+        ) {
+            pbf_message_writer table;
+            for (const std::string& string : strings) {
+                table.bytes(1, string);
+            }
+            pbf_message_writer group;
+            for (const std::string& element : elements) {
+                group.bytes(groupField, element);
+            }
+            pbf_message_writer block;
+            block.bytes(1, table.str());
+            block.bytes(2, group.str());
+            blob("OSMData", block.str(), compression);
+        }
+
+    public:
+        explicit pbf_file_writer(
+            const std::vector<std::string>& requiredFeatures = {"OsmSchema-V0.6", "DenseNodes"}
+        ) {
+            pbf_message_writer header;
+            for (const std::string& feature : requiredFeatures) {
+                header.bytes(4, feature);
+            }
+            blob("OSMHeader", header.str(), pbf_compression::RAW);
+        }
+
+        void dense_nodes(const std::vector<pbf_test_node>& nodes, pbf_compression compression) {
+            std::vector<std::int64_t> ids, lats, lons;
+            for (const pbf_test_node& node : nodes) {
+                ids.push_back(node.id);
+                lats.push_back(to_nanodegrees(node.latitude));
+                lons.push_back(to_nanodegrees(node.longitude));
+            }
+            pbf_message_writer dense;
+            dense.packed_deltas(1, ids);
+            dense.packed_deltas(8, lats);
+            dense.packed_deltas(9, lons);
+            data_block({""}, 2, {dense.str()}, compression);
+        }
+
+        /**
+         * Writes \p nodes as plain Node messages instead of DenseNodes.
+         */
+        void nodes(const std::vector<pbf_test_node>& nodes, pbf_compression compression) {
+            std::vector<std::string> messages;
+            for (const pbf_test_node& node : nodes) {
+                pbf_message_writer message;
+                message.svarint(1, node.id);
+                message.svarint(8, to_nanodegrees(node.latitude));
+                message.svarint(9, to_nanodegrees(node.longitude));
+                messages.push_back(message.str());
+            }
+            data_block({""}, 1, messages, compression);
+        }
+
+        void ways(const std::vector<pbf_test_way>& ways, pbf_compression compression) {
+            std::vector<std::string> strings = {""};
+            auto intern = [&strings](const std::string& string) {
+                for (std::size_t i = 0; i < strings.size(); ++i) {
+                    if (strings[i] == string) {
+                        return static_cast<std::uint64_t>(i);
+                    }
+                }
+                strings.push_back(string);
+                return static_cast<std::uint64_t>(strings.size() - 1);
+            };
+            std::vector<std::string> messages;
+            for (const pbf_test_way& way : ways) {
+                std::vector<std::uint64_t> keys, values;
+                for (const auto& [key, value] : way.tags) {
+                    keys.push_back(intern(key));
+                    values.push_back(intern(value));
+                }
+                pbf_message_writer message;
+                message.varint(1, static_cast<std::uint64_t>(way.id));
+                message.packed_varints(2, keys);
+                message.packed_varints(3, values);
+                message.packed_deltas(8, way.refs);
+                messages.push_back(message.str());
+            }
+            data_block(strings, 3, messages, compression);
+        }
+
+        const std::string& str() const {
+            return _file;
+        }
+
+        void write(const std::filesystem::path& path, std::size_t size = std::string::npos) const {
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            stream.write(_file.data(), static_cast<std::streamsize>(std::min(size, _file.size())));
+            if (!stream) {
+                throw std::runtime_error("unable to write '" + path.string() + "'");
+            }
+        }
+    };
+}
+
+#endif
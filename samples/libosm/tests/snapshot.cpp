@@ -0,0 +1,180 @@
+#include <grapphs/osm/snapshot.h>
+#include <grapphs/binary.h>
+
+#include "graph_helper.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+    /**
+     * Section holding the stamp of a snapshot, which follows the sections of the graph.
+     */
+    constexpr std::uint32_t k_stamp_section = static_cast<std::uint32_t>(gpp::binary_section_id::USER) + 1;
+
+    /**
+     * Offset of the format version within the stamp, after the size and modification time
+     * of the source.
+     */
+    constexpr std::size_t k_stamp_version_offset = 16;
+
+    /**
+     * Source file of a snapshot, removed along with its snapshot once out of scope.
+     */
+    struct snapshot_source {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "grapphs_snapshot.osm";
+
+        snapshot_source() {
+            std::ofstream(path, std::ios::trunc) << "<osm version=\"0.6\"></osm>\n";
+        }
+
+        ~snapshot_source() {
+            std::filesystem::remove(gpp::osm::snapshot_path(path));
+            std::filesystem::remove(path);
+        }
+    };
+
+    void build_snapshot_graph(gpp::osm::osm_graph& graph) {
+        using flags = gpp::osm::way_metadata::flags;
+        using kind = gpp::osm::way_metadata::kind;
+        using surface = gpp::osm::way_metadata::surface;
+        graph.push(gpp::osm::osm_node(gpp::osm::coordinate(-49.27, -25.43)));
+        graph.push(gpp::osm::osm_node(gpp::osm::coordinate(-49.271, -25.431)));
+        graph.push(gpp::osm::osm_node(gpp::osm::coordinate(-49.2695, -25.4302)));
+        std::size_t avenue = graph.push_meta(
+            gpp::osm::way_metadata("Rua XV", 60, flags::LIT | flags::SIDEWALK_BOTH, kind::AVENUE, surface::ASPHALT)
+        );
+        std::size_t road = graph.push_meta(
+            gpp::osm::way_metadata("Rua XV", -1, flags(), kind::ROAD, surface::DIRT)
+        );
+        graph.connect(0, 1, gpp::osm::way(avenue));
+        graph.connect(1, 0, gpp::osm::way(avenue));
+        graph.connect(1, 2, gpp::osm::way(road));
+        graph.connect(2, 0, gpp::osm::way());
+        graph.compute_weights();
+    }
+
+    /**
+     * Overwrites the bytes at \p offset within section \p id of the snapshot of \p source
+     * with \p value.
+     */
+    template<typename t_value>
+    void patch_snapshot(
+        const std::filesystem::path& source,
+        std::uint32_t id,
+        std::size_t offset,
+        const t_value& value
+    ) {
+        std::fstream file(gpp::osm::snapshot_path(source), std::ios::in | std::ios::out | std::ios::binary);
+        gpp::binary_header header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        for (std::uint32_t i = 0; i < header.numSections; ++i) {
+            gpp::binary_section section{};
+            file.read(reinterpret_cast<char*>(&section), sizeof(section));
+            if (section.id == id) {
+                ASSERT_LE(offset + sizeof(value), section.elementSize * section.count);
+                file.seekp(static_cast<std::streamoff>(section.offset + offset));
+                file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+                return;
+            }
+        }
+        FAIL() << "missing section";
+    }
+}
+
+TEST(grapphs_osm, snapshot_round_trip) {
+    snapshot_source source;
+    gpp::osm::osm_graph graph;
+    build_snapshot_graph(graph);
+    ASSERT_TRUE(gpp::osm::save_snapshot(graph, source.path, 1));
+    gpp::osm::osm_graph loaded;
+    ASSERT_TRUE(gpp::osm::load_snapshot(source.path, loaded, 1));
+
+    gpp::osm::tests::expect_same_graph(graph, loaded);
+    for (std::size_t i = 0; i < graph.size(); ++i) {
+        for (const auto& [to, edge] : graph.node(i).connections()) {
+            const gpp::osm::way* loadedEdge = loaded.edge(i, to);
+            ASSERT_NE(loadedEdge, nullptr);
+            EXPECT_EQ(loaded.length_of(*loadedEdge), graph.length_of(edge));
+            EXPECT_EQ(loaded.travel_time_of(*loadedEdge), graph.travel_time_of(edge));
+            EXPECT_EQ(loadedEdge->has_metadata(), edge.has_metadata());
+        }
+    }
+
+    const std::vector<gpp::osm::way_metadata>& table = loaded.get_metadata_table();
+    ASSERT_EQ(table.size(), 2);
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        EXPECT_TRUE(table[i] == graph.get_metadata_table()[i]);
+    }
+    // Names are interned again on load, so equal names still share their storage.
+    EXPECT_EQ(table[0].get_name().data(), table[1].get_name().data());
+}
+
+TEST(grapphs_osm, snapshot_stale_source) {
+    snapshot_source source;
+    gpp::osm::osm_graph graph;
+    build_snapshot_graph(graph);
+    ASSERT_TRUE(gpp::osm::save_snapshot(graph, source.path));
+    auto modificationTime = std::filesystem::last_write_time(source.path);
+
+    // Same modification time, different size.
+    std::ofstream(source.path, std::ios::app) << " ";
+    std::filesystem::last_write_time(source.path, modificationTime);
+    gpp::osm::osm_graph loaded;
+    EXPECT_FALSE(gpp::osm::load_snapshot(source.path, loaded));
+    EXPECT_TRUE(loaded.empty());
+
+    ASSERT_TRUE(gpp::osm::save_snapshot(graph, source.path));
+    ASSERT_TRUE(gpp::osm::load_snapshot(source.path, loaded));
+    loaded.clear();
+
+    // Same size, different modification time.
+    std::filesystem::last_write_time(source.path, modificationTime + std::chrono::hours(1));
+    EXPECT_FALSE(gpp::osm::load_snapshot(source.path, loaded));
+    EXPECT_TRUE(loaded.empty());
+}
+
+TEST(grapphs_osm, snapshot_mismatched_stamp) {
+    snapshot_source source;
+    gpp::osm::osm_graph graph;
+    build_snapshot_graph(graph);
+    ASSERT_TRUE(gpp::osm::save_snapshot(graph, source.path, 1));
+    gpp::osm::osm_graph loaded;
+    EXPECT_FALSE(gpp::osm::load_snapshot(source.path, loaded, 0));
+    EXPECT_TRUE(loaded.empty());
+
+    patch_snapshot(source.path, k_stamp_section, k_stamp_version_offset, std::uint32_t(1));
+    EXPECT_FALSE(gpp::osm::load_snapshot(source.path, loaded, 1));
+    EXPECT_TRUE(loaded.empty());
+}
+
+TEST(grapphs_osm, snapshot_truncated) {
+    snapshot_source source;
+    gpp::osm::osm_graph graph;
+    build_snapshot_graph(graph);
+    ASSERT_TRUE(gpp::osm::save_snapshot(graph, source.path));
+    std::filesystem::path path = gpp::osm::snapshot_path(source.path);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    gpp::osm::osm_graph loaded;
+    EXPECT_FALSE(gpp::osm::load_snapshot(source.path, loaded));
+    EXPECT_TRUE(loaded.empty());
+}
+
+TEST(grapphs_osm, snapshot_edge_out_of_range) {
+    snapshot_source source;
+    gpp::osm::osm_graph graph;
+    build_snapshot_graph(graph);
+    ASSERT_TRUE(gpp::osm::save_snapshot(graph, source.path));
+    auto target = static_cast<gpp::default_graph_index>(graph.size());
+    patch_snapshot(source.path, static_cast<std::uint32_t>(gpp::binary_section_id::TARGETS), 0, target);
+    gpp::osm::osm_graph loaded;
+    EXPECT_FALSE(gpp::osm::load_snapshot(source.path, loaded));
+    EXPECT_TRUE(loaded.empty());
+    EXPECT_TRUE(loaded.get_metadata_table().empty());
+}
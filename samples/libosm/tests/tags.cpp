@@ -0,0 +1,132 @@
+#include <grapphs/osm/tags.h>
+
+#include <gtest/gtest.h>
+
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    using gpp::osm::tag_key;
+    using gpp::osm::tag_view;
+
+    bool classify(bool routing, const std::vector<tag_view>& tags, gpp::osm::way_metadata& metadata) {
+        auto tagAt = [&tags](std::size_t i) {
+            return tags[i];
+        };
+        if (routing) {
+            return gpp::osm::classify_way<gpp::osm::routing_tag_profile>(tags.size(), tagAt, metadata);
+        }
+        return gpp::osm::classify_way<gpp::osm::default_tag_profile>(tags.size(), tagAt, metadata);
+    }
+
+    float max_speed_of(std::string_view value) {
+        gpp::osm::tag_values values{};
+        values[static_cast<std::size_t>(tag_key::MAX_SPEED)] = value;
+        return gpp::osm::make_way_metadata(values).get_max_speed();
+    }
+}
+
+TEST(grapphs_osm, intern_tag_key) {
+    struct case_t {
+        std::string_view key;
+        tag_key expected;
+    };
+    std::vector<case_t> cases = {
+        {"name", tag_key::NAME},
+        {"surface", tag_key::SURFACE},
+        {"lit", tag_key::LIT},
+        {"building", tag_key::BUILDING},
+        {"highway", tag_key::HIGHWAY},
+        {"lanes", tag_key::LANES},
+        {"maxspeed", tag_key::MAX_SPEED},
+        {"max_speed", tag_key::MAX_SPEED},
+        {"", tag_key::UNKNOWN},
+        {"nam", tag_key::UNKNOWN},
+        {"Name", tag_key::UNKNOWN},
+        {"highways", tag_key::UNKNOWN},
+        {"name:en", tag_key::UNKNOWN},
+        {"maxspeed:forward", tag_key::UNKNOWN},
+        {"railway", tag_key::UNKNOWN}
+    };
+    for (const case_t& test : cases) {
+        EXPECT_EQ(gpp::osm::intern_tag_key(test.key), test.expected) << test.key;
+    }
+    static_assert(gpp::osm::intern_tag_key("highway") == tag_key::HIGHWAY);
+}
+
+TEST(grapphs_osm, classify_way) {
+    using kind = gpp::osm::way_metadata::kind;
+    struct case_t {
+        std::vector<tag_view> tags;
+        bool keptByDefault;
+        bool keptForRouting;
+        kind expectedKind;
+    };
+    std::vector<case_t> cases = {
+        {{{"highway", "residential"}, {"name", "Main"}}, true, true, kind::HIGHWAY},
+        {{{"lanes", "1"}}, true, true, kind::WAY},
+        {{{"lanes", "2"}}, true, true, kind::ROAD},
+        {{{"lanes", "3"}}, true, true, kind::AVENUE},
+        {{{"lanes", "6"}}, true, true, kind::HIGHWAY},
+        {{{"lanes", "many"}}, true, true, kind::UNKNOWN},
+        {{{"building", "yes"}, {"name", "House"}}, true, false, kind::UNKNOWN},
+        {{{"name", "Trail"}, {"surface", "dirt"}}, true, false, kind::UNKNOWN},
+        {{{"railway", "rail"}, {"highways", "yes"}}, true, false, kind::UNKNOWN},
+        {{}, true, false, kind::UNKNOWN}
+    };
+    for (std::size_t i = 0; i < cases.size(); ++i) {
+        const case_t& test = cases[i];
+        for (bool routing : {false, true}) {
+            gpp::osm::way_metadata metadata("untouched", 0, {}, kind::UNKNOWN, {});
+            bool kept = classify(routing, test.tags, metadata);
+            EXPECT_EQ(kept, routing ? test.keptForRouting : test.keptByDefault) << i << ", " << routing;
+            if (kept) {
+                EXPECT_EQ(metadata.get_kind(), test.expectedKind) << i << ", " << routing;
+            }
+            else {
+                EXPECT_EQ(metadata.get_name(), "untouched") << i << ", " << routing;
+            }
+        }
+    }
+}
+
+TEST(grapphs_osm, classify_way_flags) {
+    using flags = gpp::osm::way_metadata::flags;
+    std::vector<tag_view> tags = {
+        {"highway", "residential"},
+        {"name", "Main"},
+        {"lit", "yes"},
+        {"building", "yes"},
+        {"surface", "asphalt"}
+    };
+    gpp::osm::way_metadata metadata;
+    ASSERT_TRUE(classify(false, tags, metadata));
+    EXPECT_EQ(metadata.get_name(), "Main");
+    EXPECT_EQ(metadata.get_flags(), flags::LIT | flags::BUILDING);
+    EXPECT_EQ(metadata.get_surface(), gpp::osm::way_metadata::surface::ASPHALT);
+
+    // The routing profile does not read building tags.
+    ASSERT_TRUE(classify(true, tags, metadata));
+    EXPECT_EQ(metadata.get_flags(), flags::LIT);
+}
+
+TEST(grapphs_osm, parse_max_speed) {
+    struct case_t {
+        std::string_view value;
+        float expected;
+    };
+    std::vector<case_t> cases = {
+        {"50", 50},
+        {"30 mph", 30 * 1.609344F},
+        {"30mph", 30 * 1.609344F},
+        {"12.5", 12.5F},
+        {"none", -1},
+        {"signals", -1},
+        {"", -1},
+        {"mph 30", -1}
+    };
+    for (const case_t& test : cases) {
+        EXPECT_FLOAT_EQ(max_speed_of(test.value), test.expected) << test.value;
+    }
+}
@@ -0,0 +1,201 @@
+#include <grapphs/osm/spatial_index.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+    /**
+     * Distances found by the index and by brute force may differ this much, in meters, as the
+     * index projects locations into floats.
+     */
+    constexpr float k_tolerance = 0.01F;
+
+    /**
+     * Half of the vertices are spread over a city sized box, the other half packed into a
+     * corner of it, so that most cells are empty and searches have to go through many rings.
+     */
+    void push_random_vertices(gpp::osm::osm_graph& graph, std::size_t numVertices, unsigned seed) {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<double> longitude(-49.35, -49.25);
+        std::uniform_real_distribution<double> latitude(-25.50, -25.40);
+        std::uniform_real_distribution<double> cluster(0, 0.002);
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            if (i % 2 == 0) {
+                graph.push(gpp::osm::osm_node(gpp::osm::coordinate(longitude(random), latitude(random))));
+            }
+            else {
+                graph.push(gpp::osm::osm_node(gpp::osm::coordinate(-49.35 + cluster(random), -25.50 + cluster(random))));
+            }
+        }
+    }
+
+    /**
+     * Queries inside the bounds of push_random_vertices, and up to twice as far outside.
+     */
+    std::vector<gpp::osm::coordinate> random_queries(std::size_t count, unsigned seed) {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<double> longitude(-49.45, -49.15);
+        std::uniform_real_distribution<double> latitude(-25.60, -25.30);
+        std::vector<gpp::osm::coordinate> queries;
+        for (std::size_t i = 0; i < count; ++i) {
+            queries.emplace_back(longitude(random), latitude(random));
+        }
+        return queries;
+    }
+
+    /**
+     * @returns The distance from \p location to every vertex, using the same projection as
+     * \p index.
+     */
+    std::vector<float> brute_force_distances(
+        const gpp::osm::osm_graph& graph,
+        const gpp::osm::spatial_index& index,
+        const gpp::osm::coordinate& location
+    ) {
+        const gpp::osm::geo_bounds& bounds = index.get_bounds();
+        double metersPerLatitude = 6371008.8 * 3.14159265358979323846 / 180.0;
+        double centerLatitude = (bounds.minLatitude + bounds.maxLatitude) / 2;
+        double metersPerLongitude = metersPerLatitude * std::cos(centerLatitude * 3.14159265358979323846 / 180.0);
+        std::vector<float> distances(graph.size());
+        for (std::size_t i = 0; i < graph.size(); ++i) {
+            const gpp::osm::coordinate& vertex = graph.vertex(i)->get_location();
+            double dx = (vertex.get_longitude() - location.get_longitude()) * metersPerLongitude;
+            double dy = (vertex.get_latitude() - location.get_latitude()) * metersPerLatitude;
+            distances[i] = static_cast<float>(std::sqrt(dx * dx + dy * dy));
+        }
+        return distances;
+    }
+
+    /**
+     * Expects \p found to be sorted and the first \p expected.size() distances of \p distances,
+     * each vertex being at the distance reported.
+     */
+    void expect_closest(
+        const std::vector<gpp::osm::nearest_vertex>& found,
+        const std::vector<float>& distances,
+        std::size_t k
+    ) {
+        std::vector<float> sorted = distances;
+        std::sort(sorted.begin(), sorted.end());
+        sorted.resize(std::min(k, sorted.size()));
+        ASSERT_EQ(found.size(), sorted.size());
+        for (std::size_t i = 0; i < found.size(); ++i) {
+            ASSERT_LT(found[i].vertex, distances.size());
+            EXPECT_NEAR(found[i].distance, distances[found[i].vertex], k_tolerance);
+            EXPECT_NEAR(found[i].distance, sorted[i], k_tolerance) << i;
+            if (i > 0) {
+                EXPECT_LE(found[i - 1].distance, found[i].distance);
+            }
+        }
+    }
+}
+
+TEST(grapphs_osm, spatial_index_nearest) {
+    gpp::osm::osm_graph graph;
+    push_random_vertices(graph, 2000, 1);
+    gpp::osm::spatial_index index(graph);
+    ASSERT_EQ(index.size(), graph.size());
+    for (const gpp::osm::coordinate& query : random_queries(500, 2)) {
+        std::vector<float> distances = brute_force_distances(graph, index, query);
+        gpp::osm::nearest_vertex nearest = index.nearest(query);
+        ASSERT_LT(nearest.vertex, graph.size());
+        EXPECT_NEAR(nearest.distance, *std::min_element(distances.begin(), distances.end()), k_tolerance);
+        EXPECT_NEAR(nearest.distance, distances[nearest.vertex], k_tolerance);
+    }
+}
+
+TEST(grapphs_osm, spatial_index_k_nearest) {
+    gpp::osm::osm_graph graph;
+    push_random_vertices(graph, 2000, 3);
+    gpp::osm::spatial_index index(graph);
+    for (const gpp::osm::coordinate& query : random_queries(200, 4)) {
+        std::vector<float> distances = brute_force_distances(graph, index, query);
+        for (std::size_t k : {1, 7, 64}) {
+            expect_closest(index.k_nearest(query, k), distances, k);
+        }
+    }
+    EXPECT_TRUE(index.k_nearest(random_queries(1, 5).front(), 0).empty());
+}
+
+TEST(grapphs_osm, spatial_index_k_nearest_more_than_size) {
+    gpp::osm::osm_graph graph;
+    push_random_vertices(graph, 20, 6);
+    gpp::osm::spatial_index index(graph, 2);
+    for (const gpp::osm::coordinate& query : random_queries(20, 7)) {
+        // Every vertex is returned, however far
+        expect_closest(index.k_nearest(query, 50), brute_force_distances(graph, index, query), 50);
+    }
+}
+
+TEST(grapphs_osm, spatial_index_within_radius) {
+    gpp::osm::osm_graph graph;
+    push_random_vertices(graph, 2000, 8);
+    gpp::osm::spatial_index index(graph);
+    std::mt19937 random(9);
+    std::uniform_real_distribution<float> radii(0, 3000);
+    for (const gpp::osm::coordinate& query : random_queries(200, 10)) {
+        float radius = radii(random);
+        std::vector<float> distances = brute_force_distances(graph, index, query);
+        std::vector<gpp::osm::nearest_vertex> found = index.within_radius(query, radius);
+        std::vector<bool> isFound(graph.size(), false);
+        for (std::size_t i = 0; i < found.size(); ++i) {
+            ASSERT_LT(found[i].vertex, graph.size());
+            EXPECT_FALSE(isFound[found[i].vertex]);
+            isFound[found[i].vertex] = true;
+            EXPECT_NEAR(found[i].distance, distances[found[i].vertex], k_tolerance);
+            EXPECT_LE(found[i].distance, radius);
+            if (i > 0) {
+                EXPECT_LE(found[i - 1].distance, found[i].distance);
+            }
+        }
+        for (std::size_t i = 0; i < graph.size(); ++i) {
+            // Vertices on the boundary may go either way
+            if (distances[i] < radius - k_tolerance) {
+                EXPECT_TRUE(isFound[i]) << i << " at " << distances[i] << " of " << radius;
+            }
+        }
+    }
+    EXPECT_TRUE(index.within_radius(random_queries(1, 11).front(), -1).empty());
+}
+
+TEST(grapphs_osm, spatial_index_snap) {
+    gpp::osm::osm_graph graph;
+    push_random_vertices(graph, 2000, 12);
+    gpp::osm::spatial_index index(graph);
+    // Several chunks of the snapping grain
+    std::vector<gpp::osm::coordinate> queries = random_queries(1500, 13);
+    for (std::size_t numThreads : {1, 4}) {
+        std::vector<gpp::osm::nearest_vertex> snapped(queries.size());
+        index.snap(queries.data(), queries.size(), snapped.data(), numThreads);
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            gpp::osm::nearest_vertex nearest = index.nearest(queries[i]);
+            EXPECT_EQ(snapped[i].vertex, nearest.vertex) << i;
+            EXPECT_EQ(snapped[i].distance, nearest.distance) << i;
+        }
+    }
+}
+
+TEST(grapphs_osm, spatial_index_empty) {
+    gpp::osm::osm_graph graph;
+    gpp::osm::spatial_index built(graph);
+    gpp::osm::spatial_index defaulted;
+    gpp::osm::coordinate query(-49.3, -25.4);
+    for (const gpp::osm::spatial_index* index : {&built, &defaulted}) {
+        EXPECT_TRUE(index->empty());
+        EXPECT_EQ(index->size(), 0);
+        gpp::osm::nearest_vertex nearest = index->nearest(query);
+        EXPECT_EQ(nearest.vertex, gpp::osm::nearest_vertex::invalid_vertex());
+        EXPECT_TRUE(std::isinf(nearest.distance));
+        EXPECT_TRUE(index->k_nearest(query, 3).empty());
+        EXPECT_TRUE(index->within_radius(query, 1000).empty());
+        gpp::osm::nearest_vertex snapped[2];
+        gpp::osm::coordinate queries[2] = {query, query};
+        index->snap(queries, 2, snapped, 1);
+        EXPECT_EQ(snapped[0].vertex, gpp::osm::nearest_vertex::invalid_vertex());
+        EXPECT_EQ(snapped[1].vertex, gpp::osm::nearest_vertex::invalid_vertex());
+    }
+}
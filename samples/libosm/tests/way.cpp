@@ -0,0 +1,110 @@
+#include <grapphs/osm/way.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+    gpp::osm::way_metadata road(float maxSpeed, gpp::osm::way_metadata::kind kind, std::string_view name = "road") {
+        return gpp::osm::way_metadata(
+            name,
+            maxSpeed,
+            gpp::osm::way_metadata::flags(),
+            kind,
+            gpp::osm::way_metadata::surface::ASPHALT
+        );
+    }
+}
+
+TEST(grapphs_osm, compute_weights) {
+    gpp::osm::osm_graph graph;
+    gpp::osm::coordinate a(-49.27, -25.43), b(-49.27, -25.431), c(-49.269, -25.431);
+    gpp::osm::coordinate d(-49.27, -25.4310001);
+    graph.push(gpp::osm::osm_node(a));
+    graph.push(gpp::osm::osm_node(b));
+    graph.push(gpp::osm::osm_node(c));
+    graph.push(gpp::osm::osm_node(d));
+    std::size_t fast = graph.push_meta(road(50, gpp::osm::way_metadata::kind::AVENUE));
+    std::size_t unlimited = graph.push_meta(road(-1, gpp::osm::way_metadata::kind::ROAD));
+    graph.connect(0, 1, gpp::osm::way(fast));
+    graph.connect(1, 2, gpp::osm::way(unlimited));
+    graph.connect(2, 0, gpp::osm::way());
+    graph.connect(1, 3, gpp::osm::way(fast));
+    graph.compute_weights();
+
+    double ab = gpp::osm::haversine_distance(a, b);
+    double bc = gpp::osm::haversine_distance(b, c);
+    double ca = gpp::osm::haversine_distance(c, a);
+    EXPECT_NEAR(ab, 111.2, 0.1);
+
+    const gpp::osm::way& toB = *graph.edge(0, 1);
+    EXPECT_FLOAT_EQ(graph.length_of(toB), ab);
+    EXPECT_FLOAT_EQ(graph.travel_time_of(toB), ab * 3.6 / 50);
+
+    // Without a max speed, ways travel at the default speed of their kind.
+    const gpp::osm::way& toC = *graph.edge(1, 2);
+    EXPECT_FLOAT_EQ(graph.length_of(toC), bc);
+    EXPECT_FLOAT_EQ(graph.travel_time_of(toC), bc * 3.6 / 40);
+
+    const gpp::osm::way& toA = *graph.edge(2, 0);
+    EXPECT_FLOAT_EQ(graph.length_of(toA), ca);
+    EXPECT_FLOAT_EQ(graph.travel_time_of(toA), ca * 3.6 / 30);
+
+    // Short edges keep their exact weight instead of being rounded to a step.
+    double bd = gpp::osm::haversine_distance(b, d);
+    const gpp::osm::way& toD = *graph.edge(1, 3);
+    EXPECT_LT(bd, 0.02);
+    EXPECT_FLOAT_EQ(graph.length_of(toD), bd);
+    EXPECT_FLOAT_EQ(graph.travel_time_of(toD), bd * 3.6 / 50);
+}
+
+TEST(grapphs_osm, push_meta_interning) {
+    gpp::osm::osm_graph graph;
+    std::string first = "Rua XV", second = "Rua XV";
+    std::size_t fastIndex = graph.push_meta(road(60, gpp::osm::way_metadata::kind::AVENUE, first));
+    std::size_t slowIndex = graph.push_meta(road(30, gpp::osm::way_metadata::kind::ROAD, second));
+    EXPECT_NE(fastIndex, slowIndex);
+    EXPECT_EQ(graph.push_meta(road(60, gpp::osm::way_metadata::kind::AVENUE, second)), fastIndex);
+    ASSERT_EQ(graph.get_metadata_table().size(), 2);
+
+    // Both metadata reference a single copy of the name owned by the graph.
+    std::string_view fastName = graph.get_metadata(gpp::osm::way(fastIndex))->get_name();
+    std::string_view slowName = graph.get_metadata(gpp::osm::way(slowIndex))->get_name();
+    EXPECT_EQ(fastName, "Rua XV");
+    EXPECT_EQ(fastName.data(), slowName.data());
+    EXPECT_NE(fastName.data(), first.data());
+    EXPECT_NE(fastName.data(), second.data());
+
+    // Names outlive the buffers they were pushed from, and moves of the graph.
+    first.assign("overwritten");
+    second.clear();
+    gpp::osm::osm_graph moved(std::move(graph));
+    const gpp::osm::way_metadata* metadata = moved.get_metadata(gpp::osm::way(slowIndex));
+    ASSERT_NE(metadata, nullptr);
+    EXPECT_EQ(metadata->get_name(), "Rua XV");
+    EXPECT_EQ(metadata->get_name().data(), fastName.data());
+
+    gpp::osm::osm_graph assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.get_metadata(gpp::osm::way(fastIndex))->get_name().data(), fastName.data());
+    std::string third = "Rua XV";
+    EXPECT_EQ(assigned.push_meta(road(30, gpp::osm::way_metadata::kind::ROAD, third)), slowIndex);
+}
+
+TEST(grapphs_osm, get_metadata_missing) {
+    gpp::osm::osm_graph graph;
+    EXPECT_EQ(graph.get_metadata(gpp::osm::way()), nullptr);
+    EXPECT_EQ(graph.get_metadata(gpp::osm::way(0)), nullptr);
+
+    std::size_t index = graph.push_meta(road(50, gpp::osm::way_metadata::kind::ROAD));
+    EXPECT_NE(graph.get_metadata(gpp::osm::way(index)), nullptr);
+    EXPECT_EQ(graph.get_metadata(gpp::osm::way(index + 1)), nullptr);
+    EXPECT_EQ(graph.get_metadata(gpp::osm::way()), nullptr);
+    EXPECT_FALSE(gpp::osm::way().has_metadata());
+
+    graph.clear();
+    EXPECT_EQ(graph.get_metadata(gpp::osm::way(index)), nullptr);
+}
@@ -1,6 +1,7 @@
 #include <iostream>
-#include <fstream>
 #include <grapphs/osm/parse.h>
+#include <grapphs/osm/spatial_index.h>
+#include <grapphs/raster.h>
 #include <grapphs/svg.h>
 
 class aabb {
@@ -77,25 +78,9 @@ int main(int argc, char** argv) {
 
     std::cout << "Graph size: " << graph.size() << std::endl;
 
-    aabb cityAabb;
-    for (std::size_t i = 0; i < graph.size(); ++i) {
-        gpp::osm::osm_node* pNode = graph.vertex(i);
-        const gpp::osm::coordinate& coordinate = pNode->get_location();
-        double x = coordinate.get_longitude();
-        double y = coordinate.get_latitude();
-        if (x > cityAabb.get_max_x()) {
-            cityAabb.set_max_x(x);
-        }
-        if (y > cityAabb.get_max_y()) {
-            cityAabb.set_max_y(y);
-        }
-        if (x < cityAabb.get_min_x()) {
-            cityAabb.set_min_x(x);
-        }
-        if (y < cityAabb.get_min_y()) {
-            cityAabb.set_min_y(y);
-        }
-    }
+    gpp::osm::spatial_index index(graph);
+    const gpp::osm::geo_bounds& bounds = index.get_bounds();
+    aabb cityAabb(bounds.minLongitude, bounds.minLatitude, bounds.maxLongitude, bounds.maxLatitude);
     std::cout << "AABB min X: " << cityAabb.get_min_x() << std::endl;
     std::cout << "AABB max X: " << cityAabb.get_max_x() << std::endl;
     std::cout << "AABB min Y: " << cityAabb.get_min_y() << std::endl;
@@ -106,66 +91,75 @@ int main(int argc, char** argv) {
         viewBox.minX, viewBox.minY, viewBox.minX + viewBox.width, viewBox.minY + viewBox.height
     );
 
-    gpp::svg_writer<gpp::osm::osm_graph> writer(
-        viewBox, [&](
-            std::size_t index, const gpp::osm::osm_node& node, float& x, float& y
-        ) {
-            const gpp::osm::coordinate& location = node.get_location();
-
-            double relX = inv_lerp(cityAabb.get_min_x(), cityAabb.get_max_x(), location.get_longitude());
-            double relY = inv_lerp(cityAabb.get_min_y(), cityAabb.get_max_y(), location.get_latitude());
-
-            x = static_cast<float>(lerp(viewportAabb.get_min_x(), viewportAabb.get_max_x(), relX));
-            y = static_cast<float>(lerp(viewportAabb.get_min_y(), viewportAabb.get_max_x(), relY));
+    // Shared by the SVG and raster writers. They only read the graph, so they are safe to run on
+    // every core.
+    auto position = [&](std::size_t index, const gpp::osm::osm_node& node, float& x, float& y) {
+        const gpp::osm::coordinate& location = node.get_location();
+
+        double relX = inv_lerp(cityAabb.get_min_x(), cityAabb.get_max_x(), location.get_longitude());
+        double relY = inv_lerp(cityAabb.get_min_y(), cityAabb.get_max_y(), location.get_latitude());
+
+        x = static_cast<float>(lerp(viewportAabb.get_min_x(), viewportAabb.get_max_x(), relX));
+        y = static_cast<float>(lerp(viewportAabb.get_min_y(), viewportAabb.get_max_y(), relY));
+    };
+    auto edgeFilter = [&](std::size_t from, std::size_t to, const gpp::osm::way& way) {
+        const gpp::osm::way_metadata* meta = graph.get_metadata(way);
+        if (meta == nullptr) {
+            return true;
         }
-    );
-
-    writer.set_flags(gpp::svg_writer_flags::DRAW_EDGES);
-
-    writer.set_edge_filter(
-        [&](std::size_t from, std::size_t to, const gpp::osm::way& way) {
-            gpp::osm::way_metadata meta;
-            if (!graph.get_metadata(way, meta)) {
-                return true;
-            }
-            return (meta.get_flags() & gpp::osm::way_metadata::flags::BUILDING)
-                   != gpp::osm::way_metadata::flags::BUILDING;
+        return (meta->get_flags() & gpp::osm::way_metadata::flags::BUILDING)
+               != gpp::osm::way_metadata::flags::BUILDING;
+    };
+    // Takes either svg_attributes or raster_attributes
+    auto edgeCustomizer = [&](const gpp::osm::way& way, auto& attributes) {
+        const gpp::osm::way_metadata* meta = graph.get_metadata(way);
+        if (meta == nullptr) {
+            return;
         }
-    );
-
-    writer.set_edge_customizer(
-        [&](const gpp::osm::way& way, gpp::svg_attributes& attributes) {
-
-            gpp::osm::way_metadata meta;
-            if (!graph.get_metadata(way, meta)) {
-                return;
-            }
-            attributes.color.r = static_cast<uint8_t>(lerp<float>(
-                0, 255, inv_lerp<float>(
-                    0, 80, meta.get_max_speed())));
-
-            switch (meta.get_kind()) {
-                case gpp::osm::way_metadata::kind::WAY:
-                    attributes.size = 0.5F;
-                    break;
-                case gpp::osm::way_metadata::kind::ROAD:
-                    attributes.size = 1.0F;
-                    break;
-                case gpp::osm::way_metadata::kind::AVENUE:
-                    attributes.size = 1.5F;
-                    break;
-                case gpp::osm::way_metadata::kind::HIGHWAY:
-                    attributes.size = 2.0F;
-                    break;
-                default:
-                    break;
-            }
+        attributes.color.r = static_cast<uint8_t>(lerp<float>(
+            0, 255, inv_lerp<float>(
+                0, 80, meta->get_max_speed())));
+
+        switch (meta->get_kind()) {
+            case gpp::osm::way_metadata::kind::WAY:
+                attributes.size = 0.5F;
+                break;
+            case gpp::osm::way_metadata::kind::ROAD:
+                attributes.size = 1.0F;
+                break;
+            case gpp::osm::way_metadata::kind::AVENUE:
+                attributes.size = 1.5F;
+                break;
+            case gpp::osm::way_metadata::kind::HIGHWAY:
+                attributes.size = 2.0F;
+                break;
+            default:
+                break;
         }
+    };
+
+    gpp::svg_writer<gpp::osm::osm_graph> writer(viewBox, position);
+    writer.set_flags(
+        gpp::svg_writer_flags::DRAW_EDGES
+        | gpp::svg_writer_flags::CULL_TO_VIEWBOX
+        | gpp::svg_writer_flags::MERGE_EDGES
     );
+    writer.set_min_edge_length(0.5F);
+    writer.set_num_threads(0);
+    writer.set_edge_filter(edgeFilter);
+    writer.set_edge_customizer(edgeCustomizer);
     auto svgFile = src / "curitiba.svg";
-    {
-        std::ofstream stream(svgFile);
-        writer.write(stream, graph);
-        std::cout << "SVG File: " << std::filesystem::absolute(svgFile) << std::endl;
-    }
+    writer.write(svgFile, graph);
+    std::cout << "SVG File: " << std::filesystem::absolute(svgFile) << std::endl;
+
+    gpp::raster_writer<gpp::osm::osm_graph> rasterWriter(
+        gpp::raster_viewbox{viewBox.minX, viewBox.minY, viewBox.width, viewBox.height}, 4000, 4000, position
+    );
+    rasterWriter.set_flags(gpp::raster_writer_flags::DRAW_EDGES);
+    rasterWriter.set_num_threads(0);
+    rasterWriter.set_edge_filter(edgeFilter);
+    rasterWriter.set_edge_customizer(edgeCustomizer);
+    auto pngFile = src / "curitiba.png";
+    rasterWriter.render(graph).save_png(pngFile);
+    std::cout << "PNG File: " << std::filesystem::absolute(pngFile) << std::endl;
 }
\ No newline at end of file
@@ -9,6 +9,7 @@ from mazelib.solve.ShortestPath import ShortestPath
 from numpy import ndarray
 import json
 import argparse
+import struct
 
 parser = argparse.ArgumentParser(description='Process some integers.')
 parser.add_argument('--size', metavar='N', type=int, help='an integer for the accumulator')
@@ -16,9 +17,11 @@ parser.add_argument('--monteMazes', nargs='?', type=int, default=10)
 parser.add_argument('--monteAttempts', nargs='?', type=int, default=10)
 parser.add_argument('--output', nargs='?', type=str, default=None)
 parser.add_argument('--reuse', nargs='?', type=bool, default=False)
+parser.add_argument('--binaryOutput', nargs='?', type=str, default=None)
 args = parser.parse_args()
 if args.output is not None and args.reuse is not None and args.reuse:
-    if os.path.exists(args.output):
+    outputs = [path for path in (args.output, args.binaryOutput) if path is not None]
+    if all(os.path.exists(path) for path in outputs):
         print(f"Maze {args.output} already exists and reuse is specified.", file=sys.stderr)
         exit(0)
 halfSize = args.size
@@ -114,6 +117,56 @@ shortest_path.append(start)
 for (x, y) in m.solutions[0]:
     shortest_path.append(int(globalToLocal[index_of(x, y)]))
 shortest_path.append(end)
+
+
+# Layout of grapphs binary files, see include/grapphs/binary.h and maze_section_id in
+# tests/shared/grapphs/tests/mazes.h.
+BINARY_ALIGNMENT = 64
+SECTION_OFFSETS = 1
+SECTION_TARGETS = 2
+SECTION_VERTICES = 3
+SECTION_EDGES = 4
+SECTION_MAZE_INFO = 1 << 16
+SECTION_MAZE_SHORTEST_PATH = SECTION_MAZE_INFO + 1
+
+
+def align(offset: int):
+    return (offset + BINARY_ALIGNMENT - 1) // BINARY_ALIGNMENT * BINARY_ALIGNMENT
+
+
+def write_binary(path: str):
+    offsets = [0]
+    targets = list()
+    for i in range(len(vertices)):
+        targets.extend(edges.get(i, []))
+        offsets.append(len(targets))
+    # (id, element size, payload), all in native byte order like the C++ writer.
+    sections = [
+        (SECTION_VERTICES, 8, b"".join(struct.pack("=ii", v["x"], v["y"]) for v in vertices)),
+        (SECTION_OFFSETS, 4, struct.pack(f"={len(offsets)}I", *offsets)),
+        (SECTION_TARGETS, 4, struct.pack(f"={len(targets)}I", *targets)),
+        (SECTION_EDGES, 4, struct.pack(f"={len(targets)}i", *([1] * len(targets)))),
+        (SECTION_MAZE_INFO, 8, struct.pack("=3Q", size, start, end)),
+        (SECTION_MAZE_SHORTEST_PATH, 4, struct.pack(f"={len(shortest_path)}I", *shortest_path)),
+    ]
+    table = b""
+    offset = align(32 + 24 * len(sections))
+    for (section_id, element_size, payload) in sections:
+        table += struct.pack("=IIQQ", section_id, element_size, offset, len(payload) // element_size)
+        offset = align(offset + len(payload))
+    header = struct.pack("=8sIIIIQ", b"GRAPPHS\0", 1, 0x01020304, len(sections), 0, offset)
+    contents = bytearray(header + table)
+    for (_, _, payload) in sections:
+        contents += bytes(align(len(contents)) - len(contents))
+        contents += payload
+    contents += bytes(offset - len(contents))
+    with open(path, "wb") as output:
+        output.write(contents)
+
+
+if args.binaryOutput is not None:
+    write_binary(args.binaryOutput)
+
 graph = json.dumps({
     "size": size,
     "start": start,
@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
 #include <grapphs/adjacency_list.h>
+#include <grapphs/graph_builder.h>
+#include <grapphs/algorithms/reorder.h>
+
+#include <atomic>
+#include <memory_resource>
+#include <numeric>
+#include <thread>
 
 TEST(grapphs, adjacency_list_removal) {
     gpp::adjacency_list<int, float> graph;
@@ -11,6 +18,9 @@ TEST(grapphs, adjacency_list_removal) {
     EXPECT_EQ(graph.size(), 3);
     graph.remove(toBeRemoved);
     EXPECT_EQ(graph.size(), 2);
+    EXPECT_EQ(graph.index_bound(), 3);
+    EXPECT_TRUE(graph.is_removed(toBeRemoved));
+    EXPECT_FALSE(graph.is_removed(2));
 
     int numIterations = 0;
     std::set<int> expected = { 0, 2 };
@@ -54,4 +64,225 @@ TEST(grapphs, adjacency_list_disconnecting) {
         EXPECT_EQ(numIterations, 1);
         EXPECT_TRUE(expected.empty());
     }
-}
\ No newline at end of file
+}
+
+TEST(grapphs, adjacency_list_incoming_index) {
+    gpp::adjacency_list<int, int> graph;
+    for (int i = 0; i < 4; ++i) {
+        graph.push(i);
+    }
+    graph.connect(0, 2, 20);
+    graph.connect(1, 2, 21);
+    graph.set_incoming_index(true);
+    graph.connect(3, 2, 23);
+    graph.connect(2, 3, 32);
+
+    std::set<std::pair<std::size_t, int>> expected = {{0, 20}, {1, 21}, {3, 23}};
+    for (const auto& [from, edge] : graph.edges_to(2)) {
+        EXPECT_GT(expected.erase({from, edge}), 0) << "Unexpected edge from " << from;
+    }
+    EXPECT_TRUE(expected.empty());
+
+    EXPECT_TRUE(graph.disconnect(1, 2));
+    graph.remove(2);
+    EXPECT_EQ(graph.edge(0, 2), nullptr);
+    EXPECT_EQ(graph.edge(3, 2), nullptr);
+    auto towardsThree = graph.edges_to(3);
+    EXPECT_EQ(towardsThree.begin(), towardsThree.end());
+
+    graph.set_incoming_index(false);
+    EXPECT_THROW(graph.edges_to(3), std::logic_error);
+}
+
+TEST(grapphs, adjacency_list_incoming_index_shrink) {
+    gpp::adjacency_list<int, int> graph;
+    for (int i = 0; i < 5; ++i) {
+        graph.push(i);
+    }
+    graph.set_incoming_index(true);
+    graph.connect(0, 1, 1);
+    graph.connect(3, 1, 31);
+    graph.connect(4, 0, 40);
+    EXPECT_THROW(graph.connect(0, 5, 5), std::out_of_range);
+    EXPECT_EQ(graph.edge(0, 5), nullptr);
+
+    graph.resize(3);
+    std::vector<std::pair<std::size_t, int>> incoming;
+    for (const auto& [from, edge] : graph.edges_to(1)) {
+        incoming.emplace_back(from, edge);
+    }
+    EXPECT_EQ(incoming, (std::vector<std::pair<std::size_t, int>>{{0, 1}}));
+    auto truncated = graph.edges_to(0);
+    EXPECT_EQ(truncated.begin(), truncated.end());
+    EXPECT_THROW(graph.connect(0, 3, 3), std::out_of_range);
+
+    // Grown back, the vertices are new and have no edges yet
+    graph.resize(5);
+    graph.connect(4, 1, 41);
+    auto grown = graph.edges_to(1);
+    EXPECT_EQ(std::distance(grown.begin(), grown.end()), 2);
+}
+
+TEST(grapphs, adjacency_list_compact) {
+    gpp::adjacency_list<int, int> graph;
+    for (int i = 0; i < 6; ++i) {
+        graph.push(i * 10);
+    }
+    graph.connect(0, 5, 5);
+    graph.connect(5, 3, 53);
+    graph.connect(3, 1, 31);
+    graph.remove(1);
+    graph.remove(4);
+
+    std::vector<std::size_t> oldToNew = graph.compact();
+    EXPECT_EQ(oldToNew, (std::vector<std::size_t>{0, graph.invalid_index(), 1, 2, graph.invalid_index(), 3}));
+    EXPECT_EQ(graph.size(), 4);
+    EXPECT_EQ(graph.index_bound(), 4);
+    EXPECT_EQ(*graph.vertex(3), 50);
+    ASSERT_NE(graph.edge(0, 3), nullptr);
+    EXPECT_EQ(*graph.edge(0, 3), 5);
+    ASSERT_NE(graph.edge(3, 2), nullptr);
+    EXPECT_EQ(*graph.edge(3, 2), 53);
+    EXPECT_EQ(std::distance(graph.edges_from(2).begin(), graph.edges_from(2).end()), 0);
+    EXPECT_EQ(graph.all_vertices_indices(), (std::vector<std::size_t>{0, 1, 2, 3}));
+
+    EXPECT_EQ(graph.push(60), 4);
+}
+
+TEST(grapphs, adjacency_list_pmr) {
+    std::pmr::monotonic_buffer_resource arena(std::pmr::new_delete_resource());
+    // Anything not allocated from the arena fails
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        gpp::pmr::adjacency_list<int, float> graph(&arena);
+        graph.set_incoming_index(true);
+        for (int i = 0; i < 100; ++i) {
+            graph.push(i);
+        }
+        gpp::graph_builder<float> builder;
+        for (std::size_t i = 0; i < 100; ++i) {
+            builder.add(i, (i + 1) % 100, static_cast<float>(i));
+        }
+        builder.build_into(graph);
+        graph.remove(50);
+        graph.resize(120);
+        graph.compact();
+
+        EXPECT_EQ(graph.size(), 119);
+        EXPECT_EQ(*graph.vertex(50), 51);
+        EXPECT_NE(graph.edge(50, 51), nullptr);
+        EXPECT_EQ(graph.edge(49, 50), nullptr);
+        auto incoming = graph.edges_to(51);
+        for (const auto& [from, edge] : incoming) {
+            EXPECT_EQ(from, 50);
+            EXPECT_EQ(edge, 51.0F);
+        }
+        EXPECT_EQ(graph.get_allocator().resource(), &arena);
+    }
+    std::pmr::set_default_resource(previous);
+}
+
+TEST(grapphs, adjacency_list_pmr_copy) {
+    std::pmr::monotonic_buffer_resource arena(std::pmr::new_delete_resource());
+    std::pmr::monotonic_buffer_resource copyArena(std::pmr::new_delete_resource());
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        gpp::pmr::adjacency_list<int, float> graph(&arena);
+        graph.set_incoming_index(true);
+        for (int i = 0; i < 10; ++i) {
+            graph.push(i);
+        }
+        for (std::size_t i = 0; i < 10; ++i) {
+            graph.connect(i, (i + 1) % 10, static_cast<float>(i));
+        }
+        graph.remove(5);
+
+        // Without an allocator, the copy goes to the default resource, all of it
+        EXPECT_THROW((gpp::pmr::adjacency_list<int, float>(graph)), std::bad_alloc);
+
+        gpp::pmr::adjacency_list<int, float> copy(graph, &copyArena);
+        EXPECT_EQ(copy.get_allocator().resource(), &copyArena);
+        EXPECT_EQ(copy.size(), 9);
+        EXPECT_TRUE(copy.is_removed(5));
+        ASSERT_NE(copy.edge(8, 9), nullptr);
+        EXPECT_EQ(*copy.edge(8, 9), 8.0F);
+        auto incoming = copy.edges_to(9);
+        ASSERT_EQ(std::distance(incoming.begin(), incoming.end()), 1);
+        EXPECT_EQ(incoming.begin()->first, 8);
+
+        gpp::pmr::adjacency_list<int, float> assigned(&copyArena);
+        assigned = graph;
+        EXPECT_EQ(assigned.get_allocator().resource(), &copyArena);
+        EXPECT_EQ(assigned.size(), 9);
+        assigned.connect(0, 2, 2.0F);
+        EXPECT_EQ(graph.edge(0, 2), nullptr);
+        // Reuses the removed vertex, from the copied free list
+        EXPECT_EQ(assigned.push(50), 5);
+    }
+    std::pmr::set_default_resource(previous);
+}
+
+/**
+ * Arena recording whether any thread other than the one which created it allocated from it,
+ * which monotonic_buffer_resource doesn't support.
+ */
+class owned_arena : public std::pmr::memory_resource {
+private:
+    std::pmr::monotonic_buffer_resource _arena{std::pmr::new_delete_resource()};
+    std::thread::id _owner = std::this_thread::get_id();
+    std::atomic<bool> _shared{false};
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (std::this_thread::get_id() != _owner) {
+            _shared = true;
+        }
+        return _arena.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        _arena.deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    bool shared() const {
+        return _shared;
+    }
+};
+
+TEST(grapphs, adjacency_list_pmr_threads) {
+    // Enough vertices for several chunks, and for the arena to grow many times
+    constexpr std::size_t numVertices = 1 << 16;
+    owned_arena arena;
+    gpp::pmr::adjacency_list<int, float> graph(&arena);
+    for (std::size_t i = 0; i < numVertices; ++i) {
+        graph.push(static_cast<int>(i));
+    }
+    gpp::graph_builder<float> builder;
+    builder.set_num_threads(8);
+    for (std::size_t i = 0; i < numVertices; ++i) {
+        builder.add(i, (i + 1) % numVertices, static_cast<float>(i));
+        builder.add(i, (i + 7) % numVertices, static_cast<float>(i));
+    }
+    builder.build_into(graph);
+    graph.remove(0);
+    graph.compact();
+
+    std::vector<std::size_t> order(graph.size());
+    std::iota(order.rbegin(), order.rend(), std::size_t(0));
+    auto reversed = gpp::reorder(graph, gpp::vertex_permutation<std::size_t>::from_order(std::move(order)));
+
+    EXPECT_FALSE(arena.shared());
+    ASSERT_EQ(reversed.size(), numVertices - 1);
+    std::size_t last = numVertices - 2;
+    // Old vertex 1 is now at index 0 after compaction, and last after reversal
+    EXPECT_EQ(*reversed.vertex(last), 1);
+    ASSERT_NE(reversed.edge(last, last - 1), nullptr);
+    EXPECT_EQ(*reversed.edge(last, last - 1), 1.0F);
+    ASSERT_NE(reversed.edge(last, last - 7), nullptr);
+    EXPECT_EQ(reversed.get_allocator().resource(), &arena);
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <grapphs/adjacency_matrix.h>
 
+#include <memory_resource>
+
 constexpr int k_graph_size = 64;
 
 TEST(grapphs, adjacency_matrix_disconnecting) {
@@ -20,4 +22,16 @@ TEST(grapphs, adjacency_matrix_disconnecting) {
     int to = k_graph_size;
     graph.disconnect(from, to);
     EXPECT_EQ(*graph.edge(from, to), 0);
-}
\ No newline at end of file
+}
+
+TEST(grapphs, adjacency_matrix_pmr) {
+    std::pmr::monotonic_buffer_resource arena(std::pmr::new_delete_resource());
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        gpp::pmr::adjacency_matrix<int, int> graph(k_graph_size, &arena);
+        graph.connect(1, 2, 12);
+        EXPECT_EQ(*graph.edge(1, 2), 12);
+        EXPECT_EQ(graph.get_allocator().resource(), &arena);
+    }
+    std::pmr::set_default_resource(previous);
+}
@@ -40,4 +40,45 @@ TEST(grapphs, astar) {
             }
         }
     );
-}
\ No newline at end of file
+}
+
+TEST(grapphs, astar_statistics) {
+    gpp::adjacency_list<int, float> graph;
+    for (int i = 0; i < 4; ++i) {
+        graph.push(i);
+    }
+    graph.connect(0, 1, 1.0F);
+    graph.connect(0, 2, 4.0F);
+    graph.connect(1, 2, 1.0F);
+    graph.connect(2, 3, 1.0F);
+
+    gpp::search_statistics statistics;
+    gpp::graph_path path = gpp::astar(
+        graph,
+        0,
+        3,
+        [](std::size_t, std::size_t) {
+            return 0.0F;
+        },
+        [](std::size_t, std::size_t, float distance) {
+            return distance;
+        },
+        statistics
+    );
+    EXPECT_EQ(path.get_vertices(), (std::vector<std::size_t>{0, 1, 2, 3}));
+    EXPECT_EQ(statistics.verticesExpanded, 3);
+    EXPECT_EQ(statistics.edgesRelaxed, 4);
+    EXPECT_EQ(statistics.heapPushes, 4);
+    EXPECT_EQ(statistics.decreaseKeys, 1);
+    EXPECT_EQ(statistics.peakOpenSize, 2);
+    EXPECT_GT(statistics.phase_time(gpp::search_phase::SEARCH).count(), 0);
+
+    gpp::search_statistics total;
+    total += statistics;
+    total += statistics;
+    EXPECT_EQ(total.verticesExpanded, 6);
+    EXPECT_EQ(total.peakOpenSize, 2);
+    EXPECT_EQ(total.total_time(), 2 * statistics.total_time());
+    total.reset();
+    EXPECT_EQ(total.edgesRelaxed, 0);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <grapphs/binary.h>
+#include <grapphs/graph_builder.h>
+#include <grapphs/algorithms/bfs_traversal.h>
+
+#include <fstream>
+
+struct binary_vertex {
+    float x, y;
+};
+
+namespace {
+    gpp::csr_graph<binary_vertex, float> build_binary_graph() {
+        gpp::graph_builder<float> builder;
+        std::vector<binary_vertex> vertices;
+        for (int i = 0; i < 100; ++i) {
+            vertices.push_back(binary_vertex{static_cast<float>(i), static_cast<float>(-i)});
+            if (i > 0) {
+                builder.add(i - 1, i, static_cast<float>(i) * 0.5F);
+            }
+        }
+        builder.add(99, 0, 1.0F);
+        return builder.build_csr(std::move(vertices));
+    }
+
+    /**
+     * Overwrites element \p element of section \p id of the file at \p path with \p value.
+     */
+    void patch_section(
+        const std::filesystem::path& path,
+        gpp::binary_section_id id,
+        std::size_t element,
+        gpp::default_graph_index value
+    ) {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        gpp::binary_header header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        for (std::uint32_t i = 0; i < header.numSections; ++i) {
+            gpp::binary_section section{};
+            file.read(reinterpret_cast<char*>(&section), sizeof(section));
+            if (section.id == static_cast<std::uint32_t>(id)) {
+                ASSERT_EQ(section.elementSize, sizeof(value));
+                file.seekp(static_cast<std::streamoff>(section.offset + element * sizeof(value)));
+                file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+                return;
+            }
+        }
+        FAIL() << "missing section";
+    }
+}
+
+TEST(grapphs, binary_round_trip) {
+    auto graph = build_binary_graph();
+    auto path = std::filesystem::temp_directory_path() / "grapphs_binary_round_trip.gpp";
+    ASSERT_TRUE(gpp::save_binary(graph, path));
+
+    auto loaded = gpp::load_binary<binary_vertex, float>(path);
+    ASSERT_EQ(loaded.size(), graph.size());
+    EXPECT_EQ(loaded.targets(), graph.targets());
+    EXPECT_EQ(loaded.edges(), graph.edges());
+
+    auto mapped = gpp::map_binary<binary_vertex, float>(path);
+    ASSERT_EQ(mapped.size(), graph.size());
+    EXPECT_EQ(mapped.num_edges(), graph.num_edges());
+    for (std::size_t i = 0; i < graph.size(); ++i) {
+        EXPECT_EQ(mapped.vertex(i)->x, graph.vertex(i)->x);
+        EXPECT_EQ(mapped.degree(i), graph.degree(i));
+    }
+    ASSERT_NE(mapped.edge(98, 99), nullptr);
+    EXPECT_EQ(*mapped.edge(98, 99), 49.5F);
+    EXPECT_EQ(mapped.edge(99, 98), nullptr);
+
+    std::size_t numVisited = 0;
+    gpp::breadth_first_traverse(
+        mapped, 0, [&](std::size_t) { numVisited++; }, [](std::size_t, std::size_t) {}
+    );
+    EXPECT_EQ(numVisited, graph.size());
+    std::filesystem::remove(path);
+}
+
+TEST(grapphs, binary_type_mismatch) {
+    auto path = std::filesystem::temp_directory_path() / "grapphs_binary_mismatch.gpp";
+    ASSERT_TRUE(gpp::save_binary(build_binary_graph(), path));
+    EXPECT_THROW((gpp::map_binary<binary_vertex, double>(path)), std::runtime_error);
+    EXPECT_THROW((gpp::load_binary<binary_vertex, float>(path.string() + ".missing")), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(grapphs, binary_corrupt_section_count) {
+    auto path = std::filesystem::temp_directory_path() / "grapphs_binary_corrupt.gpp";
+    ASSERT_TRUE(gpp::save_binary(build_binary_graph(), path));
+    {
+        // A count whose size in bytes wraps around to a few bytes
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        std::uint64_t count = (std::uint64_t(1) << 62) + 1;
+        file.seekp(sizeof(gpp::binary_header) + offsetof(gpp::binary_section, count));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    EXPECT_THROW((gpp::map_binary<binary_vertex, float>(path)), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(grapphs, binary_corrupt_offsets) {
+    auto path = std::filesystem::temp_directory_path() / "grapphs_binary_offsets.gpp";
+    ASSERT_TRUE(gpp::save_binary(build_binary_graph(), path));
+    // Vertex 10 would start past the end of vertex 11
+    patch_section(path, gpp::binary_section_id::OFFSETS, 11, 50);
+    EXPECT_THROW((gpp::map_binary<binary_vertex, float>(path)), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(grapphs, binary_corrupt_targets) {
+    auto path = std::filesystem::temp_directory_path() / "grapphs_binary_targets.gpp";
+    ASSERT_TRUE(gpp::save_binary(build_binary_graph(), path));
+    patch_section(path, gpp::binary_section_id::TARGETS, 42, 100);
+    EXPECT_THROW((gpp::map_binary<binary_vertex, float>(path)), std::runtime_error);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <grapphs/adjacency_list.h>
+#include <grapphs/algorithms/chain_contraction.h>
+
+TEST(grapphs, chain_contraction) {
+    gpp::adjacency_list<int, float> graph;
+    for (int i = 0; i < 9; ++i) {
+        graph.push(i);
+    }
+    auto connectBoth = [&](std::size_t a, std::size_t b, float cost) {
+        graph.connect(a, b, cost);
+        graph.connect(b, a, cost);
+    };
+    // Dead end 0, shape vertices 1 and 2, junction 3 with dead ends 4 and 5.
+    connectBoth(0, 1, 1);
+    connectBoth(1, 2, 2);
+    connectBoth(2, 3, 3);
+    connectBoth(3, 4, 4);
+    connectBoth(3, 5, 5);
+    // One way cycle made of shape vertices only.
+    graph.connect(6, 7, 1);
+    graph.connect(7, 8, 1);
+    graph.connect(8, 6, 1);
+
+    auto contracted = gpp::contract_chains(
+        graph, [](std::size_t, std::size_t, float edge) {
+            return edge;
+        }
+    );
+    const auto& result = contracted.graph();
+    EXPECT_EQ(result.size(), 5);
+    EXPECT_EQ(result.num_edges(), 7);
+    EXPECT_EQ(contracted.to_contracted(1), contracted.invalid_index());
+    EXPECT_EQ(contracted.to_contracted(2), contracted.invalid_index());
+
+    std::size_t from = contracted.to_contracted(0);
+    std::size_t junction = contracted.to_contracted(3);
+    ASSERT_NE(result.edge(from, junction), nullptr);
+    const auto& chain = *result.edge(from, junction);
+    EXPECT_EQ(chain.cost, 6);
+    auto [points, numPoints] = contracted.polyline(chain);
+    EXPECT_EQ(std::vector<std::size_t>(points, points + numPoints), (std::vector<std::size_t>{0, 1, 2, 3}));
+    ASSERT_NE(result.edge(junction, from), nullptr);
+    EXPECT_EQ(result.edge(junction, from)->cost, 6);
+
+    std::vector<std::size_t> path = {contracted.to_contracted(4), junction, from};
+    EXPECT_EQ(contracted.expand(path), (std::vector<std::size_t>{4, 3, 2, 1, 0}));
+    EXPECT_THROW(contracted.expand({from, contracted.to_contracted(4)}), std::invalid_argument);
+
+    std::size_t kept = 0;
+    for (std::size_t i = 6; i < 9; ++i) {
+        kept += contracted.to_contracted(i) != contracted.invalid_index();
+    }
+    ASSERT_EQ(kept, 1);
+    std::size_t cycle = result.size() - 1;
+    ASSERT_NE(result.edge(cycle, cycle), nullptr);
+    EXPECT_EQ(result.edge(cycle, cycle)->cost, 3);
+    EXPECT_EQ(result.edge(cycle, cycle)->numPoints, 4);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <grapphs/generators.h>
+
+#include <cmath>
+
+typedef gpp::csr_graph<int, float> generated_graph;
+
+/**
+ * Generates the same graph on 1 and 8 threads and expects both to match.
+ */
+template<typename t_generate>
+generated_graph generate_deterministic(const t_generate& generate) {
+    generated_graph graphs[2];
+    std::size_t threadCounts[2] = {1, 8};
+    for (std::size_t i = 0; i < 2; ++i) {
+        gpp::graph_builder<float> builder;
+        std::size_t numVertices = generate(builder, gpp::generator_options{42, threadCounts[i]});
+        graphs[i] = builder.build_csr(std::vector<int>(numVertices));
+    }
+    EXPECT_EQ(graphs[0].offsets(), graphs[1].offsets());
+    EXPECT_EQ(graphs[0].targets(), graphs[1].targets());
+    EXPECT_EQ(graphs[0].edges(), graphs[1].edges());
+    return std::move(graphs[0]);
+}
+
+TEST(grapphs, generate_erdos_renyi) {
+    constexpr std::size_t numVertices = 20000;
+    constexpr double probability = 0.001;
+    generated_graph graph = generate_deterministic(
+        [&](auto& builder, const gpp::generator_options& options) {
+            return gpp::generate_erdos_renyi(builder, numVertices, probability, options);
+        }
+    );
+    ASSERT_EQ(graph.size(), numVertices);
+    double expected = probability * numVertices * (numVertices - 1);
+    EXPECT_NEAR(static_cast<double>(graph.num_edges()), expected, 5 * std::sqrt(expected));
+    for (std::size_t i = 0; i < numVertices; ++i) {
+        EXPECT_EQ(graph.edge(i, i), nullptr);
+    }
+
+    gpp::graph_builder<float> complete;
+    gpp::generate_erdos_renyi(complete, 10, 1.0);
+    EXPECT_EQ(complete.num_edges(), 90);
+    EXPECT_THROW(gpp::generate_erdos_renyi(complete, 10, 1.5), std::invalid_argument);
+}
+
+TEST(grapphs, generate_rmat) {
+    constexpr unsigned scale = 14;
+    constexpr std::size_t numEdges = 16 << scale;
+    generated_graph graph = generate_deterministic(
+        [&](auto& builder, const gpp::generator_options& options) {
+            return gpp::generate_rmat(builder, scale, numEdges, gpp::rmat_parameters(), options);
+        }
+    );
+    ASSERT_EQ(graph.size(), 1 << scale);
+    EXPECT_EQ(graph.num_edges(), numEdges);
+    // Degrees are skewed, far from the average of 16
+    std::size_t maxDegree = 0;
+    for (std::size_t i = 0; i < graph.size(); ++i) {
+        maxDegree = std::max(maxDegree, graph.degree(i));
+    }
+    EXPECT_GT(maxDegree, 1000);
+
+    gpp::graph_builder<float> invalid;
+    EXPECT_THROW(gpp::generate_rmat(invalid, 4, 1, gpp::rmat_parameters{0.5, 0.5, 0.5}), std::invalid_argument);
+}
+
+TEST(grapphs, generate_grid) {
+    gpp::grid_size size{40, 30, 20};
+    gpp::graph_builder<float> open;
+    gpp::generate_grid(open, size);
+    generated_graph openGraph = open.build_csr(std::vector<int>(size.size()));
+    std::size_t passages = (size.width - 1) * size.height * size.depth
+                           + size.width * (size.height - 1) * size.depth
+                           + size.width * size.height * (size.depth - 1);
+    EXPECT_EQ(openGraph.num_edges(), 2 * passages);
+    EXPECT_EQ(openGraph.degree(size.index_of(0, 0, 0)), 3);
+    EXPECT_EQ(openGraph.degree(size.index_of(1, 1, 1)), 6);
+    ASSERT_NE(openGraph.edge(size.index_of(1, 1, 1), size.index_of(1, 1, 2)), nullptr);
+    EXPECT_EQ(*openGraph.edge(size.index_of(1, 1, 1), size.index_of(1, 1, 2)), 1.0F);
+
+    generated_graph walled = generate_deterministic(
+        [&](auto& builder, const gpp::generator_options& options) {
+            return gpp::generate_grid(builder, size, 0.3, options);
+        }
+    );
+    EXPECT_NEAR(static_cast<double>(walled.num_edges()), 0.7 * 2 * passages, 0.02 * passages);
+    for (std::size_t from = 0; from < walled.size(); ++from) {
+        for (auto [to, edge] : walled.edges_from(from)) {
+            EXPECT_NE(walled.edge(to, from), nullptr);
+        }
+    }
+}
+
+TEST(grapphs, generate_geometric) {
+    constexpr std::size_t numVertices = 50000;
+    constexpr double averageDegree = 4;
+    std::vector<gpp::generated_point> points;
+    generated_graph graph = generate_deterministic(
+        [&](auto& builder, const gpp::generator_options& options) {
+            points = gpp::generate_geometric(builder, numVertices, averageDegree, options);
+            return points.size();
+        }
+    );
+    ASSERT_EQ(graph.size(), numVertices);
+    // Slightly less than asked for, as points near the border have fewer neighbours
+    double degree = static_cast<double>(graph.num_edges()) / numVertices;
+    EXPECT_GT(degree, averageDegree * 0.95);
+    EXPECT_LT(degree, averageDegree * 1.05);
+    for (std::size_t from = 0; from < graph.size(); ++from) {
+        for (auto [to, edge] : graph.edges_from(from)) {
+            float dx = points[to].x - points[from].x;
+            float dy = points[to].y - points[from].y;
+            EXPECT_FLOAT_EQ(edge, std::sqrt(dx * dx + dy * dy));
+            ASSERT_NE(graph.edge(to, from), nullptr);
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include <grapphs/graph_builder.h>
+
+#include <random>
+#include <thread>
+
+TEST(grapphs, graph_builder_csr) {
+    gpp::graph_builder<float> builder;
+    builder.add(0, 1, 0.5F);
+    builder.add(1, 2, 1.0F);
+    builder.add(0, 2, 2.0F);
+    builder.add(2, 0, 3.0F);
+
+    gpp::csr_graph<int, float> graph = builder.build_csr(std::vector<int>{5, 10, 15});
+
+    EXPECT_EQ(graph.size(), 3);
+    EXPECT_EQ(graph.num_edges(), 4);
+    EXPECT_EQ(builder.num_edges(), 0);
+    EXPECT_EQ(*graph.vertex(1), 10);
+    EXPECT_EQ(graph.degree(0), 2);
+    ASSERT_NE(graph.edge(0, 2), nullptr);
+    EXPECT_EQ(*graph.edge(0, 2), 2.0F);
+    EXPECT_EQ(graph.edge(1, 0), nullptr);
+
+    std::set<std::pair<std::size_t, float>> pending = {{1, 0.5F}, {2, 2.0F}};
+    for (const auto& [destination, edge] : graph.edges_from(0)) {
+        EXPECT_GT(pending.erase({destination, edge}), 0)
+                        << "Unexpected connection from 0 to " << destination;
+    }
+    EXPECT_TRUE(pending.empty());
+}
+
+TEST(grapphs, csr_graph_transpose) {
+    gpp::graph_builder<int> builder;
+    builder.add(0, 1, 1);
+    builder.add(0, 2, 2);
+    builder.add(2, 1, 21);
+
+    auto transposed = builder.build_csr(std::vector<int>(3)).transpose();
+    EXPECT_EQ(transposed.num_edges(), 3);
+    EXPECT_EQ(transposed.degree(0), 0);
+    EXPECT_EQ(transposed.degree(1), 2);
+    ASSERT_NE(transposed.edge(1, 2), nullptr);
+    EXPECT_EQ(*transposed.edge(1, 2), 21);
+    ASSERT_NE(transposed.edge(2, 0), nullptr);
+    EXPECT_EQ(*transposed.edge(2, 0), 2);
+    EXPECT_EQ(transposed.offsets(), (std::vector<std::size_t>{0, 0, 2, 3}));
+    EXPECT_EQ(transposed.targets(), (std::vector<std::size_t>{0, 2, 0}));
+}
+
+TEST(grapphs, graph_builder_dedup_and_self_loops) {
+    gpp::graph_builder<int> builder;
+    builder.set_deduplicate(true);
+    builder.set_remove_self_loops(true);
+    builder.add(0, 0, 1);
+    builder.add(0, 2, 1);
+    builder.add(0, 1, 1);
+    builder.add(0, 2, 1);
+    builder.add(1, 1, 1);
+
+    auto graph = builder.build_csr(std::vector<int>(3));
+    EXPECT_EQ(graph.num_edges(), 2);
+    EXPECT_EQ(graph.edge(0, 0), nullptr);
+    EXPECT_EQ(graph.edge(1, 1), nullptr);
+    EXPECT_EQ(graph.targets(), (std::vector<std::size_t>{1, 2}));
+}
+
+TEST(grapphs, graph_builder_keeps_first_duplicate) {
+    // Enough edges for several chunks, each duplicate pair added with increasing weights
+    constexpr std::size_t numVertices = 64;
+    constexpr std::size_t numEdges = 1 << 17;
+    auto fill = [&](auto& builder) {
+        builder.set_num_threads(8);
+        for (std::size_t i = 0; i < numEdges; ++i) {
+            builder.add(i % numVertices, (i / numVertices) % numVertices, static_cast<int>(i));
+        }
+    };
+
+    gpp::graph_builder<int> deduplicated;
+    deduplicated.set_deduplicate(true);
+    fill(deduplicated);
+    auto graph = deduplicated.build_csr(std::vector<int>(numVertices));
+    ASSERT_EQ(graph.num_edges(), numVertices * numVertices);
+    for (std::size_t from = 0; from < numVertices; ++from) {
+        for (const auto& [to, edge] : graph.edges_from(from)) {
+            EXPECT_EQ(edge, static_cast<int>(to * numVertices + from));
+        }
+    }
+
+    gpp::graph_builder<int> ordered;
+    fill(ordered);
+    auto all = ordered.build_csr(std::vector<int>(numVertices));
+    for (std::size_t from = 0; from < numVertices; ++from) {
+        int previous = -1;
+        for (const auto& [to, edge] : all.edges_from(from)) {
+            EXPECT_LT(previous, edge);
+            previous = edge;
+        }
+    }
+
+    gpp::adjacency_list<int, int> list;
+    for (std::size_t i = 0; i < numVertices; ++i) {
+        list.push(0);
+    }
+    gpp::graph_builder<int> into;
+    fill(into);
+    into.build_into(list);
+    ASSERT_NE(list.edge(1, 2), nullptr);
+    EXPECT_EQ(*list.edge(1, 2), static_cast<int>(2 * numVertices + 1));
+}
+
+TEST(grapphs, graph_builder_out_of_range) {
+    gpp::graph_builder<int> builder;
+    builder.add(0, 3, 1);
+    EXPECT_THROW(builder.build_csr(std::vector<int>(3)), std::out_of_range);
+}
+
+TEST(grapphs, graph_builder_concurrent_batches) {
+    constexpr std::size_t numVertices = 1 << 12;
+    constexpr std::size_t edgesPerThread = 1 << 16;
+    constexpr std::size_t numThreads = 4;
+
+    gpp::graph_builder<std::size_t> builder;
+    builder.set_sort_targets(true);
+    std::vector<std::thread> producers;
+    for (std::size_t t = 0; t < numThreads; ++t) {
+        producers.emplace_back(
+            [&, t]() {
+                std::mt19937_64 random(t);
+                std::uniform_int_distribution<std::size_t> dist(0, numVertices - 1);
+                gpp::graph_builder<std::size_t>::batch batch;
+                batch.reserve(edgesPerThread);
+                for (std::size_t i = 0; i < edgesPerThread; ++i) {
+                    std::size_t from = dist(random);
+                    std::size_t to = dist(random);
+                    batch.add(from, to, from * numVertices + to);
+                }
+                builder.submit(std::move(batch));
+            }
+        );
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(builder.num_edges(), numThreads * edgesPerThread);
+
+    auto graph = builder.build_csr(std::vector<int>(numVertices));
+    EXPECT_EQ(graph.num_edges(), numThreads * edgesPerThread);
+    for (std::size_t from = 0; from < numVertices; ++from) {
+        std::size_t previous = 0;
+        for (const auto& [to, edge] : graph.edges_from(from)) {
+            EXPECT_EQ(edge, from * numVertices + to);
+            EXPECT_LE(previous, to);
+            previous = to;
+        }
+    }
+}
+
+TEST(grapphs, graph_builder_into_adjacency_list) {
+    gpp::adjacency_list<int, int> graph;
+    for (int i = 0; i < 4; ++i) {
+        graph.push(i);
+    }
+    graph.connect(3, 0, 30);
+
+    gpp::graph_builder<int> builder;
+    builder.add(0, 1, 1);
+    builder.add(1, 2, 12);
+    builder.add(3, 2, 32);
+    builder.build_into(graph);
+
+    ASSERT_NE(graph.edge(1, 2), nullptr);
+    EXPECT_EQ(*graph.edge(1, 2), 12);
+    ASSERT_NE(graph.edge(3, 0), nullptr);
+    EXPECT_EQ(*graph.edge(3, 0), 30);
+    ASSERT_NE(graph.edge(3, 2), nullptr);
+    EXPECT_EQ(*graph.edge(3, 2), 32);
+    EXPECT_EQ(graph.edge(2, 1), nullptr);
+}
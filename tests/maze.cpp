@@ -116,4 +116,28 @@ TEST(grapphs, maze_flood) {
         );
         ASSERT_TRUE(pending.empty()) << "Pending vertices " << gpp::tests::join_string(pending) << " were not visited.";
     });
-}
\ No newline at end of file
+}
+
+TEST(grapphs, maze_binary) {
+    gpp::test_mazes([](gpp::maze& m) {
+        std::filesystem::path binaryPath = std::filesystem::temp_directory_path() / "grapphs_maze.bin";
+        ASSERT_TRUE(m.save_binary(binaryPath));
+        gpp::maze loaded(binaryPath);
+        std::filesystem::remove(binaryPath);
+        ASSERT_EQ(loaded.get_size(), m.get_size());
+        ASSERT_EQ(loaded.get_start(), m.get_start());
+        ASSERT_EQ(loaded.get_end(), m.get_end());
+        ASSERT_EQ(loaded.get_shortest_path(), m.get_shortest_path());
+        const auto& expected = m.get_graph();
+        const auto& graph = loaded.get_graph();
+        ASSERT_EQ(graph.size(), expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(graph.vertex(i)->x, expected.vertex(i)->x);
+            ASSERT_EQ(graph.vertex(i)->y, expected.vertex(i)->y);
+            for (const auto& [to, edge] : expected.edges_from(i)) {
+                ASSERT_NE(graph.edge(i, to), nullptr);
+            }
+            ASSERT_EQ(graph.node(i).connections().size(), expected.node(i).connections().size());
+        }
+    });
+}
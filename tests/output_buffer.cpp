@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <grapphs/output_buffer.h>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace {
+    void write_sample(gpp::output_buffer& out) {
+        out.write("x=").write(1.5F, 2)
+           .write(" y=").write(-0.001F, 2)
+           .write(" z=").write(3.0, 3)
+           .write(" n=").write(-42)
+           .write(" c=#").write_hex(0x0A).write_hex(0xFF)
+           .put('\n');
+    }
+}
+
+TEST(grapphs, output_buffer_formatting) {
+    std::ostringstream stream;
+    {
+        gpp::output_buffer out(stream, 16);
+        write_sample(out);
+        EXPECT_EQ(out.size(), 28);
+    }
+    EXPECT_EQ(stream.str(), "x=1.5 y=0 z=3 n=-42 c=#0aff\n");
+}
+
+TEST(grapphs, output_buffer_huge_floats) {
+    std::ostringstream stream;
+    {
+        // Huge values fall back to scientific notation, whose exponent must survive intact
+        // however full the buffer is.
+        gpp::output_buffer out(stream, 16);
+        out.write(1.5e300, 2).put(' ');
+        out.write("abcdefgh").write(1.5e300, 2).put(' ');
+        out.write(-2e100, 3).put(' ');
+        out.write(1e50, 2);
+    }
+    EXPECT_EQ(stream.str(), "1.5e+300 abcdefgh1.5e+300 -2e+100 100000000000000007629769841091887003294964970946560");
+}
+
+TEST(grapphs, output_buffer_mapped_file) {
+    auto path = std::filesystem::temp_directory_path() / "grapphs_output_buffer.txt";
+    std::ostringstream expected;
+    {
+        gpp::output_buffer streamed(expected);
+        gpp::output_buffer mapped(path);
+        for (int i = 0; i < 100000; ++i) {
+            write_sample(streamed);
+            write_sample(mapped);
+        }
+    }
+    std::ifstream file(path, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(contents.size(), expected.str().size());
+    EXPECT_EQ(contents, expected.str());
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <grapphs/adjacency_list.h>
+#include <grapphs/algorithms/reorder.h>
+
+#include <random>
+
+namespace {
+    /**
+     * Path 0 - 1 - ... - n-1 connected both ways, with its vertices pushed in shuffled order.
+     */
+    gpp::adjacency_list<int, int> shuffled_path(std::size_t numVertices, std::vector<std::size_t>& positions) {
+        positions.resize(numVertices);
+        std::iota(positions.begin(), positions.end(), 0);
+        std::shuffle(positions.begin(), positions.end(), std::mt19937(42));
+        gpp::adjacency_list<int, int> graph;
+        std::vector<std::size_t> indexOf(numVertices);
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            graph.push(static_cast<int>(positions[i]));
+            indexOf[positions[i]] = i;
+        }
+        for (std::size_t p = 1; p < numVertices; ++p) {
+            graph.connect(indexOf[p - 1], indexOf[p], static_cast<int>(p));
+            graph.connect(indexOf[p], indexOf[p - 1], static_cast<int>(p));
+        }
+        return graph;
+    }
+
+    template<typename t_graph>
+    std::size_t bandwidth(const t_graph& graph) {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < graph.size(); ++i) {
+            for (const auto& [to, edge] : graph.edges_from(i)) {
+                result = std::max(result, i > to ? i - to : to - i);
+            }
+        }
+        return result;
+    }
+}
+
+TEST(grapphs, reorder_reverse_cuthill_mckee) {
+    std::vector<std::size_t> positions;
+    auto graph = shuffled_path(64, positions);
+    EXPECT_GT(bandwidth(graph), 1);
+
+    auto permutation = gpp::reverse_cuthill_mckee_order(graph);
+    auto reordered = gpp::reorder(graph, permutation);
+    EXPECT_EQ(reordered.size(), graph.size());
+    EXPECT_EQ(bandwidth(reordered), 1);
+
+    for (std::size_t old = 0; old < graph.size(); ++old) {
+        std::size_t relabeled = permutation.oldToNew[old];
+        EXPECT_EQ(permutation.newToOld[relabeled], old);
+        EXPECT_EQ(*reordered.vertex(relabeled), *graph.vertex(old));
+        for (const auto& [to, edge] : graph.edges_from(old)) {
+            const int* moved = reordered.edge(relabeled, permutation.oldToNew[to]);
+            ASSERT_NE(moved, nullptr);
+            EXPECT_EQ(*moved, edge);
+        }
+    }
+}
+
+TEST(grapphs, reorder_traversal_orders) {
+    gpp::adjacency_list<int, int> graph;
+    for (int i = 0; i < 5; ++i) {
+        graph.push(i);
+    }
+    graph.connect(0, 3, 0);
+    graph.connect(0, 1, 0);
+    graph.connect(3, 2, 0);
+
+    auto bfs = gpp::bfs_order(graph);
+    EXPECT_EQ(bfs.newToOld.front(), 0);
+    EXPECT_EQ(bfs.newToOld.back(), 4);
+    EXPECT_EQ(bfs.newToOld[3], 2);
+
+    auto dfs = gpp::dfs_order(graph, 3);
+    EXPECT_EQ(dfs.newToOld, (std::vector<std::size_t>{3, 2, 0, 1, 4}));
+
+    EXPECT_THROW(gpp::vertex_permutation<>::from_order({0, 0, 1}), std::invalid_argument);
+}
+
+TEST(grapphs, reorder_hilbert) {
+    constexpr std::size_t side = 16;
+    gpp::adjacency_list<int, int> graph;
+    std::vector<std::size_t> positions(side * side);
+    std::iota(positions.begin(), positions.end(), 0);
+    std::shuffle(positions.begin(), positions.end(), std::mt19937(7));
+    for (std::size_t position : positions) {
+        graph.push(static_cast<int>(position));
+    }
+    auto permutation = gpp::hilbert_order(
+        graph, [&](std::size_t index, double& x, double& y) {
+            x = static_cast<double>(*graph.vertex(index) % side);
+            y = static_cast<double>(*graph.vertex(index) / side);
+        }
+    );
+    // Consecutive points along a Hilbert curve over a full grid are always adjacent cells.
+    for (std::size_t i = 1; i < permutation.size(); ++i) {
+        int a = *graph.vertex(permutation.newToOld[i - 1]);
+        int b = *graph.vertex(permutation.newToOld[i]);
+        int distance = std::abs(a % 16 - b % 16) + std::abs(a / 16 - b / 16);
+        EXPECT_EQ(distance, 1) << "Between " << a << " and " << b;
+    }
+}
@@ -1,14 +1,23 @@
 #include <grapphs/tests/mazes.h>
 
+#include <algorithm>
+
 namespace gpp {
 
-    maze::maze(const std::filesystem::path& jsonPath) {
-        if (!std::filesystem::exists(jsonPath)) {
+    maze::maze(const std::filesystem::path& path) {
+        if (!std::filesystem::exists(path)) {
             std::stringstream stream;
-            stream << "json path '" << std::filesystem::absolute(jsonPath) << "'does not exist";
+            stream << "maze path '" << std::filesystem::absolute(path) << "'does not exist";
             throw std::runtime_error(stream.str());
         }
+        if (path.extension() == ".bin") {
+            load_binary(path);
+        } else {
+            load_json(path);
+        }
+    }
 
+    void maze::load_json(const std::filesystem::path& jsonPath) {
         std::fstream file(jsonPath);
         nlohmann::json json;
         file >> json;
@@ -21,13 +30,15 @@ namespace gpp {
             _graph.push(Cell(x, y));
         }
 
+        gpp::graph_builder<int> builder;
         auto edges = json["edges"].get<nlohmann::json>();
         for (const auto& [key, edge] : edges.items()) {
             std::size_t index = std::stoul(key);
             for (std::size_t to : edge.get<std::vector<std::size_t >>()) {
-                _graph.connect(index, to, 1);
+                builder.add(index, to, 1);
             }
         }
+        builder.build_into(_graph);
 
         _start = json["start"].get<std::size_t>();
         _end = json["end"].get<std::size_t>();
@@ -35,6 +46,75 @@ namespace gpp {
         _shortestPath = json["shortest_path"].get<std::vector<size_t >>();
     }
 
+    void maze::load_binary(const std::filesystem::path& binaryPath) {
+        binary_reader reader(binaryPath);
+        std::size_t numVertices;
+        std::size_t numOffsets;
+        std::size_t numTargets;
+        std::size_t numEdges;
+        std::size_t numInfo;
+        std::size_t numPath;
+        const Cell* vertices = reader.section<Cell>(binary_section_id::VERTICES, numVertices);
+        const auto* offsets = reader.section<std::uint32_t>(binary_section_id::OFFSETS, numOffsets);
+        const auto* targets = reader.section<std::uint32_t>(binary_section_id::TARGETS, numTargets);
+        const auto* edges = reader.section<int>(binary_section_id::EDGES, numEdges);
+        const auto* info = reader.section<std::uint64_t>(static_cast<std::uint32_t>(maze_section_id::INFO), numInfo);
+        const auto* path = reader.section<std::uint32_t>(static_cast<std::uint32_t>(maze_section_id::SHORTEST_PATH), numPath);
+        if (numOffsets != numVertices + 1 || numTargets != numEdges || offsets[numVertices] != numEdges || numInfo != 3) {
+            throw std::runtime_error("inconsistent binary maze '" + binaryPath.string() + "'");
+        }
+
+        // The file already holds every vertex's connections in order, so each one is
+        // reserved and filled in one go instead of going through a graph_builder.
+        _graph.reserve(numVertices);
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            _graph.push(vertices[i]);
+        }
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            auto& node = _graph.node(i);
+            node.reserve(offsets[i + 1] - offsets[i]);
+            for (std::uint32_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+                if (targets[j] >= numVertices) {
+                    throw std::runtime_error("edge out of range in binary maze '" + binaryPath.string() + "'");
+                }
+                node.connect(targets[j], edges[j]);
+            }
+        }
+        _graph.rebuild_incoming_index();
+
+        _size = info[0];
+        _start = info[1];
+        _end = info[2];
+        _shortestPath.assign(path, path + numPath);
+    }
+
+    bool maze::save_binary(const std::filesystem::path& binaryPath) const {
+        std::vector<Cell> vertices;
+        std::vector<std::uint32_t> offsets = {0};
+        std::vector<std::uint32_t> targets;
+        std::vector<int> edges;
+        vertices.reserve(_graph.size());
+        for (std::size_t i = 0; i < _graph.size(); ++i) {
+            vertices.push_back(*_graph.vertex(i));
+            for (const auto& [to, edge] : _graph.edges_from(i)) {
+                targets.push_back(static_cast<std::uint32_t>(to));
+                edges.push_back(edge);
+            }
+            offsets.push_back(static_cast<std::uint32_t>(targets.size()));
+        }
+        std::vector<std::uint64_t> info = {_size, _start, _end};
+        std::vector<std::uint32_t> path(_shortestPath.begin(), _shortestPath.end());
+
+        binary_writer writer;
+        writer.add_section(binary_section_id::VERTICES, vertices);
+        writer.add_section(binary_section_id::OFFSETS, offsets);
+        writer.add_section(binary_section_id::TARGETS, targets);
+        writer.add_section(binary_section_id::EDGES, edges);
+        writer.add_section(static_cast<std::uint32_t>(maze_section_id::INFO), info);
+        writer.add_section(static_cast<std::uint32_t>(maze_section_id::SHORTEST_PATH), path);
+        return writer.write(binaryPath);
+    }
+
     const gpp::adjacency_list<Cell, int>& maze::get_graph() const {
         return _graph;
     }
@@ -62,16 +142,32 @@ namespace gpp {
 
     Cell::Cell(int x, int y) : x(x), y(y) {}
 
-    void test_mazes(const std::function<void(maze&)>& block) {
+    std::vector<std::filesystem::path> maze_paths() {
         auto wdir = std::filesystem::current_path();
         std::filesystem::path mazesDir = wdir / "mazes";
-        std::filesystem::directory_iterator ot(mazesDir);
-        for (auto entry : ot) {
-            GTEST_LOG_(INFO) << "Reading maze " << entry.path() << " (" << entry.file_size()
+        std::vector<std::filesystem::path> paths;
+        for (const auto& entry : std::filesystem::directory_iterator(mazesDir)) {
+            const std::filesystem::path& path = entry.path();
+            if (path.extension() == ".bin") {
+                paths.push_back(path);
+            } else if (path.extension() == ".json") {
+                std::filesystem::path binaryPath = path;
+                binaryPath.replace_extension(".bin");
+                if (!std::filesystem::exists(binaryPath)) {
+                    paths.push_back(path);
+                }
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+
+    void test_mazes(const std::function<void(maze&)>& block) {
+        for (const std::filesystem::path& path : maze_paths()) {
+            GTEST_LOG_(INFO) << "Reading maze " << path << " (" << std::filesystem::file_size(path)
                              << " bytes).";
 
-            std::filesystem::path jsonPath = entry.path();
-            maze m(jsonPath);
+            maze m(path);
             block(m);
 
         }
@@ -6,6 +6,8 @@
 #define GRAPPHS_MAZES_H
 
 #include <grapphs/adjacency_list.h>
+#include <grapphs/binary.h>
+#include <grapphs/graph_builder.h>
 #include <filesystem>
 #include <fstream>
 #include <nlohmann/json.hpp>
@@ -20,14 +22,45 @@ namespace gpp {
         friend std::ostream& operator<<(std::ostream& os, const Cell& cell);
     };
 
+    /**
+     * Sections of binary maze files besides the graph's own. Binary mazes are grapphs binary
+     * files (see gpp::binary_writer) emitted by scripts/maze_gen.py alongside the json ones,
+     * with std::uint32_t indices.
+     */
+    enum class maze_section_id : std::uint32_t {
+        /**
+         * Size, start and end, as three std::uint64_t.
+         */
+        INFO = static_cast<std::uint32_t>(binary_section_id::USER),
+        /**
+         * Vertex indices, as std::uint32_t.
+         */
+        SHORTEST_PATH
+    };
+
     class maze {
     private:
         gpp::adjacency_list<Cell, int> _graph;
         std::size_t _start, _end;
         std::size_t _size;
         std::vector<size_t> _shortestPath;
+
+        void load_json(const std::filesystem::path& jsonPath);
+
+        void load_binary(const std::filesystem::path& binaryPath);
+
     public:
-        maze(const std::filesystem::path& jsonPath);
+        /**
+         * Loads the maze at \p path, which is read as a binary maze if its extension is .bin
+         * and as json otherwise.
+         */
+        maze(const std::filesystem::path& path);
+
+        /**
+         * Saves this maze in the binary maze format.
+         * @returns false if the file could not be written.
+         */
+        bool save_binary(const std::filesystem::path& binaryPath) const;
 
         const gpp::adjacency_list<Cell, int>& get_graph() const;
 
@@ -40,6 +73,15 @@ namespace gpp {
         const std::vector<size_t>& get_shortest_path() const;
     };
 
+    /**
+     * @returns Every maze in the working directory's mazes folder, in order, with the binary
+     * version of each one when there is one.
+     */
+    std::vector<std::filesystem::path> maze_paths();
+
+    /**
+     * Invokes \p block with every maze in maze_paths().
+     */
     void test_mazes(const std::function<void(maze& maze)>& block);
 }
 #endif //GRAPPHS_MAZES_H
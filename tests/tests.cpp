@@ -1,8 +1,6 @@
 #include <grapphs/adjacency_list.h>
 #include <grapphs/adjacency_matrix.h>
-#include <grapphs/tests/geometry.h>
 #include <gtest/gtest.h>
-#include <chrono>
 #include <random>
 
 enum my_flags {
@@ -87,15 +85,6 @@ void populate(gpp::adjacency_matrix<my_vertex, my_edge>& graph) {
 }
 
 
-struct Position {
-
-    float x, y;
-
-    float distance(const Position& other) const {
-        return ::distance(x, y, other.x, other.y);
-    }
-};
-
 template<typename t_graph>
 void test_copy(t_graph& graph){
     populate(graph);
@@ -160,72 +149,3 @@ TEST(grapphs, adjacency_matrix_vertex_access) {
         ASSERT_TRUE(asConst == value);
     }
 }
-
-#define ASTAR_RADIUS 20
-
-inline int index_of(int x, int y) { return x + (y) * ASTAR_RADIUS; }
-
-/*
-TEST(grapphs, astar_performance) {
-    gpp::adjacency_list<Position, my_edge> graph;
-    for (int x = 0; x < ASTAR_RADIUS; ++x) {
-        for (int y = 0; y < ASTAR_RADIUS; ++y) {
-            Position pos{};
-            pos.x = x;
-            pos.y = y;
-            graph.push(pos);
-        }
-    }
-    my_edge prototype{};
-    prototype.weight = 1;
-    for (int x = 0; x < ASTAR_RADIUS; ++x) {
-        for (int y = 0; y < ASTAR_RADIUS; ++y) {
-            uint32_t index = index_of(x, y);
-            if (x != 0) {
-                graph.connect(index, index_of(x - 1, y), prototype);
-            }
-            if (y != 0) {
-                graph.connect(index, index_of(x, y - 1), prototype);
-            }
-            if (x != ASTAR_RADIUS - 1) {
-                graph.connect(index, index_of(x + 1, y), prototype);
-            }
-            if (y != ASTAR_RADIUS - 1) {
-                graph.connect(index, index_of(x, y + 1), prototype);
-            }
-        }
-    }
-
-    gpp::graph_path<size_t> path;
-#define RUN_COUNT 10000
-    double meanTime = 0;
-    const float frameTime = 1.0F / 60.0F;
-    for (int i = 0; i < RUN_COUNT; ++i) {
-        auto begin = std::chrono::high_resolution_clock::now();
-        path = gpp::astar<gpp::adjacency_list<Position, my_edge>>(
-            graph,
-            0,
-            (ASTAR_RADIUS * ASTAR_RADIUS) - 1,
-            [&](gpp::default_graph_index from, gpp::default_graph_index to) -> float {
-                Position* fromPos = graph.vertex(from);
-                Position* toPos = graph.vertex(to);
-                return fromPos->distance(*toPos);
-            },
-            [](gpp::default_graph_index from, gpp::default_graph_index to, const my_edge& e) -> float {
-                return e.weight;
-            }
-        );
-        auto end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> time = end - begin;
-
-        meanTime += time.count();
-    }
-    meanTime /= RUN_COUNT;
-    std::cout << "AStar for " << ASTAR_RADIUS << " radius took " << meanTime
-              << "s on average (limit: " << frameTime
-              << "s, "
-              << RUN_COUNT << " runs)"
-              << std::endl;
-    ASSERT_LT(meanTime, frameTime);
-
-}*/
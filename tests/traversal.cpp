@@ -144,6 +144,27 @@ TEST(grapphs, traversal_depth_order) {
     test_order<gpp::traversal_order::DEPTH>(order, 0);
 }
 
+TEST(grapphs, traversal_statistics) {
+    gpp::adjacency_list<int, bool> graph = build_traversal_graph();
+    gpp::search_statistics statistics;
+    gpp::traverse<gpp::adjacency_list<int, bool>, gpp::traversal_order::BREADTH>(
+        graph,
+        0,
+        [](size_t) {
+        },
+        [](size_t, size_t) {
+        },
+        statistics
+    );
+    EXPECT_EQ(statistics.verticesExpanded, 10);
+    EXPECT_EQ(statistics.edgesRelaxed, 9);
+    EXPECT_EQ(statistics.heapPushes, 10);
+    EXPECT_EQ(statistics.decreaseKeys, 0);
+    // Either 4 and 5 or 7, 8 and 9 are open at once, depending on the order edges leave 1
+    EXPECT_GE(statistics.peakOpenSize, 3);
+    EXPECT_LE(statistics.peakOpenSize, 5);
+}
+
 TEST(grapphs, reverse_level_order_traversal) {
     gpp::adjacency_list<int, bool> graph = build_traversal_graph();
     gpp::expected_traversal_order expected = {